@@ -108,6 +108,46 @@ enum class ColorSpace : uint8_t
 };
 
 
+/**
+ * @brief Enumeration specifying the optional behaviors of the raster engine. The options can be combined with the bitwise OR.
+ *
+ * These options are hints for the raster engine, it may ignore them if they are not supported on the running environment.
+ *
+ * @see SwCanvas::gen()
+ *
+ * @since Experimental API
+ */
+enum class EngineOption : uint8_t
+{
+    None = 0,                 ///< No engine options are enabled. This may be used to explicitly disable all optional behaviors.
+    Default = 1 << 0,         ///< Uses the default rendering mode.
+    ParallelRaster = 1 << 1,  ///< Splits the rasterization of the large drawing regions into horizontal bands and rasterizes them with the worker threads of the task scheduler. It takes effect only when the engine has been initialized with one or more threads.
+    GlyphCache = 1 << 2       ///< Caches the 8-bit coverage images of the small glyphs and composes the axis-aligned, unstroked text with them instead of rasterizing its outline at every update. The other text is rendered with the outline as usual.
+};
+
+
+/**
+ * @brief Combines the engine options.
+ *
+ * @since Experimental API
+ */
+constexpr EngineOption operator|(EngineOption a, EngineOption b)
+{
+    return EngineOption(uint8_t(a) | uint8_t(b));
+}
+
+
+/**
+ * @brief Masks the engine options, for example to test whether an option is enabled.
+ *
+ * @since Experimental API
+ */
+constexpr EngineOption operator&(EngineOption a, EngineOption b)
+{
+    return EngineOption(uint8_t(a) & uint8_t(b));
+}
+
+
 /**
  * @brief Enumeration specifying the values of the path commands accepted by ThorVG.
  */
@@ -1750,9 +1790,18 @@ public:
 
     /**
      * @brief Creates a new SwCanvas object.
+     *
+     * @param[in] op The rendering engine options. The options can be combined with the bitwise OR.
+     *
      * @return A new SwCanvas object.
+     *
+     * @note The @c EngineOption::ParallelRaster option renders the identical result to the default one, while it may occupy the worker threads during Canvas::draw().
+     * @note The @c EngineOption::GlyphCache option places the glyphs at the quarter pixel precision, so the text may slightly differ from the default rendering.
+     * @note Experimental API
+     *
+     * @see EngineOption
      */
-    static SwCanvas* gen() noexcept;
+    static SwCanvas* gen(EngineOption op = EngineOption::Default) noexcept;
 
     _TVG_DECLARE_PRIVATE(SwCanvas);
 };
@@ -2019,6 +2068,59 @@ public:
      */
     Result segment(float* begin, float* end = nullptr) noexcept;
 
+    /**
+     * @brief Enables caching of the rasterized frames.
+     *
+     * Once a frame is drawn, its rasterized pixels are retained in a run-length encoded form. When the same frame is requested again,
+     * the animation is not rebuilt and the retained pixels are drawn instead. This benefits animations played repeatedly in a loop.
+     * The least recently used frames are discarded once the retained frames exceed the @p budget.
+     *
+     * @param[in] budget The memory budget for the retained frames in bytes. @c 0 disables the caching and releases the retained frames.
+     *
+     * @retval Result::InsufficientCondition In case the animation is not loaded.
+     * @retval Result::NonSupport When it's not animatable.
+     *
+     * @note The retained frames are discarded when the transformation, the opacity or the size of the picture, or the target canvas changes.
+     *       They are also discarded when the contents are modified by slots or expressions. Tweened frames are always drawn live.
+     * @note Frames are drawn live while the picture is clipped, or when they do not fit in the @p budget.
+     * @note Currently, only the software raster engine supports this feature. The other engines always draw the frames live.
+     * @note Experimental API
+     */
+    Result cache(uint32_t budget) noexcept;
+
+    /**
+     * @brief Renders the multiple frames of the animation into the given buffers at once.
+     *
+     * This is intended for the offline exporting, such as thumbnails, videos or animated images.
+     * The frames are rendered concurrently by the independent replicas of the animation, each of which draws on its own canvas.
+     * Therefore, building a frame overlaps with rasterizing the others. The number of the replicas follows the number of the threads
+     * given by Initializer::init(). Each buffer is cleared and receives the frame of the same index, drawn with the size, the transformation
+     * and the opacity of the picture.
+     *
+     * @param[in] frames The frame numbers to render. Each of them should be less than the totalFrame().
+     * @param[out] buffers The target buffers, one per frame. Each of them must be allocated for at least @p stride x @p h pixels.
+     * @param[in] cnt The number of the @p frames and the @p buffers.
+     * @param[in] stride The stride of the buffers in pixels.
+     * @param[in] w The width of the buffers in pixels.
+     * @param[in] h The height of the buffers in pixels.
+     * @param[in] cs The color space of the buffers.
+     *
+     * @retval Result::InvalidArguments If any of the arguments is invalid.
+     * @retval Result::InsufficientCondition In case the animation is not loaded.
+     * @retval Result::NonSupport When it's not animatable, not replicable or the software raster engine is not supported.
+     * @retval Result::FailedAllocation If a canvas for the replicas couldn't be created.
+     *
+     * @note Any failure of rendering a frame is returned, and the buffers of the frames not rendered are left as they are.
+     * @note The picture is rendered alone, regardless of its parents, clippings and masks. The current frame of this animation is kept.
+     * @note The animations modified by the slots or the expressions are not replicable. Render them frame by frame instead.
+     * @note The frames are returned in the given order, whatever order they are rendered.
+     *
+     * @see SwCanvas::target()
+     *
+     * @note Experimental API
+     */
+    Result render(const float* frames, uint32_t** buffers, uint32_t cnt, uint32_t stride, uint32_t w, uint32_t h, ColorSpace cs) noexcept;
+
     /**
      * @brief Creates a new Animation object.
      *
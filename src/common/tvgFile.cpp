@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "config.h"
+#include "tvgFile.h"
+
+#if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#ifdef THORVG_FILE_IO_SUPPORT
+
+static char* _read(const char* path, uint32_t* size)
+{
+    auto f = fopen(path, "rb");
+    if (!f) return nullptr;
+
+    fseek(f, 0, SEEK_END);
+    auto len = ftell(f);
+    if (len <= 0) {
+        fclose(f);
+        return nullptr;
+    }
+
+    auto data = tvg::malloc<char*>(len + 1);
+    fseek(f, 0, SEEK_SET);
+    *size = (uint32_t) fread(data, sizeof(char), len, f);
+    fclose(f);
+
+    if (*size != (uint32_t) len) {
+        tvg::free(data);
+        return nullptr;
+    }
+    data[*size] = '\0';
+    return data;
+}
+
+#endif //THORVG_FILE_IO_SUPPORT
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+#ifdef THORVG_FILE_IO_SUPPORT
+
+#if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
+
+bool tvg::FileMap::map(const char* path, bool insitu)
+{
+    unmap();
+
+    auto file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    DWORD high;
+    auto low = GetFileSize(file, &high);
+    if (low == INVALID_FILE_SIZE || (high == 0 && low == 0)) {
+        CloseHandle(file);
+        return false;
+    }
+    size = (uint32_t)((size_t)high << (8 * sizeof(DWORD)) | low);
+
+    //the zero filled tail of the last page terminates the data unless the file fills the page up
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    if (insitu && size % info.dwPageSize == 0) {
+        CloseHandle(file);
+        data = _read(path, &size);
+        allocated = (data != nullptr);
+        return allocated;
+    }
+
+    mapping = (void*)CreateFileMapping(file, NULL, insitu ? PAGE_WRITECOPY : PAGE_READONLY, high, low, NULL);
+    CloseHandle(file);
+    if (!mapping) return false;
+
+    data = (char*) MapViewOfFile(mapping, insitu ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        unmap();
+        return false;
+    }
+    return true;
+}
+
+
+void tvg::FileMap::unmap()
+{
+    if (allocated) tvg::free(data);
+    else if (data) UnmapViewOfFile(data);
+    if (mapping) CloseHandle(mapping);
+
+    data = nullptr;
+    mapping = nullptr;
+    size = 0;
+    allocated = false;
+}
+
+#elif defined(__linux__)
+
+bool tvg::FileMap::map(const char* path, bool insitu)
+{
+    unmap();
+
+    auto fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    size = (uint32_t) info.st_size;
+
+    //the zero filled tail of the last page terminates the data unless the file fills the page up
+    if (insitu && size % sysconf(_SC_PAGESIZE) == 0) {
+        close(fd);
+        data = _read(path, &size);
+        allocated = (data != nullptr);
+        return allocated;
+    }
+
+    auto ptr = mmap(NULL, size, insitu ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        size = 0;
+        return false;
+    }
+    data = (char*) ptr;
+    mapping = ptr;
+    return true;
+}
+
+
+void tvg::FileMap::unmap()
+{
+    if (allocated) tvg::free(data);
+    else if (mapping) munmap(mapping, size);
+
+    data = nullptr;
+    mapping = nullptr;
+    size = 0;
+    allocated = false;
+}
+
+#else
+
+bool tvg::FileMap::map(const char* path, TVG_UNUSED bool insitu)
+{
+    unmap();
+    data = _read(path, &size);
+    allocated = (data != nullptr);
+    return allocated;
+}
+
+
+void tvg::FileMap::unmap()
+{
+    if (allocated) tvg::free(data);
+    data = nullptr;
+    size = 0;
+    allocated = false;
+}
+
+#endif
+
+#else
+
+bool tvg::FileMap::map(TVG_UNUSED const char* path, TVG_UNUSED bool insitu)
+{
+    return false;
+}
+
+
+void tvg::FileMap::unmap()
+{
+}
+
+#endif //THORVG_FILE_IO_SUPPORT
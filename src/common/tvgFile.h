@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_FILE_H_
+#define _TVG_FILE_H_
+
+#include "tvgCommon.h"
+
+namespace tvg
+{
+
+//The file content without the intermediate copy: mapped into the memory where the platform allows it, read otherwise.
+struct FileMap
+{
+    char* data = nullptr;
+    uint32_t size = 0;
+
+    ~FileMap()
+    {
+        unmap();
+    }
+
+    //insitu: the parsers could write into the data. The written pages are privately copied on demand,
+    //and the data is terminated by '\0' at size.
+    bool map(const char* path, bool insitu = false);
+    void unmap();
+
+private:
+    void* mapping = nullptr;    //the platform mapping handle
+    bool allocated = false;     //the data is read into the heap
+};
+
+}
+
+#endif //_TVG_FILE_H_
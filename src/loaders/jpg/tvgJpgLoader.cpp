@@ -38,11 +38,13 @@ void JpgLoader::clear()
 
 void JpgLoader::run(unsigned tid)
 {
-    surface.buf8 = jpgdDecompress(decoder);
+    //decode in the channel order of the target colorspace, jpg is opaque so it's premultiplied as well
+    auto rgba = (surface.cs == ColorSpace::ABGR8888 || surface.cs == ColorSpace::ABGR8888S);
+    surface.buf8 = jpgdDecompress(decoder, rgba);
     surface.stride = static_cast<uint32_t>(w);
     surface.w = static_cast<uint32_t>(w);
     surface.h = static_cast<uint32_t>(h);
-    surface.cs = ColorSpace::ARGB8888;
+    surface.cs = rgba ? ColorSpace::ABGR8888 : ColorSpace::ARGB8888;
     surface.channelSize = sizeof(uint32_t);
     surface.premultiplied = true;
 
@@ -115,6 +117,8 @@ bool JpgLoader::read()
 
     if (!decoder || w == 0 || h == 0) return false;
 
+    surface.cs = ImageLoader::cs;
+
     TaskScheduler::request(this);
 
     return true;
@@ -2957,7 +2957,7 @@ void jpgdDelete(jpeg_decoder* decoder)
 }
 
 
-unsigned char* jpgdDecompress(jpeg_decoder* decoder)
+unsigned char* jpgdDecompress(jpeg_decoder* decoder, bool rgba)
 {
     if (!decoder) return nullptr;
 
@@ -2984,12 +2984,14 @@ unsigned char* jpgdDecompress(jpeg_decoder* decoder)
 
         uint8_t *pDst = pImage_data + y * dst_bpl;
 
-        //Return as BGRA
+        //Return as BGRA or RGBA, in the order of the target colorspace
         if ((req_comps == 4) && (decoder->get_num_components() == 3)) {
+            auto r = rgba ? 0 : 2;
+            auto b = rgba ? 2 : 0;
             for (int x = 0; x < image_width; x++) {
-                pDst[0] = pScan_line[x*4+2];
+                pDst[r] = pScan_line[x*4+0];
                 pDst[1] = pScan_line[x*4+1];
-                pDst[2] = pScan_line[x*4+0];
+                pDst[b] = pScan_line[x*4+2];
                 pDst[3] = 255;
                 pDst += 4;
             }
@@ -164,6 +164,58 @@ jerry_eval (const jerry_char_t *source_p, /**< source code */
   return jerry_return (ecma_op_eval_chars_buffer ((void *) &source_char, flags));
 } /* jerry_eval */
 
+/**
+ * Compile the source code once, the result can be run repeatedly with jerry_eval_run.
+ *
+ * Note:
+ *      returned handle must be freed with jerry_eval_release, when it is no longer needed.
+ *
+ * @return compiled code handle - if success
+ *         NULL - if the source code has a syntax error
+ */
+void *
+jerry_eval_compile (const jerry_char_t *source_p, /**< source code */
+                    size_t source_size, /**< length of source code */
+                    uint32_t flags) /**< jerry_parse_opts_t flags */
+{
+  parser_source_char_t source_char;
+  source_char.source_p = source_p;
+  source_char.source_size = source_size;
+
+  ecma_compiled_code_t *bytecode_p = ecma_op_eval_compile ((void *) &source_char, flags);
+
+  if (bytecode_p == NULL)
+  {
+    jcontext_release_exception ();
+  }
+
+  return bytecode_p;
+} /* jerry_eval_compile */
+
+/**
+ * Run the code compiled by jerry_eval_compile, same as jerry_eval without the parsing.
+ *
+ * @return result of the evaluated code
+ */
+jerry_value_t
+jerry_eval_run (void *compiled_p, /**< compiled code handle */
+                uint32_t flags) /**< jerry_parse_opts_t flags */
+{
+  return jerry_return (ecma_op_eval_run ((ecma_compiled_code_t *) compiled_p, flags));
+} /* jerry_eval_run */
+
+/**
+ * Release the code compiled by jerry_eval_compile.
+ */
+void
+jerry_eval_release (void *compiled_p) /**< compiled code handle */
+{
+  if (compiled_p != NULL)
+  {
+    ecma_bytecode_deref ((ecma_compiled_code_t *) compiled_p);
+  }
+} /* jerry_eval_release */
+
 /**
  * Get global object
  *
@@ -94,6 +94,60 @@ ecma_op_eval_chars_buffer (void *source_p, /**< source code */
 #endif /* JERRY_PARSER */
 } /* ecma_op_eval_chars_buffer */
 
+/**
+ * Compile the code stored in continuous character buffer as an eval code,
+ * so that it can be run repeatedly by ecma_op_eval_run
+ *
+ * @return compiled byte code - if success
+ *         NULL - otherwise (the error is set in the context)
+ */
+ecma_compiled_code_t *
+ecma_op_eval_compile (void *source_p, /**< source code */
+                      uint32_t parse_opts) /**< ecma_parse_opts_t option bits */
+{
+#if JERRY_PARSER
+  JERRY_ASSERT (source_p != NULL);
+
+  parse_opts &= (uint32_t) ~(ECMA_PARSE_STRICT_MODE | ECMA_PARSE_DIRECT_EVAL);
+  parse_opts |= ECMA_PARSE_EVAL;
+
+  ECMA_CLEAR_LOCAL_PARSE_OPTS ();
+
+  return parser_parse_script (source_p, parse_opts, NULL);
+#else /* !JERRY_PARSER */
+  JERRY_UNUSED (source_p);
+  JERRY_UNUSED (parse_opts);
+
+  ecma_raise_syntax_error (ECMA_ERR_EMPTY);
+  return NULL;
+#endif /* JERRY_PARSER */
+} /* ecma_op_eval_compile */
+
+/**
+ * Run the byte code compiled by ecma_op_eval_compile in the global scope
+ *
+ * Note:
+ *      the byte code is kept alive, the caller still owns its reference
+ *
+ * @return ecma value
+ */
+ecma_value_t
+ecma_op_eval_run (ecma_compiled_code_t *bytecode_p, /**< compiled byte code */
+                  uint32_t parse_opts) /**< ecma_parse_opts_t option bits */
+{
+  JERRY_ASSERT (bytecode_p != NULL);
+
+  parse_opts &= (uint32_t) ~(ECMA_PARSE_STRICT_MODE | ECMA_PARSE_DIRECT_EVAL);
+  parse_opts |= ECMA_PARSE_EVAL;
+
+  ECMA_CLEAR_LOCAL_PARSE_OPTS ();
+
+  /* vm_run_eval releases one reference of the byte code */
+  ecma_bytecode_ref (bytecode_p);
+
+  return vm_run_eval (bytecode_p, parse_opts);
+} /* ecma_op_eval_run */
+
 /**
  * @}
  * @}
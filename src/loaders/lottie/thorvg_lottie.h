@@ -110,6 +110,22 @@ public:
      */
     Result assign(const char* layer, uint32_t ix, const char* var, float val);
 
+    /**
+     * @brief Gets the number of the objects which are constant and which change over the time.
+     *
+     * The constant objects, such as the layers and the shapes without any keyframes, expressions or slot bindings,
+     * are not rebuilt per frame. The counts help to figure out how much of the animation is actually animated.
+     *
+     * @param[out] invariant The number of the objects constant over the time.
+     * @param[out] animated The number of the objects changing over the time.
+     *
+     * @retval Result::InsufficientCondition If the animation is not loaded.
+     * @retval Result::InvalidArguments When both of the parameters are @c nullptr.
+     *
+     * @note Experimental API
+     */
+    Result stats(uint32_t* invariant, uint32_t* animated) noexcept;
+
     /**
      * @brief Creates a new LottieAnimation object.
      *
@@ -35,6 +35,8 @@ Result LottieAnimation::override(const char* slot) noexcept
     auto loader = PICTURE(pImpl->picture)->loader;
     if (!loader) return Result::InsufficientCondition;
 
+    PICTURE(pImpl->picture)->uncache(true);
+
     if (static_cast<LottieLoader*>(loader)->override(slot)) {
         PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
         return Result::Success;
@@ -63,6 +65,10 @@ Result LottieAnimation::tween(float from, float to, float progress) noexcept
 {
     auto loader = PICTURE(pImpl->picture)->loader;
     if (!loader) return Result::InsufficientCondition;
+
+    //the tweened frames are not cacheable
+    PICTURE(pImpl->picture)->uncache(false);
+
     if (!static_cast<LottieLoader*>(loader)->tween(from, to, progress)) return Result::InsufficientCondition;
     PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
     return Result::Success;
@@ -91,6 +97,9 @@ Result LottieAnimation::assign(const char* layer, uint32_t ix, const char* var,
 
     auto loader = PICTURE(pImpl->picture)->loader;
     if (!loader) return Result::InsufficientCondition;
+
+    PICTURE(pImpl->picture)->uncache(true);
+
     if (static_cast<LottieLoader*>(loader)->assign(layer, ix, var, val)) {
         PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
         return Result::Success;
@@ -100,6 +109,18 @@ Result LottieAnimation::assign(const char* layer, uint32_t ix, const char* var,
 }
 
 
+Result LottieAnimation::stats(uint32_t* invariant, uint32_t* animated) noexcept
+{
+    if (!invariant && !animated) return Result::InvalidArguments;
+
+    auto loader = PICTURE(pImpl->picture)->loader;
+    if (!loader) return Result::InsufficientCondition;
+
+    if (static_cast<LottieLoader*>(loader)->stats(invariant, animated)) return Result::Success;
+    return Result::InsufficientCondition;
+}
+
+
 LottieAnimation* LottieAnimation::gen() noexcept
 {
     return new LottieAnimation;
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_LOTTIE_BINARY_H_
+#define _TVG_LOTTIE_BINARY_H_
+
+#include <cstdint>
+#include <cstring>
+
+/* Precompiled Lottie (.lotb)
+
+   The json document is tokenized in advance (see tools/lottie2bin), so that the parser
+   replays the tokens straight from the mapped file without scanning the text or converting
+   the numbers. The strings are deduplicated into a null-terminated pool and referenced
+   in place, no copies are made during the loading.
+
+   [Header][tokens][string pool]
+
+   A token is a tag byte and its payload. Integers and string references (offset, length)
+   are encoded in LEB128, floating points are stored in IEEE 754. All the fixed size values,
+   including the header fields, are little-endian regardless of the host. */
+
+#define LOTTIE_BINARY_MAGIC "TVGLOT"
+#define LOTTIE_BINARY_MAGIC_LEN 6
+#define LOTTIE_BINARY_VERSION 1
+
+struct LottieBinary
+{
+    enum Token : uint8_t {Null = 0, False, True, Int, Uint, Int64, Uint64, Float, Double, String, Key, StartObject, EndObject, StartArray, EndArray};
+
+    //magic(6), version(2), w, h, frameRate, startFrame, endFrame (4 each), tokens(4), pool(4)
+    static constexpr uint32_t HEADER_SIZE = 36;
+
+    struct Header
+    {
+        uint16_t version;
+        //animation info, that is available without parsing
+        float w, h;
+        float frameRate;
+        float startFrame, endFrame;
+        uint32_t tokens;        //token stream size in bytes
+        uint32_t pool;          //string pool size in bytes
+    };
+
+    static bool magic(const char* data, uint32_t size)
+    {
+        return data && size >= HEADER_SIZE && !memcmp(data, LOTTIE_BINARY_MAGIC, LOTTIE_BINARY_MAGIC_LEN);
+    }
+
+    //the header of a verified binary
+    static Header header(const char* data)
+    {
+        auto p = reinterpret_cast<const uint8_t*>(data) + LOTTIE_BINARY_MAGIC_LEN;
+        Header header;
+        header.version = uint16_t(p[0] | (p[1] << 8));
+        header.w = f32(p + 2);
+        header.h = f32(p + 6);
+        header.frameRate = f32(p + 10);
+        header.startFrame = f32(p + 14);
+        header.endFrame = f32(p + 18);
+        header.tokens = u32(p + 22);
+        header.pool = u32(p + 26);
+        return header;
+    }
+
+    //returns false if the given data is not a valid binary
+    static bool header(const char* data, uint32_t size, Header& header)
+    {
+        if (!magic(data, size)) return false;
+        header = LottieBinary::header(data);
+        if (header.version != LOTTIE_BINARY_VERSION) return false;
+        if (uint64_t(HEADER_SIZE) + header.tokens + header.pool != size) return false;
+        if (header.pool == 0 || data[size - 1] != '\0') return false;
+        return true;
+    }
+
+    static void write(uint8_t* p, const Header& header)
+    {
+        memcpy(p, LOTTIE_BINARY_MAGIC, LOTTIE_BINARY_MAGIC_LEN);
+        p += LOTTIE_BINARY_MAGIC_LEN;
+        p[0] = uint8_t(header.version);
+        p[1] = uint8_t(header.version >> 8);
+        write(p + 2, header.w);
+        write(p + 6, header.h);
+        write(p + 10, header.frameRate);
+        write(p + 14, header.startFrame);
+        write(p + 18, header.endFrame);
+        write(p + 22, header.tokens);
+        write(p + 26, header.pool);
+    }
+
+    static const uint8_t* tokens(const char* data)
+    {
+        return reinterpret_cast<const uint8_t*>(data + HEADER_SIZE);
+    }
+
+    static const char* pool(const char* data, const Header& header)
+    {
+        return data + HEADER_SIZE + header.tokens;
+    }
+
+    //little-endian fixed size values
+    static uint32_t u32(const uint8_t* p)
+    {
+        return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    }
+
+    static uint64_t u64(const uint8_t* p)
+    {
+        return uint64_t(u32(p)) | (uint64_t(u32(p + 4)) << 32);
+    }
+
+    static float f32(const uint8_t* p)
+    {
+        auto v = u32(p);
+        float f;
+        memcpy(&f, &v, sizeof(f));
+        return f;
+    }
+
+    static double f64(const uint8_t* p)
+    {
+        auto v = u64(p);
+        double d;
+        memcpy(&d, &v, sizeof(d));
+        return d;
+    }
+
+    static void write(uint8_t* p, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i) p[i] = uint8_t(value >> (i * 8));
+    }
+
+    static void write(uint8_t* p, float value)
+    {
+        uint32_t v;
+        memcpy(&v, &value, sizeof(v));
+        write(p, v);
+    }
+
+    static void write(uint8_t* p, double value)
+    {
+        uint64_t v;
+        memcpy(&v, &value, sizeof(v));
+        write(p, uint32_t(v));
+        write(p + 4, uint32_t(v >> 32));
+    }
+
+    //returns false if the encoded value exceeds the end
+    static bool read(const uint8_t*& p, const uint8_t* end, uint64_t& value)
+    {
+        value = 0;
+        for (uint32_t shift = 0; p < end && shift < 64; shift += 7) {
+            auto byte = *p++;
+            value |= uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    //returns the number of the written bytes (10 at most)
+    static uint32_t varint(uint8_t* p, uint64_t value)
+    {
+        uint32_t cnt = 0;
+        do {
+            auto byte = uint8_t(value & 0x7f);
+            value >>= 7;
+            if (value) byte |= 0x80;
+            p[cnt++] = byte;
+        } while (value);
+        return cnt;
+    }
+
+    static uint64_t zigzag(int64_t value)
+    {
+        return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+    }
+
+    static int64_t unzigzag(uint64_t value)
+    {
+        return int64_t(value >> 1) ^ -int64_t(value & 1);
+    }
+};
+
+#endif //_TVG_LOTTIE_BINARY_H_
@@ -24,6 +24,7 @@
 #include "tvgCommon.h"
 #include "tvgMath.h"
 #include "tvgScene.h"
+#include "tvgTaskScheduler.h"
 #include "tvgLottieModel.h"
 #include "tvgLottieBuilder.h"
 #include "tvgLottieExpressions.h"
@@ -34,7 +35,88 @@
 /************************************************************************/
 
 static bool _buildComposition(LottieComposition* comp, LottieLayer* parent);
-static bool _draw(LottieGroup* parent, LottieShape* shape, RenderContext* ctx);
+
+
+//reuse the scene built in the previous frame to keep its children's render data alive.
+static Scene* _retain(Scene*& retained, bool recycle = true)
+{
+    if (!retained) {
+        retained = Scene::gen();
+        retained->ref();
+    //occupied by another precomp layer referring to the same asset
+    } else if (PAINT(retained)->parent) {
+        return Scene::gen();
+    }
+
+    if (recycle) SCENE(retained)->recycle();
+    retained->clip(nullptr);
+    retained->mask(nullptr, MaskMethod::None);
+    retained->push(SceneEffect::ClearAll);
+
+    return retained;
+}
+
+
+static void _transform(Paint* paint, const Matrix& m)
+{
+    if (PAINT(paint)->transform() == m) return;
+    paint->transform(m);
+}
+
+
+static bool _equal(const RenderPath& lhs, const RenderPath& rhs)
+{
+    if (lhs.cmds.count != rhs.cmds.count || lhs.pts.count != rhs.pts.count) return false;
+    //the empty arrays could have no buffers, memcmp() doesn't take the null pointers
+    if (lhs.cmds.count > 0 && memcmp(lhs.cmds.data, rhs.cmds.data, sizeof(PathCommand) * lhs.cmds.count)) return false;
+    return lhs.pts.count == 0 || !memcmp(lhs.pts.data, rhs.pts.data, sizeof(Point) * lhs.pts.count);
+}
+
+
+static bool _equal(const RenderStroke* lhs, const RenderStroke* rhs)
+{
+    if (!lhs || !rhs) return lhs == rhs;
+    if (lhs->fill || rhs->fill) return false;   //gradients are regenerated every frame
+    if (lhs->width != rhs->width || memcmp(&lhs->color, &rhs->color, sizeof(RenderColor))) return false;
+    if (lhs->miterlimit != rhs->miterlimit || lhs->cap != rhs->cap || lhs->join != rhs->join || lhs->first != rhs->first) return false;
+    if (lhs->trim.begin != rhs->trim.begin || lhs->trim.end != rhs->trim.end || lhs->trim.simultaneous != rhs->trim.simultaneous) return false;
+    if (lhs->dash.count != rhs->dash.count || lhs->dash.offset != rhs->dash.offset || lhs->dash.length != rhs->dash.length) return false;
+    return lhs->dash.count == 0 || !memcmp(lhs->dash.pattern, rhs->dash.pattern, sizeof(float) * lhs->dash.count);
+}
+
+
+//apply the drafted shape to the retained one, marking only the actual changes.
+static void _commit(Shape* draft, Shape* target)
+{
+    auto src = SHAPE(draft);
+    auto dst = SHAPE(target);
+
+    if (!_equal(src->rs.path, dst->rs.path) || src->rs.rule != dst->rs.rule) {
+        dst->rs.path.cmds = src->rs.path.cmds;
+        dst->rs.path.pts = src->rs.path.pts;
+        dst->rs.rule = src->rs.rule;
+        dst->impl.mark(RenderUpdateFlag::Path);
+    }
+
+    if (src->rs.fill || dst->rs.fill) {
+        std::swap(src->rs.fill, dst->rs.fill);
+        dst->rs.color = src->rs.color;
+        dst->impl.mark(RenderUpdateFlag::Gradient | RenderUpdateFlag::Color);
+    } else if (memcmp(&src->rs.color, &dst->rs.color, sizeof(RenderColor))) {
+        dst->rs.color = src->rs.color;
+        dst->impl.mark(RenderUpdateFlag::Color);
+    }
+
+    if (!_equal(src->rs.stroke, dst->rs.stroke)) {
+        auto gradient = (src->rs.stroke && src->rs.stroke->fill) || (dst->rs.stroke && dst->rs.stroke->fill);
+        std::swap(src->rs.stroke, dst->rs.stroke);
+        dst->impl.mark(RenderUpdateFlag::Stroke);
+        if (gradient) dst->impl.mark(RenderUpdateFlag::GradientStroke);
+    }
+
+    _transform(target, src->impl.transform());
+    target->opacity(draft->opacity());
+}
 
 
 static void _rotate(LottieTransform* transform, float frameNo, Matrix& m, float angle, Tween& tween, LottieExpressions* exps)
@@ -140,20 +222,20 @@ static bool _updateTransform(LottieTransform* transform, float frameNo, Matrix&
 
 void LottieBuilder::updateTransform(LottieLayer* layer, float frameNo)
 {
-    if (!layer || (!tweening() && tvg::equal(layer->cache.frameNo, frameNo))) return;
+    if (!layer || (!tweening() && tvg::equal(state(layer).cache.frameNo, frameNo))) return;
 
     auto transform = layer->transform;
     auto parent = layer->parent;
 
     if (parent) updateTransform(parent, frameNo);
 
-    auto& matrix = layer->cache.matrix;
+    auto& matrix = state(layer).cache.matrix;
 
-    _updateTransform(transform, frameNo, matrix, layer->cache.opacity, layer->autoOrient, tween, exps);
+    _updateTransform(transform, frameNo, matrix, state(layer).cache.opacity, layer->autoOrient, tween, exps);
 
-    if (parent) layer->cache.matrix = parent->cache.matrix * matrix;
+    if (parent) state(layer).cache.matrix = state(parent).cache.matrix * matrix;
 
-    layer->cache.frameNo = frameNo;
+    state(layer).cache.frameNo = frameNo;
 }
 
 
@@ -199,23 +281,23 @@ void LottieBuilder::updateGroup(LottieGroup* parent, LottieObject** child, float
 
     //Prepare render data
     if (group->blendMethod == parent->blendMethod) {
-        group->scene = parent->scene;
+        state(group).scene = state(parent).scene;
     } else {
-        group->scene = tvg::Scene::gen();
-        group->scene->blend(group->blendMethod);
-        parent->scene->push(group->scene);
+        state(group).scene = _retain(state(group).retained);
+        state(group).scene->blend(group->blendMethod);
+        state(parent).scene->push(state(group).scene);
     }
 
-    group->reqFragment |= ctx->reqFragment;
-
     //generate a merging shape to consolidate partial shapes into a single entity
-    if (group->mergeable()) _draw(group, nullptr, ctx);
+    if (group->mergeable()) draw(group, group, ctx);
 
     Inlist<RenderContext> contexts;
-    auto propagator = group->mergeable() ? ctx->propagator : static_cast<Shape*>(PAINT(ctx->propagator)->duplicate(group->pooling()));
+    auto propagator = group->mergeable() ? ctx->propagator : static_cast<Shape*>(PAINT(ctx->propagator)->duplicate(state(group).shapes.pooling()));
     contexts.back(new RenderContext(*ctx, propagator, group->mergeable()));
 
     updateChildren(group, frameNo, contexts);
+
+    if (state(group).scene != state(parent).scene) SCENE(state(group).scene)->commit();
 }
 
 
@@ -241,7 +323,7 @@ bool LottieBuilder::fragmented(LottieGroup* parent, LottieObject** child, Inlist
     if (ctx->fragment) return true;
     if (!ctx->reqFragment) return false;
 
-    contexts.back(new RenderContext(*ctx, (Shape*)(PAINT(ctx->propagator)->duplicate(parent->pooling()))));
+    contexts.back(new RenderContext(*ctx, (Shape*)(PAINT(ctx->propagator)->duplicate(state(parent).shapes.pooling()))));
 
     contexts.tail->begin = child - 1;
     ctx->fragment = fragment;
@@ -326,24 +408,36 @@ bool LottieBuilder::updateGradientFill(LottieGroup* parent, LottieObject** child
 }
 
 
-static bool _draw(LottieGroup* parent, LottieShape* shape, RenderContext* ctx)
+void LottieBuilder::draw(LottieGroup* parent, LottieObject* obj, RenderContext* ctx)
 {
-    if (ctx->merging) return false;
+    if (ctx->merging) return;
 
-    if (shape) {
-        ctx->merging = shape->pooling();
-        PAINT(ctx->propagator)->duplicate(ctx->merging);
-    } else {
-        ctx->merging = static_cast<Shape*>(ctx->propagator->duplicate());
+    //draft the shape of this frame, the retained one takes only the changes later. see commit()
+    if (drafts.count == drafted) {
+        auto shape = Shape::gen();
+        shape->ref();
+        drafts.push({shape, nullptr});
     }
+    auto& draft = drafts[drafted++];
+    draft.target = state(obj).shapes.pooling();
 
-    parent->scene->push(ctx->merging);
+    ctx->merging = draft.shape;
+    PAINT(ctx->propagator)->duplicate(ctx->merging);
 
-    return true;
+    state(parent).scene->push(draft.target);
+}
+
+
+void LottieBuilder::commit(uint32_t begin)
+{
+    for (auto i = begin; i < drafted; ++i) {
+        _commit(drafts[i].shape, drafts[i].target);
+    }
+    drafted = begin;
 }
 
 
-static void _repeat(LottieGroup* parent, Shape* path, RenderContext* ctx)
+static void _repeat(Scene* scene, Shape* path, RenderContext* ctx)
 {
     Array<Shape*> propagators;
     propagators.push(ctx->propagator);
@@ -379,12 +473,12 @@ static void _repeat(LottieGroup* parent, Shape* path, RenderContext* ctx)
         //push repeat shapes in order.
         if (repeater->inorder) {
             ARRAY_FOREACH(p, shapes) {
-                parent->scene->push(*p);
+                scene->push(*p);
                 propagators.push(*p);
             }
         } else if (!shapes.empty()) {
             ARRAY_REVERSE_FOREACH(shape, shapes) {
-                parent->scene->push(*shape);
+                scene->push(*shape);
                 propagators.push(*shape);
             }
         }
@@ -427,13 +521,13 @@ void LottieBuilder::updateRect(LottieGroup* parent, LottieObject** child, float
     }
 
     if (ctx->repeaters.empty()) {
-        _draw(parent, rect, ctx);
+        draw(parent, rect, ctx);
         appendRect(ctx->merging, pos, size, r, rect->clockwise, ctx);
     } else {
-        auto shape = rect->pooling();
+        auto shape = state(rect).shapes.pooling();
         shape->reset();
         appendRect(shape, pos, size, r, rect->clockwise, ctx);
-        _repeat(parent, shape, ctx);
+        _repeat(state(parent).scene, shape, ctx);
     }
 }
 
@@ -461,13 +555,13 @@ void LottieBuilder::updateEllipse(LottieGroup* parent, LottieObject** child, flo
     auto size = ellipse->size(frameNo, tween, exps) * 0.5f;
 
     if (ctx->repeaters.empty()) {
-        _draw(parent, ellipse, ctx);
+        draw(parent, ellipse, ctx);
         _appendCircle(ctx->merging, pos, size, ellipse->clockwise, ctx);
     } else {
-        auto shape = ellipse->pooling();
+        auto shape = state(ellipse).shapes.pooling();
         shape->reset();
         _appendCircle(shape, pos, size, ellipse->clockwise, ctx);
-        _repeat(parent, shape, ctx);
+        _repeat(state(parent).scene, shape, ctx);
     }
 }
 
@@ -477,15 +571,15 @@ void LottieBuilder::updatePath(LottieGroup* parent, LottieObject** child, float
     auto path = static_cast<LottiePath*>(*child);
 
     if (ctx->repeaters.empty()) {
-        _draw(parent, path, ctx);
+        draw(parent, path, ctx);
         if (path->pathset(frameNo, SHAPE(ctx->merging)->rs.path, ctx->transform, tween, exps, ctx->modifier)) {
             PAINT(ctx->merging)->mark(RenderUpdateFlag::Path);
         }
     } else {
-        auto shape = path->pooling();
+        auto shape = state(path).shapes.pooling();
         shape->reset();
         path->pathset(frameNo, SHAPE(shape)->rs.path, ctx->transform, tween, exps, ctx->modifier);
-        _repeat(parent, shape, ctx);
+        _repeat(state(parent).scene, shape, ctx);
     }
 }
 
@@ -520,7 +614,7 @@ void LottieBuilder::updateStar(LottiePolyStar* star, float frameNo, Matrix* tran
 
     Shape* shape;
     if (roundedCorner || ctx->offset) {
-        shape = star->pooling();
+        shape = state(star).shapes.pooling();
         shape->reset();
     } else {
         shape = merging;
@@ -632,7 +726,7 @@ void LottieBuilder::updatePolygon(LottieGroup* parent, LottiePolyStar* star, flo
 
     Shape* shape;
     if (roundedCorner || ctx->offset) {
-        shape = star->pooling();
+        shape = state(star).shapes.pooling();
         shape->reset();
     } else {
         shape = merging;
@@ -696,16 +790,16 @@ void LottieBuilder::updatePolystar(LottieGroup* parent, LottieObject** child, fl
     auto identity = tvg::identity((const Matrix*)&matrix);
 
     if (ctx->repeaters.empty()) {
-        _draw(parent, star, ctx);
+        draw(parent, star, ctx);
         if (star->type == LottiePolyStar::Star) updateStar(star, frameNo, (identity ? nullptr : &matrix), ctx->merging, ctx, tween, exps);
         else updatePolygon(parent, star, frameNo, (identity  ? nullptr : &matrix), ctx->merging, ctx, tween, exps);
         PAINT(ctx->merging)->mark(RenderUpdateFlag::Path);
     } else {
-        auto shape = star->pooling();
+        auto shape = state(star).shapes.pooling();
         shape->reset();
         if (star->type == LottiePolyStar::Star) updateStar(star, frameNo, (identity ? nullptr : &matrix), shape, ctx, tween, exps);
         else updatePolygon(parent, star, frameNo, (identity  ? nullptr : &matrix), shape, ctx, tween, exps);
-        _repeat(parent, shape, ctx);
+        _repeat(state(parent).scene, shape, ctx);
     }
 }
 
@@ -859,13 +953,13 @@ void LottieBuilder::updatePrecomp(LottieComposition* comp, LottieLayer* precomp,
 
     ARRAY_REVERSE_FOREACH(c, precomp->children) {
         auto child = static_cast<LottieLayer*>(*c);
-        if (!child->matteSrc) updateLayer(comp, precomp->scene, child, frameNo);
+        if (!child->matteSrc) updateLayer(comp, state(precomp).scene, child, frameNo);
     }
 
     //clip the layer viewport
-    auto clipper = precomp->statical.pooling(true);
-    clipper->transform(precomp->cache.matrix);
-    precomp->scene->clip(clipper);
+    auto clipper = state(precomp).statical.pooling(precomp->statical);
+    _transform(clipper, state(precomp).cache.matrix);
+    state(precomp).scene->clip(clipper);
 }
 
 
@@ -883,16 +977,18 @@ void LottieBuilder::updatePrecomp(LottieComposition* comp, LottieLayer* precomp,
 
 void LottieBuilder::updateSolid(LottieLayer* layer)
 {
-    auto solidFill = layer->statical.pooling(true);
-    solidFill->opacity(layer->cache.opacity);
-    layer->scene->push(solidFill);
+    auto solidFill = state(layer).statical.pooling(layer->statical);
+    solidFill->opacity(state(layer).cache.opacity);
+    state(layer).scene->push(solidFill);
 }
 
 
 void LottieBuilder::updateImage(LottieGroup* layer)
 {
     auto image = static_cast<LottieImage*>(layer->children.first());
-    layer->scene->push(image->pooling(true));
+    //the picture of the shared composition might be copied by the other instances at the same time
+    ScopedLock lock(image->key);
+    state(layer).scene->push(state(layer).images.pooling(image->picture));
 }
 
 
@@ -942,7 +1038,7 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
     if (!p || !text->font) return;
 
     if (text->font->origin != LottieFont::Origin::Local || text->font->chars.empty()) {
-        _fontText(doc, layer->scene);
+        _fontText(doc, state(layer).scene);
         return;
     }
 
@@ -981,7 +1077,7 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
             scene->translate(layout.x, layout.y);
             scene->scale(scale);
 
-            layer->scene->push(scene);
+            state(layer).scene->push(scene);
             scene = nullptr;
 
             if (*p == '\0') break;
@@ -1034,7 +1130,7 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
                 }
 
                 auto& textGroupMatrix = textGroup->transform();
-                auto shape = text->pooling();
+                auto shape = state(text).shapes.pooling();
                 shape->reset();
                 ARRAY_FOREACH(p, glyph->children) {
                     auto group = static_cast<LottieGroup*>(*p);
@@ -1181,11 +1277,18 @@ void LottieBuilder::updateMasks(LottieLayer* layer, float frameNo)
 {
     if (layer->masks.count == 0) return;
 
+    auto& rs = state(layer);
+
+    //the base opacity of the scene which may take the mask opacity. the retained one keeps the previous result
+    auto base = (layer->type == LottieLayer::Null) ? 255 : rs.cache.opacity;
+
     //Introduce an intermediate scene for embracing matte + masking or precomp clipping + masking replaced by clipping
     if (layer->matteTarget || layer->type == LottieLayer::Precomp) {
-        auto scene = Scene::gen();
-        scene->push(layer->scene);
-        layer->scene = scene;
+        auto scene = _retain(rs.wrapper);
+        scene->push(rs.scene);
+        SCENE(scene)->commit();
+        rs.scene = scene;
+        base = 255;
     }
 
     Shape* pShape = nullptr;
@@ -1202,26 +1305,26 @@ void LottieBuilder::updateMasks(LottieLayer* layer, float frameNo)
 
         //the first mask
         if (!pShape) {
-            pShape = layer->pooling();
+            pShape = rs.shapes.pooling();
             SHAPE(pShape)->reset();
             auto compMethod = (method == MaskMethod::Subtract || method == MaskMethod::InvAlpha) ? MaskMethod::InvAlpha : MaskMethod::Alpha;
             //Cheaper. Replace the masking with a clipper
             if (layer->masks.count == 1 && compMethod == MaskMethod::Alpha) {
-                layer->scene->opacity(MULTIPLY(layer->scene->opacity(), opacity));
-                layer->scene->clip(pShape);
+                rs.scene->opacity(MULTIPLY(base, opacity));
+                rs.scene->clip(pShape);
             } else {
-                layer->scene->mask(pShape, compMethod);
+                rs.scene->mask(pShape, compMethod);
             }
         //Chain mask composition
         } else if (pMethod != method || pOpacity != opacity || (method != MaskMethod::Subtract && method != MaskMethod::Difference)) {
-            auto shape = layer->pooling();
+            auto shape = rs.shapes.pooling();
             SHAPE(shape)->reset();
             pShape->mask(shape, method);
             pShape = shape;
         }
 
         pShape->fill(255, 255, 255, opacity);
-        pShape->transform(layer->cache.matrix);
+        pShape->transform(rs.cache.matrix);
 
         //Default Masking
         if (expand == 0.0f) {
@@ -1243,14 +1346,17 @@ bool LottieBuilder::updateMatte(LottieComposition* comp, float frameNo, Scene* s
     auto target = layer->matteTarget;
     if (!target || target->type == LottieLayer::Null) return true;
 
+    auto& rs = state(layer);
+
     updateLayer(comp, scene, target, frameNo);
 
-    if (target->scene) {
-        layer->scene->mask(target->scene, layer->matteType);
+    if (state(target).scene) {
+        rs.scene->mask(state(target).scene, layer->matteType);
     } else if (layer->matteType == MaskMethod::Alpha || layer->matteType == MaskMethod::Luma) {
         //matte target is not exist. alpha blending definitely bring an invisible result
-        delete(layer->scene);
-        layer->scene = nullptr;
+        if (rs.scene == rs.retained) SCENE(rs.scene)->commit();
+        else delete(rs.scene);
+        rs.scene = nullptr;
         return false;
     }
     return true;
@@ -1261,7 +1367,9 @@ void LottieBuilder::updateStrokeEffect(LottieLayer* layer, LottieFxStroke* effec
 {
     if (layer->masks.count == 0) return;
 
-    auto shape = layer->pooling();
+    auto& rs = state(layer);
+
+    auto shape = rs.shapes.pooling();
     shape->reset();
 
     //FIXME: all mask
@@ -1276,7 +1384,7 @@ void LottieBuilder::updateStrokeEffect(LottieLayer* layer, LottieFxStroke* effec
         layer->masks[idx]->pathset(frameNo, SHAPE(shape)->rs.path, nullptr, tween, exps);
     }
 
-    shape->transform(layer->cache.matrix);
+    shape->transform(rs.cache.matrix);
     shape->trimpath(effect->begin(frameNo) * 0.01f, effect->end(frameNo) * 0.01f);
     shape->strokeFill(255, 255, 255, (int)(effect->opacity(frameNo) * 255.0f));
     shape->strokeJoin(StrokeJoin::Round);
@@ -1302,11 +1410,11 @@ void LottieBuilder::updateStrokeEffect(LottieLayer* layer, LottieFxStroke* effec
             }
             return true;
         };
-        accessor->set(layer->scene, f, nullptr);
+        accessor->set(rs.scene, f, nullptr);
         delete(accessor);
     }
 
-    layer->scene->mask(shape, MaskMethod::Alpha);
+    rs.scene->mask(shape, MaskMethod::Alpha);
 }
 
 
@@ -1317,6 +1425,8 @@ void LottieBuilder::updateEffect(LottieLayer* layer, float frameNo)
 
     if (layer->effects.count == 0) return;
 
+    auto& rs = state(layer);
+
     ARRAY_FOREACH(p, layer->effects) {
         if (!(*p)->enable) continue;
         switch ((*p)->type) {
@@ -1324,13 +1434,13 @@ void LottieBuilder::updateEffect(LottieLayer* layer, float frameNo)
                 auto effect = static_cast<LottieFxTint*>(*p);
                 auto black = effect->black(frameNo);
                 auto white = effect->white(frameNo);
-                layer->scene->push(SceneEffect::Tint, black.rgb[0], black.rgb[1], black.rgb[2], white.rgb[0], white.rgb[1], white.rgb[2], (double)effect->intensity(frameNo));
+                rs.scene->push(SceneEffect::Tint, black.rgb[0], black.rgb[1], black.rgb[2], white.rgb[0], white.rgb[1], white.rgb[2], (double)effect->intensity(frameNo));
                 break;
             }
             case LottieEffect::Fill: {
                 auto effect = static_cast<LottieFxFill*>(*p);
                 auto color = effect->color(frameNo);
-                layer->scene->push(SceneEffect::Fill, color.rgb[0], color.rgb[1], color.rgb[2], (int)(255.0f * effect->opacity(frameNo)));
+                rs.scene->push(SceneEffect::Fill, color.rgb[0], color.rgb[1], color.rgb[2], (int)(255.0f * effect->opacity(frameNo)));
                 break;
             }
             case LottieEffect::Stroke: {
@@ -1343,19 +1453,19 @@ void LottieBuilder::updateEffect(LottieLayer* layer, float frameNo)
                 auto dark = effect->dark(frameNo);
                 auto midtone = effect->midtone(frameNo);
                 auto bright = effect->bright(frameNo);
-                layer->scene->push(SceneEffect::Tritone, dark.rgb[0], dark.rgb[1], dark.rgb[2], midtone.rgb[0], midtone.rgb[1], midtone.rgb[2], bright.rgb[0], bright.rgb[1], bright.rgb[2], (int)effect->blend(frameNo));
+                rs.scene->push(SceneEffect::Tritone, dark.rgb[0], dark.rgb[1], dark.rgb[2], midtone.rgb[0], midtone.rgb[1], midtone.rgb[2], bright.rgb[0], bright.rgb[1], bright.rgb[2], (int)effect->blend(frameNo));
                 break;
             }
             case LottieEffect::DropShadow: {
                 auto effect = static_cast<LottieFxDropShadow*>(*p);
                 auto color = effect->color(frameNo);
                 //seems the opacity range in dropshadow is 0 ~ 256
-                layer->scene->push(SceneEffect::DropShadow, color.rgb[0], color.rgb[1], color.rgb[2], std::min(255, (int)effect->opacity(frameNo)), (double)effect->angle(frameNo), double(effect->distance(frameNo) * 0.5f), (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), QUALITY);
+                rs.scene->push(SceneEffect::DropShadow, color.rgb[0], color.rgb[1], color.rgb[2], std::min(255, (int)effect->opacity(frameNo)), (double)effect->angle(frameNo), double(effect->distance(frameNo) * 0.5f), (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), QUALITY);
                 break;
             }
             case LottieEffect::GaussianBlur: {
                 auto effect = static_cast<LottieFxGaussianBlur*>(*p);
-                layer->scene->push(SceneEffect::GaussianBlur, (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), effect->direction(frameNo) - 1, effect->wrap(frameNo), QUALITY);
+                rs.scene->push(SceneEffect::GaussianBlur, (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), effect->direction(frameNo) - 1, effect->wrap(frameNo), QUALITY);
                 break;
             }
             default: break;
@@ -1366,7 +1476,9 @@ void LottieBuilder::updateEffect(LottieLayer* layer, float frameNo)
 
 void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLayer* layer, float frameNo)
 {
-    layer->scene = nullptr;
+    auto& rs = state(layer);
+
+    rs.scene = nullptr;
 
     //visibility
     if (frameNo < layer->inFrame || frameNo >= layer->outFrame) return;
@@ -1374,19 +1486,23 @@ void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLay
     updateTransform(layer, frameNo);
 
     //full transparent scene. no need to perform
-    if (layer->type != LottieLayer::Null && layer->cache.opacity == 0) return;
+    if (layer->type != LottieLayer::Null && rs.cache.opacity == 0) return;
 
-    //Prepare render data
-    layer->scene = Scene::gen();
-    layer->scene->id = layer->id;
+    //Prepare render data, the time-invariant contents built previously can be reused as they are.
+    auto reuse = layer->invariant && rs.retained && !SCENE(rs.retained)->paints.empty();
+    rs.scene = _retain(rs.retained, !reuse);
+    if (rs.scene != rs.retained) reuse = false;
+    rs.scene->id = layer->id;
 
     //ignore opacity when Null layer?
-    if (layer->type != LottieLayer::Null) layer->scene->opacity(layer->cache.opacity);
+    if (layer->type != LottieLayer::Null) rs.scene->opacity(rs.cache.opacity);
 
-    layer->scene->transform(layer->cache.matrix);
+    _transform(rs.scene, rs.cache.matrix);
 
     if (!updateMatte(comp, frameNo, scene, layer)) return;
 
+    auto begin = drafted;
+
     switch (layer->type) {
         case LottieLayer::Precomp: {
             if (!tweening()) updatePrecomp(comp, layer, frameNo);
@@ -1406,9 +1522,9 @@ void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLay
             break;
         }
         default: {
-            if (!layer->children.empty()) {
+            if (!reuse && !layer->children.empty()) {
                 Inlist<RenderContext> contexts;
-                contexts.back(new RenderContext(layer->pooling()));
+                contexts.back(new RenderContext(rs.shapes.pooling()));
                 updateChildren(layer, frameNo, contexts);
                 contexts.free();
             }
@@ -1416,13 +1532,17 @@ void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLay
         }
     }
 
+    commit(begin);
+    SCENE(rs.scene)->commit();
+
     updateMasks(layer, frameNo);
 
-    layer->scene->blend(layer->blendMethod);
+    rs.scene->blend(layer->blendMethod);
 
     updateEffect(layer, frameNo);
 
-    if (!layer->matteSrc) scene->push(layer->scene);
+    //the parallel building pushes the top-level layers after the join
+    if (!layer->matteSrc && scene) scene->push(rs.scene);
 }
 
 
@@ -1526,10 +1646,115 @@ static bool _buildComposition(LottieComposition* comp, LottieLayer* parent)
 }
 
 
+//propagate the fragmenting requirement of the groups down to their sub groups
+static void _buildFragment(LottieGroup* parent)
+{
+    ARRAY_FOREACH(p, parent->children) {
+        if ((*p)->type == LottieObject::Group) {
+            auto group = static_cast<LottieGroup*>(*p);
+            group->reqFragment |= parent->reqFragment;
+            _buildFragment(group);
+        } else if ((*p)->type == LottieObject::Layer) {
+            //the precomp layers share the children of the assets
+            if (!static_cast<LottieLayer*>(*p)->rid) _buildFragment(static_cast<LottieGroup*>(*p));
+        }
+    }
+}
+
+
+static constexpr uint32_t LANE_WEIGHT = 64;   //experimental decision, the minimum objects worth a worker
+
+
+//builds a part of the top-level layers with its own scratch data while sharing the render states
+struct LottieBuildLane : Task
+{
+    LottieBuilder worker;
+    Array<LottieLayer*> layers;   //in the update order
+    LottieComposition* comp = nullptr;
+    float frameNo = 0.0f;
+    uint32_t weight = 0;
+
+    LottieBuildLane(LottieBuilder* owner) : worker(owner) {}
+
+    void run(TVG_UNUSED unsigned tid) override
+    {
+        LottieCursors bind(&worker.owner->cursors);
+        ARRAY_FOREACH(p, layers) worker.updateLayer(comp, nullptr, *p, frameNo);
+    }
+};
+
+
+static uint32_t _weigh(LottieGroup* parent)
+{
+    auto weight = parent->children.count;
+    ARRAY_FOREACH(p, parent->children) {
+        if ((*p)->type == LottieObject::Group || (*p)->type == LottieObject::Layer) weight += _weigh(static_cast<LottieGroup*>(*p));
+    }
+    return weight;
+}
+
+
+//collect the objects whose render states could be touched by building the layer other than its own ones:
+//the matte targets and the precomp assets which the other layers may refer to as well.
+static void _bind(LottieLayer* layer, Array<LottieObject*>& keys)
+{
+    if (auto target = layer->matteTarget) {
+        keys.push(target);
+        _bind(target, keys);
+    }
+
+    if (layer->type != LottieLayer::Precomp || layer->children.empty()) return;
+
+    //the precomp layers referring to the same asset share the children
+    auto asset = layer->children.first();
+    ARRAY_FOREACH(p, keys) {
+        if (*p == asset) return;
+    }
+    keys.push(asset);
+
+    ARRAY_FOREACH(p, layer->children) {
+        _bind(static_cast<LottieLayer*>(*p), keys);
+    }
+}
+
+
+static uint32_t _unit(Array<uint32_t>& units, uint32_t i)
+{
+    while (units[i] != i) i = units[i] = units[units[i]];
+    return i;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
 
+thread_local Array<uint32_t>* LottieCursors::current = nullptr;
+
+
+LottieBuilder::LottieBuilder(LottieBuilder* owner) : exps(owner->exps), states(owner->states), owner(owner)
+{
+}
+
+
+LottieBuilder::~LottieBuilder()
+{
+    ARRAY_FOREACH(p, drafts) p->shape->unref();
+    if (owner) return;
+
+    ARRAY_FOREACH(p, lanes) delete(*p);
+    LottieExpressions::retrieve(exps);
+    if (!initiated) delete(root);
+    delete[](states);
+}
+
+
+LottieRenderState& LottieBuilder::state(LottieObject* obj)
+{
+    return states[obj->stateIdx];
+}
+
+
 bool LottieBuilder::update(LottieComposition* comp, float frameNo)
 {
     if (comp->root->children.empty()) return false;
@@ -1542,33 +1767,186 @@ bool LottieBuilder::update(LottieComposition* comp, float frameNo)
         if (equal(frameNo, tween.frameNo)) offTween();
     }
 
-    if (exps && comp->expressions) exps->update(comp->timeAtFrame(frameNo));
+    //the slots could append the keyframed properties
+    while (cursors.count < comp->cursors) cursors.push(0);
+    LottieCursors bind(&cursors);
+
+    if (exps && comp->expressions) exps->update(comp->timeAtFrame(frameNo), states);
+
+    SCENE(root)->recycle();
 
     //update children layers
-    ARRAY_REVERSE_FOREACH(child, comp->root->children) {
-        auto layer = static_cast<LottieLayer*>(*child);
-        if (!layer->matteSrc) updateLayer(comp, comp->root->scene, layer, frameNo);
+    if (lanes.count > 1 && !tweening() && !comp->expressions) {
+        parallelize(comp, frameNo);
+    } else {
+        ARRAY_REVERSE_FOREACH(child, comp->root->children) {
+            auto layer = static_cast<LottieLayer*>(*child);
+            if (!layer->matteSrc) updateLayer(comp, root, layer, frameNo);
+        }
     }
 
+    SCENE(root)->commit();
+
     return true;
 }
 
 
+void LottieBuilder::prepare(LottieComposition* comp)
+{
+    comp->analyze();
+
+    _buildComposition(comp, comp->root);
+
+    //precomp assets are built on demand, so walk them individually
+    _buildFragment(comp->root);
+    ARRAY_FOREACH(p, comp->assets) {
+        if ((*p)->type == LottieObject::Layer) _buildFragment(static_cast<LottieLayer*>(*p));
+    }
+}
+
+
 void LottieBuilder::build(LottieComposition* comp)
 {
     if (!comp) return;
 
-    comp->root->scene = Scene::gen();
+    states = new LottieRenderState[comp->states];
+    root = Scene::gen();
 
-    _buildComposition(comp, comp->root);
+    distribute(comp);
 
     if (!update(comp, 0)) return;
 
     //viewport clip
     auto clip = Shape::gen();
     clip->appendRect(0, 0, comp->w, comp->h);
-    comp->root->scene->clip(clip);
+    root->clip(clip);
 
     //turn off partial rendering for children
-    SCENE(comp->root->scene)->size({comp->w, comp->h});
-}
\ No newline at end of file
+    SCENE(root)->size({comp->w, comp->h});
+}
+
+
+//group the top-level layers into the lanes. the layers sharing any render states stay in the same lane.
+void LottieBuilder::distribute(LottieComposition* comp)
+{
+    auto threads = TaskScheduler::threads();
+    if (threads == 0 || comp->expressions) return;
+
+    auto& children = comp->root->children;
+    Array<uint32_t> units(children.count);     //disjoint sets of the layers
+    Array<uint32_t> weights(children.count);
+    Array<uint32_t> lane(children.count);
+    Array<LottieObject*> keys;
+    Array<uint32_t> binders;     //the first unit binding the key
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < children.count; ++i) {
+        auto layer = static_cast<LottieLayer*>(children[i]);
+        units.push(i);
+        weights.push(0);
+        lane.push(0);
+        if (layer->matteSrc) continue;
+
+        weights[i] = 1 + _weigh(layer);
+        if (layer->matteTarget) weights[i] += 1 + _weigh(layer->matteTarget);
+        total += weights[i];
+
+        Array<LottieObject*> bound;
+        _bind(layer, bound);
+
+        ARRAY_FOREACH(p, bound) {
+            uint32_t k = 0;
+            for (; k < keys.count; ++k) {
+                if (keys[k] == *p) break;
+            }
+            if (k == keys.count) {
+                keys.push(*p);
+                binders.push(i);
+            } else {
+                units[_unit(units, i)] = _unit(units, binders[k]);
+            }
+        }
+    }
+
+    //merge the weights to the representative units
+    for (uint32_t i = 0; i < children.count; ++i) {
+        auto u = _unit(units, i);
+        if (u != i) {
+            weights[u] += weights[i];
+            weights[i] = 0;
+        }
+    }
+
+    uint32_t cnt = 0;
+    ARRAY_FOREACH(p, weights) {
+        if (*p > 0) ++cnt;
+    }
+    cnt = std::min(std::min(cnt, threads + 1), total / LANE_WEIGHT);
+    if (cnt < 2) return;
+
+    lanes.reserve(cnt);
+    for (uint32_t i = 0; i < cnt; ++i) lanes.push(new LottieBuildLane(this));
+
+    //the heaviest unit goes to the lightest lane first
+    while (true) {
+        uint32_t heaviest = 0;
+        for (uint32_t i = 1; i < children.count; ++i) {
+            if (weights[i] > weights[heaviest]) heaviest = i;
+        }
+        if (weights[heaviest] == 0) break;
+
+        auto lightest = lanes.data;
+        ARRAY_FOREACH(p, lanes) {
+            if ((*p)->weight < (*lightest)->weight) lightest = p;
+        }
+        (*lightest)->weight += weights[heaviest];
+        lane[heaviest] = lightest - lanes.data;
+        weights[heaviest] = 0;
+    }
+
+    //each lane keeps the original order of its layers
+    for (int32_t i = children.count - 1; i >= 0; --i) {
+        auto layer = static_cast<LottieLayer*>(children[i]);
+        if (!layer->matteSrc) lanes[lane[_unit(units, i)]]->layers.push(layer);
+    }
+}
+
+
+void LottieBuilder::parallelize(LottieComposition* comp, float frameNo)
+{
+    //the parent layers could be referred by the multiple lanes, resolve their transforms beforehand
+    ARRAY_FOREACH(p, comp->root->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        if (frameNo >= layer->inFrame && frameNo < layer->outFrame) updateTransform(layer, frameNo);
+    }
+
+    //the current thread takes the first lane
+    TaskGroup group;
+    for (uint32_t i = 0; i < lanes.count; ++i) {
+        lanes[i]->comp = comp;
+        lanes[i]->frameNo = frameNo;
+        if (i > 0) TaskScheduler::request(lanes[i], &group);
+    }
+    lanes[0]->run(0);
+    group.wait();
+
+    //deterministic join, the same order with the serial building
+    ARRAY_REVERSE_FOREACH(p, comp->root->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        if (!layer->matteSrc && state(layer).scene) root->push(state(layer).scene);
+    }
+}
+
+
+void LottieBuilder::flush(LottieComposition* comp)
+{
+    if (!states) return;
+    for (uint32_t i = 0; i < comp->states; ++i) states[i].images.clear();
+}
+
+
+void LottieBuilder::clear()
+{
+    //detach the layers, they will be reclaimed by the next frame update
+    if (root) SCENE(root)->recycle();
+}
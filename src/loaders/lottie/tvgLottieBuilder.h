@@ -28,8 +28,10 @@
 #include "tvgShape.h"
 #include "tvgLottieExpressions.h"
 #include "tvgLottieModifier.h"
+#include "tvgLottieRenderPooler.h"
 
 struct LottieComposition;
+struct LottieBuildLane;
 
 struct RenderRepeater
 {
@@ -47,6 +49,12 @@ struct RenderRepeater
 
 enum RenderFragment : uint8_t {ByNone = 0, ByFill, ByStroke};
 
+struct RenderDraft
+{
+    Shape* shape;     //drafting shape of the current frame
+    Shape* target;    //retained shape which takes the changes only
+};
+
 struct RenderContext
 {
     INLIST_ITEM(RenderContext);
@@ -111,10 +119,7 @@ struct LottieBuilder
         exps = LottieExpressions::instance();
     }
 
-    ~LottieBuilder()
-    {
-        LottieExpressions::retrieve(exps);
-    }
+    ~LottieBuilder();
 
     bool expressions()
     {
@@ -138,10 +143,34 @@ struct LottieBuilder
         return tween.active;
     }
 
+    bool built()
+    {
+        return states ? true : false;
+    }
+
+    Scene* paint()
+    {
+        initiated = true;
+        return root;
+    }
+
+    //drop the image copies which were pooled before the image assets get overridden
+    void flush(LottieComposition* comp);
+    void clear();
+
+    static void prepare(LottieComposition* comp);
     bool update(LottieComposition* comp, float progress);
     void build(LottieComposition* comp);
 
 private:
+    friend struct LottieBuildLane;
+
+    LottieBuilder(LottieBuilder* owner);
+    void distribute(LottieComposition* comp);
+    void parallelize(LottieComposition* comp, float frameNo);
+    LottieRenderState& state(LottieObject* obj);
+    void draw(LottieGroup* parent, LottieObject* obj, RenderContext* ctx);
+    void commit(uint32_t begin);
     void appendRect(Shape* shape, Point& pos, Point& size, float r, bool clockwise, RenderContext* ctx);
     bool fragmented(LottieGroup* parent, LottieObject** child, Inlist<RenderContext>& contexts, RenderContext* ctx, RenderFragment fragment);
 
@@ -175,8 +204,16 @@ private:
     void updateOffsetPath(LottieGroup* parent, LottieObject** child, float frameNo, Inlist<RenderContext>& contexts, RenderContext* ctx);
 
     RenderPath buffer;   //resusable path
+    Array<RenderDraft> drafts;
+    uint32_t drafted = 0;
     LottieExpressions* exps;
+    LottieRenderState* states = nullptr;  //render states of the composition objects of this instance
+    Array<uint32_t> cursors;              //keyframe cursors of the composition properties of this instance
+    Scene* root = nullptr;
+    Array<LottieBuildLane*> lanes;   //workers building the top-level layers in parallel
+    LottieBuilder* owner = nullptr;  //the lane worker borrows the render states and the cursors of the owner
     Tween tween;
+    bool initiated = false;
 };
 
 #endif //_TVG_LOTTIE_BUILDER_H
\ No newline at end of file
@@ -24,6 +24,7 @@
 #include "tvgMath.h"
 #include "tvgCompressor.h"
 #include "tvgLottieModel.h"
+#include "tvgLottieRenderPooler.h"
 #include "tvgLottieExpressions.h"
 
 #ifdef THORVG_LOTTIE_EXPRESSIONS_SUPPORT
@@ -149,7 +150,8 @@ static void contentFree(void *native_p, struct jerry_object_native_info_t *info_
 }
 
 static jerry_object_native_info_t freeCb {contentFree, 0, 0};
-static uint32_t engineRefCnt = 0;  //Expressions Engine reference count
+static uint32_t engineRefCnt = 0;      //Expressions Engine reference count
+static uint32_t engineGeneration = 0;  //Expressions Engine instance count, the compiled code is valid only in its own one
 
 
 static char* _name(jerry_value_t args)
@@ -176,7 +178,7 @@ static unsigned long _idByName(jerry_value_t args)
 static jerry_value_t _toComp(const jerry_call_info_t* info, const jerry_value_t args[], const jerry_length_t argsCnt)
 {
     auto layer = static_cast<LottieLayer*>(jerry_object_get_native_ptr(info->function, nullptr));
-    return _point2d(_point2d(args[0]) * layer->cache.matrix);
+    return _point2d(_point2d(args[0]) * exps->states[layer->stateIdx].cache.matrix);
 }
 
 
@@ -1408,8 +1410,19 @@ jerry_value_t LottieExpressions::evaluate(float frameNo, LottieExpression* exp)
     //update writable values
     buildWritables(exp);
 
+    //compile the code once, then reuse it for the following frames. the code of a former engine is gone with it
+    if (!exp->bytecode || exp->generation != engineGeneration) {
+        exp->bytecode = jerry_eval_compile((jerry_char_t *) exp->code, strlen(exp->code), JERRY_PARSE_NO_OPTS);
+        exp->generation = engineGeneration;
+        if (!exp->bytecode) {
+            TVGERR("LOTTIE", "Failed to compile the expressions!");
+            exp->disabled = true;
+            return jerry_undefined();
+        }
+    }
+
     //evaluate the code
-    auto eval = jerry_eval((jerry_char_t *) exp->code, strlen(exp->code), JERRY_PARSE_NO_OPTS);
+    auto eval = jerry_eval_run(exp->bytecode, JERRY_PARSE_NO_OPTS);
 
     if (jerry_value_is_exception(eval)) {
         TVGERR("LOTTIE", "Failed to dispatch the expressions!");
@@ -1441,12 +1454,15 @@ LottieExpressions::~LottieExpressions()
 LottieExpressions::LottieExpressions()
 {
     jerry_init(JERRY_INIT_EMPTY);
+    ++engineGeneration;
     _buildMath(buildGlobal());
 }
 
 
-void LottieExpressions::update(float curTime)
+void LottieExpressions::update(float curTime, LottieRenderState* states)
 {
+    this->states = states;
+
     //time, #current time in seconds
     auto time = jerry_number(curTime);
     jerry_object_set_sz(global, EXP_TIME, time);
@@ -1480,6 +1496,13 @@ void LottieExpressions::retrieve(LottieExpressions* instance)
 }
 
 
+void LottieExpressions::release(void* bytecode, uint32_t generation)
+{
+    //the compiled code is gone together with its engine
+    if (exps && bytecode && generation == engineGeneration) jerry_eval_release(bytecode);
+}
+
+
 Point LottieExpressions::toPoint2d(jerry_value_t obj)
 {
     return _point2d(obj);
@@ -30,6 +30,7 @@ struct LottieExpression;
 struct LottieComposition;
 struct LottieLayer;
 struct LottieModifier;
+struct LottieRenderState;
 
 #ifdef THORVG_LOTTIE_EXPRESSIONS_SUPPORT
 
@@ -125,11 +126,14 @@ public:
         return true;
     }
 
-    void update(float curTime);
+    void update(float curTime, LottieRenderState* states);
 
     //singleton (no thread safety)
     static LottieExpressions* instance();
     static void retrieve(LottieExpressions* instance);
+    static void release(void* bytecode, uint32_t generation);
+
+    LottieRenderState* states = nullptr;  //render states of the current animation instance
 
 private:
     LottieExpressions();
@@ -164,9 +168,10 @@ struct LottieExpressions
     template<typename Property> bool result(TVG_UNUSED float, TVG_UNUSED Fill*, TVG_UNUSED LottieExpression*) { return false; }
     template<typename Property> bool result(TVG_UNUSED float, TVG_UNUSED RenderPath&, TVG_UNUSED Matrix*, TVG_UNUSED LottieModifier*, TVG_UNUSED LottieExpression*) { return false; }
     bool result(TVG_UNUSED float, TVG_UNUSED TextDocument& doc, TVG_UNUSED LottieExpression*) { return false; }
-    void update(TVG_UNUSED float) {}
+    void update(TVG_UNUSED float, TVG_UNUSED LottieRenderState*) {}
     static LottieExpressions* instance() { return nullptr; }
     static void retrieve(TVG_UNUSED LottieExpressions* instance) {}
+    static void release(TVG_UNUSED void* bytecode, TVG_UNUSED uint32_t generation) {}
 };
 
 #endif //THORVG_LOTTIE_EXPRESSIONS_SUPPORT
@@ -120,15 +120,23 @@ float LottieInterpolator::NewtonRaphsonIterate(float aX, float aGuessT)
 float LottieInterpolator::progress(float t)
 {
     if (outTangent.x == outTangent.y && inTangent.x == inTangent.y) return t;
+
+    if (table) {
+        auto x = tvg::clamp(t, 0.0f, 1.0f) * float(EASING_TABLE_SIZE - 1);
+        auto i = std::min(int(x), EASING_TABLE_SIZE - 2);
+        if (!table->solve[i]) return tvg::lerp(table->samples[i], table->samples[i + 1], x - float(i));
+    }
+
     return _calcBezier(getTForX(t), outTangent.y, inTangent.y);
 }
 
 
-void LottieInterpolator::set(const char* key, Point& inTangent, Point& outTangent)
+void LottieInterpolator::set(const char* key, Point& inTangent, Point& outTangent, bool precompute)
 {
     if (key) this->key = duplicate(key);
     this->inTangent = inTangent;
     this->outTangent = outTangent;
+    this->table = nullptr;
 
     if (outTangent.x == outTangent.y && inTangent.x == inTangent.y) return;
 
@@ -136,4 +144,30 @@ void LottieInterpolator::set(const char* key, Point& inTangent, Point& outTangen
     for (int i = 0; i < SPLINE_TABLE_SIZE; ++i) {
         samples[i] = _calcBezier(float(i) * SAMPLE_STEP_SIZE, outTangent.x, inTangent.x);
     }
+
+#ifdef THORVG_LOTTIE_EASING_TABLE_SUPPORT
+    if (precompute) tabulate();
+#endif
+}
+
+
+void LottieInterpolator::tabulate()
+{
+    if (table || (outTangent.x == outTangent.y && inTangent.x == inTangent.y)) return;
+
+    table = tvg::malloc<Table*>(sizeof(Table));
+
+    //the curve passes the both ends exactly
+    auto values = table->samples;
+    values[0] = 0.0f;
+    values[EASING_TABLE_SIZE - 1] = 1.0f;
+    for (int i = 1; i < EASING_TABLE_SIZE - 1; ++i) {
+        values[i] = _calcBezier(getTForX(float(i) / float(EASING_TABLE_SIZE - 1)), outTangent.y, inTangent.y);
+    }
+
+    //verify the linear interpolation error at the midpoints
+    for (int i = 0; i < EASING_TABLE_SIZE - 1; ++i) {
+        auto mid = _calcBezier(getTForX((float(i) + 0.5f) / float(EASING_TABLE_SIZE - 1)), outTangent.y, inTangent.y);
+        table->solve[i] = fabsf((values[i] + values[i + 1]) * 0.5f - mid) > EASING_TABLE_TOLERANCE;
+    }
 }
\ No newline at end of file
@@ -21,31 +21,99 @@
  */
 
 #include "tvgStr.h"
- #include "tvgLottieLoader.h"
+#include "tvgLottieLoader.h"
 #include "tvgLottieModel.h"
 #include "tvgLottieParser.h"
 #include "tvgLottieBuilder.h"
+#include "tvgLottieBinary.h"
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+//parsed compositions which are shared among the animation instances
+static Array<LottieComposition*> _shared;
+static Key _sharedKey;
+
+
+static LottieComposition* _share(const char* path, const char* data, uint32_t size, bool expressions)
+{
+    ScopedLock lock(_sharedKey);
+
+    ARRAY_FOREACH(p, _shared) {
+        auto& sharing = (*p)->sharing;
+        if (sharing.data != (uintptr_t)data || sharing.size != size || sharing.expressions != expressions) continue;
+        if (strcmp(sharing.path, path)) continue;
+        ++sharing.refCnt;
+        return *p;
+    }
+    return nullptr;
+}
+
+
+static LottieComposition* _share(LottieComposition* comp)
+{
+    ScopedLock lock(_sharedKey);
+    ++comp->sharing.refCnt;
+    return comp;
+}
+
+
+static void _publish(LottieComposition* comp, const char* path, const char* data, uint32_t size, bool expressions)
+{
+    comp->sharing.path = duplicate(path);
+    comp->sharing.data = (uintptr_t)data;
+    comp->sharing.size = size;
+    comp->sharing.expressions = expressions;
+
+    ScopedLock lock(_sharedKey);
+    _shared.push(comp);
+}
+
+
+static void _retrieve(LottieComposition* comp)
+{
+    if (!comp) return;
+
+    if (comp->sharing.path) {
+        ScopedLock lock(_sharedKey);
+        if (--comp->sharing.refCnt > 0) return;
+        ARRAY_FOREACH(p, _shared) {
+            if (*p != comp) continue;
+            *p = _shared.last();
+            _shared.pop();
+            break;
+        }
+    }
+    delete(comp);
+}
+
+
 void LottieLoader::run(unsigned tid)
 {
     //update frame
-    if (comp) {
+    if (builder->built()) {
         builder->update(comp, frameNo);
     //initial loading
     } else {
-        LottieParser parser(content, dirName, builder->expressions());
-        if (!parser.parse()) return;
-        {
-            ScopedLock lock(key);
-            comp = parser.comp;
-        }
-        if (parser.slots) {
-            override(parser.slots, true);
-            parser.slots = nullptr;
+        //parse the composition unless it's shared
+        if (!comp) {
+            LottieParser parser(content, dirName, builder->expressions());
+            if (!parser.parse()) return;
+            {
+                ScopedLock lock(key);
+                comp = parser.comp;
+            }
+            if (parser.slots) {
+                override(parser.slots, true);
+                parser.slots = nullptr;
+            }
+            LottieBuilder::prepare(comp);
+
+            if (comp->shareable()) {
+                if (path) _publish(comp, path, nullptr, 0, builder->expressions());
+                else if (!copy) _publish(comp, dirName, content, size, builder->expressions());
+            }
         }
         builder->build(comp);
 
@@ -57,6 +125,11 @@ void LottieLoader::run(unsigned tid)
 
 void LottieLoader::release()
 {
+    if (file.data) {
+        file.unmap();
+        content = nullptr;
+        return;
+    }
     if (copy) {
         tvg::free((char*)content);
         content = nullptr;
@@ -80,29 +153,49 @@ LottieLoader::~LottieLoader()
 
     release();
 
-    //TODO: correct position?
-    delete(comp);
+    //the expressions of the composition must be released before the builder
+    _retrieve(comp);
     delete(builder);
 
     tvg::free(dirName);
+    tvg::free(path);
 }
 
 
 bool LottieLoader::header()
 {
+    //precompiled lottie, verify it ahead of the parsing
+    LottieBinary::Header binary;
+    auto precompiled = LottieBinary::magic(content, size);
+    if (precompiled && !LottieBinary::header(content, size, binary)) {
+        TVGERR("LOTTIE", "Corrupted precompiled lottie!");
+        return false;
+    }
+
     //A single thread doesn't need to perform intensive tasks.
     if (TaskScheduler::threads() == 0) {
         LoadModule::read();
         run(0);
-        if (comp) {
-            w = static_cast<float>(comp->w);
-            h = static_cast<float>(comp->h);
-            segmentEnd = frameCnt = comp->frameCnt();
-            frameRate = comp->frameRate;
-            return true;
-        } else {
-            return false;
-        }
+    }
+
+    //the composition is ready, either parsed or shared.
+    if (comp) {
+        w = static_cast<float>(comp->w);
+        h = static_cast<float>(comp->h);
+        segmentEnd = frameCnt = comp->frameCnt();
+        frameRate = comp->frameRate;
+        return true;
+    } else if (TaskScheduler::threads() == 0) {
+        return false;
+    }
+
+    //the animation info is given in the binary header
+    if (precompiled) {
+        w = binary.w;
+        h = binary.h;
+        frameRate = binary.frameRate;
+        segmentEnd = frameCnt = (binary.endFrame - binary.startFrame);
+        return frameRate >= FLOAT_EPSILON;
     }
 
     //Quickly validate the given Lottie file without parsing in order to get the animation info.
@@ -199,6 +292,13 @@ bool LottieLoader::header()
 
 bool LottieLoader::open(const char* data, uint32_t size, const char* rpath, bool copy)
 {
+    if (!rpath) this->dirName = duplicate(".");
+    else this->dirName = duplicate(rpath);
+
+    //Note that users could use the same data pointer with the different content.
+    //Thus sharing is only valid for the uncopied data.
+    if (!copy && (comp = _share(dirName, data, size, builder->expressions()))) return header();
+
     if (copy) {
         content = tvg::malloc<char*>(size + 1);
         if (!content) return false;
@@ -209,9 +309,6 @@ bool LottieLoader::open(const char* data, uint32_t size, const char* rpath, bool
     this->size = size;
     this->copy = copy;
 
-    if (!rpath) this->dirName = duplicate(".");
-    else this->dirName = duplicate(rpath);
-
     return header();
 }
 
@@ -219,27 +316,16 @@ bool LottieLoader::open(const char* data, uint32_t size, const char* rpath, bool
 bool LottieLoader::open(const char* path)
 {
 #ifdef THORVG_FILE_IO_SUPPORT
-    auto f = fopen(path, "r");
-    if (!f) return false;
-
-    fseek(f, 0, SEEK_END);
-
-    size = ftell(f);
-    if (size == 0) {
-        fclose(f);
-        return false;
-    }
+    this->dirName = tvg::dirname(path);
+    this->path = duplicate(path);
 
-    auto content = tvg::malloc<char*>(sizeof(char) * size + 1);
-    fseek(f, 0, SEEK_SET);
-    size = fread(content, sizeof(char), size, f);
-    content[size] = '\0';
+    if ((comp = _share(path, nullptr, 0, builder->expressions()))) return header();
 
-    fclose(f);
+    //the json is parsed in place, only the written pages are privately copied
+    if (!file.map(path, true)) return false;
 
-    this->dirName = tvg::dirname(path);
-    this->content = content;
-    this->copy = true;
+    content = file.data;
+    size = file.size;
 
     return header();
 #else
@@ -270,7 +356,7 @@ bool LottieLoader::read()
     //the loading has been already completed
     if (!LoadModule::read()) return true;
 
-    if (!content || size == 0) return false;
+    if (!comp && (!content || size == 0)) return false;
 
     TaskScheduler::request(this);
 
@@ -283,8 +369,7 @@ Paint* LottieLoader::paint()
     done();
 
     if (!comp) return nullptr;
-    comp->initiated = true;
-    return comp->root->scene;
+    return builder->paint();
 }
 
 
@@ -314,12 +399,14 @@ bool LottieLoader::override(const char* slots, bool byDefault)
             ++idx;
         }
         tvg::free((char*)temp);
+        if (succeed) builder->flush(comp);
         rebuild = succeed;
         overridden |= succeed;
         return rebuild;
     //reset slots
     } else if (overridden) {
         ARRAY_FOREACH(p, comp->slots) (*p)->reset();
+        builder->flush(comp);
         overridden = false;
         rebuild = true;
     }
@@ -347,7 +434,7 @@ bool LottieLoader::frame(float no)
 
     builder->offTween();
 
-    if (comp) comp->clear();     //clear synchronously
+    builder->clear();     //clear synchronously
 
     TaskScheduler::request(this);
 
@@ -401,6 +488,15 @@ const char* LottieLoader::markers(uint32_t index)
 }
 
 
+bool LottieLoader::stats(uint32_t* invariant, uint32_t* animated)
+{
+    if (!ready()) return false;
+    if (invariant) *invariant = comp->stats.invariant;
+    if (animated) *animated = comp->stats.animated;
+    return true;
+}
+
+
 Result LottieLoader::segment(float begin, float end)
 {
     if (begin < 0.0f) begin = 0.0f;
@@ -415,6 +511,25 @@ Result LottieLoader::segment(float begin, float end)
 }
 
 
+FrameModule* LottieLoader::replicate()
+{
+    //only the published composition is never changed by the instances
+    if (!ready() || !comp->sharing.path) return nullptr;
+
+    auto loader = new LottieLoader;
+    loader->comp = _share(comp);
+    loader->dirName = duplicate(dirName);
+    loader->w = w;
+    loader->h = h;
+    loader->frameRate = frameRate;
+    loader->frameCnt = frameCnt;
+    loader->segmentBegin = segmentBegin;
+    loader->segmentEnd = segmentEnd;
+
+    return loader;
+}
+
+
 bool LottieLoader::segment(const char* marker, float& begin, float& end)
 {
     if (!ready() || comp->markers.count == 0) return false;
@@ -454,7 +569,7 @@ bool LottieLoader::tween(float from, float to, float progress)
 
     builder->onTween(shorten(to), progress);
 
-    if (comp) comp->clear();     //clear synchronously
+    builder->clear();     //clear synchronously
 
     TaskScheduler::request(this);
 
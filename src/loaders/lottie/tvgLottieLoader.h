@@ -24,6 +24,7 @@
 #define _TVG_LOTTIE_LOADER_H_
 
 #include "tvgCommon.h"
+#include "tvgFile.h"
 #include "tvgFrameModule.h"
 #include "tvgTaskScheduler.h"
 
@@ -44,6 +45,8 @@ public:
 
     Key key;
     char* dirName = nullptr;            //base resource directory
+    char* path = nullptr;               //source file path
+    FileMap file;                       //"content" is mapped from the file
     bool copy = false;                  //"content" is owned by this loader
     bool overridden = false;            //overridden properties with slots
     bool rebuild = false;               //require building the lottie scene
@@ -68,8 +71,10 @@ public:
     //Marker Supports
     uint32_t markersCnt();
     const char* markers(uint32_t index);
+    bool stats(uint32_t* invariant, uint32_t* animated);
     bool segment(const char* marker, float& begin, float& end);
     Result segment(float begin, float end) override;
+    FrameModule* replicate() override;
 
     float shorten(float frameNo);  //Reduce the accuracy for performance
     bool tween(float from, float to, float progress);
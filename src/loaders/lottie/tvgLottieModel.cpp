@@ -22,6 +22,8 @@
 
 #include "tvgMath.h"
 #include "tvgTaskScheduler.h"
+#include "tvgScene.h"
+#include "tvgPicture.h"
 #include "tvgLottieModel.h"
 #include "tvgCompressor.h"
 
@@ -57,6 +59,183 @@ Point LottieTextFollowPath::split(float dLen, float lenSearched, float& angle)
     return {};
 }
 
+static bool _invariant(LottieStroke* stroke)
+{
+    if (!stroke->width.invariant()) return false;
+    if (auto dash = stroke->dashattr) {
+        if (!dash->offset.invariant()) return false;
+        for (uint8_t i = 0; i < dash->size; ++i) {
+            if (!dash->values[i].invariant()) return false;
+        }
+    }
+    return true;
+}
+
+
+static bool _invariant(LottieGradient* gradient)
+{
+    return gradient->start.invariant() && gradient->end.invariant() && gradient->height.invariant() && gradient->angle.invariant() && gradient->opacity.invariant() && gradient->colorStops.invariant();
+}
+
+
+static bool _invariant(LottieTransform* transform)
+{
+    if (!transform) return true;
+    if (!transform->position.invariant() || !transform->rotation.invariant() || !transform->scale.invariant() || !transform->anchor.invariant() || !transform->opacity.invariant()) return false;
+    if (!transform->skewAngle.invariant() || !transform->skewAxis.invariant()) return false;
+    if (transform->coords && (!transform->coords->x.invariant() || !transform->coords->y.invariant())) return false;
+    if (transform->rotationEx && (!transform->rotationEx->x.invariant() || !transform->rotationEx->y.invariant())) return false;
+    return true;
+}
+
+
+static bool _analyze(LottieObject* obj, LottieComposition* comp);
+
+
+//analyze the children, the group contents are invariant if all of them are.
+static bool _analyze(LottieGroup* group, LottieComposition* comp)
+{
+    auto invariant = true;
+    ARRAY_FOREACH(p, group->children) {
+        if (!_analyze(*p, comp)) invariant = false;
+    }
+    group->invariant = invariant;
+    return invariant;
+}
+
+
+static bool _analyze(LottieLayer* layer, LottieComposition* comp)
+{
+    layer->stateIdx = comp->states++;
+
+    //the precomp contents are the assets which are analyzed independently
+    auto invariant = layer->rid ? true : _analyze(static_cast<LottieGroup*>(layer), comp);
+
+    //only the shape contents can be reused by the builder
+    if (layer->type != LottieLayer::Shape) layer->invariant = false;
+
+    //text documents and ranges are evaluated with the frame number
+    if (layer->type == LottieLayer::Text) invariant = false;
+
+    if (!_invariant(layer->transform) || !layer->timeRemap.invariant()) invariant = false;
+
+    ARRAY_FOREACH(p, layer->masks) {
+        auto mask = *p;
+        if (!mask->pathset.invariant() || !mask->expand.invariant() || !mask->opacity.invariant()) invariant = false;
+    }
+
+    if (invariant) ++comp->stats.invariant;
+    else ++comp->stats.animated;
+
+    return invariant;
+}
+
+
+static bool _analyze(LottieObject* obj, LottieComposition* comp)
+{
+    auto invariant = true;
+
+    //Here switch-case statements are more performant than virtual methods.
+    switch (obj->type) {
+        case LottieObject::Layer: {
+            return _analyze(static_cast<LottieLayer*>(obj), comp);
+        }
+        case LottieObject::Group: {
+            obj->stateIdx = comp->states++;
+            invariant = _analyze(static_cast<LottieGroup*>(obj), comp);
+            break;
+        }
+        case LottieObject::Transform: {
+            invariant = _invariant(static_cast<LottieTransform*>(obj));
+            break;
+        }
+        case LottieObject::SolidFill: {
+            auto fill = static_cast<LottieSolidFill*>(obj);
+            invariant = fill->color.invariant() && fill->opacity.invariant();
+            break;
+        }
+        case LottieObject::SolidStroke: {
+            auto stroke = static_cast<LottieSolidStroke*>(obj);
+            invariant = stroke->color.invariant() && stroke->opacity.invariant() && _invariant(static_cast<LottieStroke*>(stroke));
+            break;
+        }
+        case LottieObject::GradientFill: {
+            invariant = _invariant(static_cast<LottieGradient*>(static_cast<LottieGradientFill*>(obj)));
+            break;
+        }
+        case LottieObject::GradientStroke: {
+            auto stroke = static_cast<LottieGradientStroke*>(obj);
+            invariant = _invariant(static_cast<LottieGradient*>(stroke)) && _invariant(static_cast<LottieStroke*>(stroke));
+            break;
+        }
+        case LottieObject::Rect: {
+            auto rect = static_cast<LottieRect*>(obj);
+            rect->stateIdx = comp->states++;
+            invariant = rect->position.invariant() && rect->size.invariant() && rect->radius.invariant();
+            break;
+        }
+        case LottieObject::Ellipse: {
+            auto ellipse = static_cast<LottieEllipse*>(obj);
+            ellipse->stateIdx = comp->states++;
+            invariant = ellipse->position.invariant() && ellipse->size.invariant();
+            break;
+        }
+        case LottieObject::Path: {
+            obj->stateIdx = comp->states++;
+            invariant = static_cast<LottiePath*>(obj)->pathset.invariant();
+            break;
+        }
+        case LottieObject::Polystar: {
+            auto star = static_cast<LottiePolyStar*>(obj);
+            star->stateIdx = comp->states++;
+            invariant = star->position.invariant() && star->innerRadius.invariant() && star->outerRadius.invariant() && star->innerRoundness.invariant() &&
+                        star->outerRoundness.invariant() && star->rotation.invariant() && star->ptsCnt.invariant();
+            break;
+        }
+        case LottieObject::Image: {
+            invariant = static_cast<LottieImage*>(obj)->data.invariant();
+            break;
+        }
+        case LottieObject::Trimpath: {
+            auto trimpath = static_cast<LottieTrimpath*>(obj);
+            invariant = trimpath->start.invariant() && trimpath->end.invariant() && trimpath->offset.invariant();
+            break;
+        }
+        case LottieObject::Repeater: {
+            auto repeater = static_cast<LottieRepeater*>(obj);
+            invariant = repeater->copies.invariant() && repeater->offset.invariant() && repeater->position.invariant() && repeater->rotation.invariant() &&
+                        repeater->scale.invariant() && repeater->anchor.invariant() && repeater->startOpacity.invariant() && repeater->endOpacity.invariant();
+            break;
+        }
+        case LottieObject::RoundedCorner: {
+            invariant = static_cast<LottieRoundedCorner*>(obj)->radius.invariant();
+            break;
+        }
+        case LottieObject::OffsetPath: {
+            auto offset = static_cast<LottieOffsetPath*>(obj);
+            invariant = offset->offset.invariant() && offset->miterLimit.invariant();
+            break;
+        }
+        //text is evaluated with the frame number
+        case LottieObject::Text: {
+            obj->stateIdx = comp->states++;
+            if (static_cast<LottieText*>(obj)->followPath) comp->followPath = true;
+            invariant = false;
+            break;
+        }
+        default: {
+            invariant = false;
+            break;
+        }
+    }
+
+    if (invariant) ++comp->stats.invariant;
+    else ++comp->stats.animated;
+
+    return invariant;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -335,7 +514,7 @@ float LottieTextRange::factor(float frameNo, float totalLen, float idx)
         if (minEase > 0.0f) out.x = minEase * 0.01f;
         else out.y = -minEase * 0.01f;
 
-        interpolator->set(nullptr, in, out);
+        interpolator->set(nullptr, in, out, false);
         f = interpolator->progress(f);
     }
     f = tvg::clamp(f, 0.0f, 1.0f);
@@ -356,27 +535,23 @@ void LottieImage::prepare()
 {
     LottieObject::type = LottieObject::Image;
 
-    auto picture = Picture::gen();
-
-    //force to load a picture on the same thread
-    if (data.size > 0) picture->load((const char*)data.b64Data, data.size, data.mimeType);
-    else picture->load(data.path);
-
-    picture->size(data.width, data.height);
-    picture->ref();
-
-    pooler.push(picture);
+    update();
 }
 
 
 void LottieImage::update()
 {
-    //Update the picture data
-    ARRAY_FOREACH(p, pooler) {
-        if (data.size > 0) (*p)->load((const char*)data.b64Data, data.size, data.mimeType);
-        else (*p)->load(data.path);
-        (*p)->size(data.width, data.height);
-    }
+    //the instances will take the copies of the new one
+    if (picture) picture->unref();
+    picture = Picture::gen();
+    picture->ref();
+
+    if (data.size > 0) picture->load((const char*)data.b64Data, data.size, data.mimeType);
+    else picture->load(data.path);
+    picture->size(data.width, data.height);
+
+    //complete the decoding here, the copies must not wait for it while the picture is locked
+    PICTURE(picture)->load();
 }
 
 
@@ -550,6 +725,7 @@ LottieGroup::LottieGroup()
     trimpath = false;
     visible = false;
     allowMerge = true;
+    invariant = false;
 }
 
 
@@ -647,6 +823,8 @@ LottieLayer::~LottieLayer()
 
     delete(transform);
     tvg::free(name);
+
+    if (statical) statical->unref();
 }
 
 
@@ -673,17 +851,15 @@ void LottieLayer::prepare(RGB24* color)
 
     //prepare the viewport clipper
     if (type == LottieLayer::Precomp) {
-        auto clipper = Shape::gen();
-        clipper->appendRect(0.0f, 0.0f, w, h);
-        clipper->ref();
-        statical.pooler.push(clipper);
+        statical = Shape::gen();
+        statical->appendRect(0.0f, 0.0f, w, h);
+        statical->ref();
     //prepare solid fill in advance if it is a layer type.
     } else if (color && type == LottieLayer::Solid) {
-        auto solidFill = Shape::gen();
-        solidFill->appendRect(0, 0, static_cast<float>(w), static_cast<float>(h));
-        solidFill->fill(color->rgb[0], color->rgb[1], color->rgb[2]);
-        solidFill->ref();
-        statical.pooler.push(solidFill);
+        statical = Shape::gen();
+        statical->appendRect(0, 0, static_cast<float>(w), static_cast<float>(h));
+        statical->fill(color->rgb[0], color->rgb[1], color->rgb[2]);
+        statical->ref();
     }
 
     LottieGroup::prepare(LottieObject::Layer);
@@ -715,16 +891,35 @@ bool LottieLayer::assign(const char* layer, uint32_t ix, const char* var, float
 }
 
 
-LottieComposition::~LottieComposition()
+void LottieComposition::analyze()
 {
-    if (!initiated && root) delete(root->scene);
+    stats.invariant = stats.animated = 0;
+    states = 0;
+
+    ARRAY_FOREACH(p, assets) {
+        if ((*p)->type == LottieObject::Layer) _analyze(static_cast<LottieLayer*>(*p), this);
+    }
+    _analyze(root, this);
+
+    //the slot overriding may change the properties at any time
+    ARRAY_FOREACH(p, slots) {
+        if (auto layer = (*p)->context.layer) layer->invariant = false;
+    }
+
+    TVGLOG("LOTTIE", "info: invariant objects = %u, animated objects = %u", stats.invariant, stats.animated);
+}
 
+
+LottieComposition::~LottieComposition()
+{
     delete(root);
     tvg::free(version);
     tvg::free(name);
+    tvg::free(sharing.path);
 
     ARRAY_FOREACH(p, interpolators) {
         tvg::free((*p)->key);
+        tvg::free((*p)->table);
         tvg::free(*p);
     }
 
@@ -286,6 +286,7 @@ struct LottieObject
     virtual LottieProperty* property(uint16_t ix) { return nullptr; }
 
     unsigned long id = 0;      //unique id by name generated by djb2 encoding
+    uint32_t stateIdx = 0;     //index of the render state in the instances. see LottieRenderState
     Type type;
     bool hidden = false;       //remove?
 };
@@ -449,7 +450,7 @@ public:
 };
 
 
-struct LottieText : LottieObject, LottieRenderPooler<tvg::Shape>
+struct LottieText : LottieObject
 {
     struct AlignOption
     {
@@ -520,7 +521,7 @@ struct LottieTrimpath : LottieObject
 };
 
 
-struct LottieShape : LottieObject, LottieRenderPooler<tvg::Shape>
+struct LottieShape : LottieObject
 {
     bool clockwise = true;   //clockwise or counter-clockwise
 
@@ -866,9 +867,16 @@ struct LottieGradientStroke : LottieGradient, LottieStroke
 };
 
 
-struct LottieImage : LottieObject, LottieRenderPooler<tvg::Picture>
+struct LottieImage : LottieObject
 {
     LottieBitmap data;
+    tvg::Picture* picture = nullptr;   //the instances render its copies
+    Key key;
+
+    ~LottieImage()
+    {
+        if (picture) picture->unref();
+    }
 
     void override(LottieProperty* prop, bool shallow, bool release = false) override
     {
@@ -929,7 +937,7 @@ struct LottieOffsetPath : LottieObject
 };
 
 
-struct LottieGroup : LottieObject, LottieRenderPooler<tvg::Shape>
+struct LottieGroup : LottieObject
 {
     LottieGroup();
 
@@ -956,7 +964,6 @@ struct LottieGroup : LottieObject, LottieRenderPooler<tvg::Shape>
         return nullptr;
     }
 
-    Scene* scene = nullptr;
     Array<LottieObject*> children;
     BlendMethod blendMethod = BlendMethod::Normal;
 
@@ -965,6 +972,7 @@ struct LottieGroup : LottieObject, LottieRenderPooler<tvg::Shape>
     bool trimpath : 1;      //this group has a trimpath.
     bool visible : 1;       //this group has visible contents.
     bool allowMerge : 1;    //if this group is consisted of simple (transformed) shapes.
+    bool invariant : 1;     //the contents are constant over the time.
 };
 
 
@@ -988,8 +996,7 @@ struct LottieLayer : LottieGroup
     Array<LottieMask*> masks;
     Array<LottieEffect*> effects;
     LottieLayer* matteTarget = nullptr;
-
-    LottieRenderPooler<tvg::Shape> statical;  //static pooler for solid fill and clipper
+    tvg::Shape* statical = nullptr;   //solid fill or viewport clipper, the instances render its copies
 
     float timeStretch = 1.0f;
     float w = 0.0f, h = 0.0f;
@@ -1001,12 +1008,6 @@ struct LottieLayer : LottieGroup
     int16_t pix = -1;           //index of the parent layer.
     int16_t ix = -1;            //index of the current layer.
 
-    struct {
-        float frameNo = -1.0f;
-        Matrix matrix;
-        uint8_t opacity;
-    } cache;
-
     MaskMethod matteType = MaskMethod::None;
     Type type = Null;
     bool autoOrient = false;
@@ -1090,10 +1091,7 @@ struct LottieComposition
 {
     ~LottieComposition();
 
-    void clear()
-    {
-        if (root && root->scene) root->scene->remove();
-    }
+    void analyze();
 
     float duration() const
     {
@@ -1143,8 +1141,30 @@ struct LottieComposition
     Array<LottieFont*> fonts;
     Array<LottieSlot*> slots;
     Array<LottieMarker*> markers;
+    struct {
+        uint32_t invariant = 0;  //number of the objects constant over the time
+        uint32_t animated = 0;   //number of the objects changing over the time
+    } stats;
+    uint32_t states = 0;         //number of the render states required per instance
+    uint32_t cursors = 0;        //number of the keyframe cursors required per instance
+
+    //sharing among the animation instances. see LottieLoader
+    struct {
+        char* path = nullptr;    //source file path or the resource directory of the source data
+        uintptr_t data = 0;      //source data address
+        uint32_t size = 0;       //source data size
+        uint32_t refCnt = 1;
+        bool expressions;        //parsed with the expressions support
+    } sharing;
+
     bool expressions = false;
-    bool initiated = false;
+    bool followPath = false;     //text follows a mask path
+
+    //the instances can share the composition if none of them changes it.
+    bool shareable() const
+    {
+        return !expressions && !followPath && slots.empty();
+    }
 };
 
 #endif //_TVG_LOTTIE_MODEL_H_
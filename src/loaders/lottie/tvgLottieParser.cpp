@@ -387,6 +387,13 @@ LottieInterpolator* LottieParser::getInterpolator(const char* key, Point& in, Po
         if (!strncmp((*p)->key, key, sizeof(buf))) interpolator = *p;
     }
 
+    //the same easing under a different key
+    if (!interpolator) {
+        ARRAY_FOREACH(p, comp->interpolators) {
+            if ((*p)->inTangent == in && (*p)->outTangent == out) return *p;
+        }
+    }
+
     //new interpolator
     if (!interpolator) {
         interpolator = tvg::malloc<LottieInterpolator*>(sizeof(LottieInterpolator));
@@ -406,6 +413,8 @@ void LottieParser::parseKeyFrame(T& prop)
     auto& frame = prop.newFrame();
     auto interpolator = false;
 
+    if (prop.frames->count == 1) prop.cursor = comp->cursors++;
+
     enterObject();
 
     while (auto key = nextObjectKey()) {
@@ -1621,6 +1630,12 @@ void LottieParser::captureSlots(const char* key)
 {
     tvg::free(slots);
 
+    //precompiled lottie keeps the slots in a string
+    if (peekType() == kStringType) {
+        slots = getStringCopy();
+        return;
+    }
+
     // TODO: Replace with immediate parsing, once the slot spec is confirmed by the LAC
 
     auto begin = getPos();
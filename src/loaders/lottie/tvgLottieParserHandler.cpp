@@ -46,6 +46,20 @@
 #include "tvgLottieParserHandler.h"
 
 
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+static const char* _string(const uint8_t*& p, const uint8_t* end, const char* pool, uint32_t poolSize, SizeType& len)
+{
+    uint64_t offset, length;
+    if (!LottieBinary::read(p, end, offset) || !LottieBinary::read(p, end, length)) return nullptr;
+    if (offset + length >= poolSize || pool[offset + length] != '\0') return nullptr;
+    len = SizeType(length);
+    return pool + offset;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -146,11 +160,95 @@ void LookaheadParserHandler::getNull()
 
 bool LookaheadParserHandler::parseNext()
 {
-    if (reader.HasParseError() || !reader.IterativeParseNext<PARSE_FLAGS>(iss, *this)) {
-        Error();
+    if (binary.p) {
+        if (replay()) return true;
+    } else if (!reader.HasParseError() && reader.IterativeParseNext<PARSE_FLAGS>(iss, *this)) return true;
+
+    Error();
+    return false;
+}
+
+
+//dispatch the next precompiled token in the same manner of the json reader
+bool LookaheadParserHandler::replay()
+{
+    auto& p = binary.p;
+    auto end = binary.end;
+
+    //the document is completed
+    if (p == end) {
+        if (binary.depth == 0) return true;
+        state = kError;
         return false;
     }
-    return true;
+
+    uint64_t value;
+    SizeType len;
+
+    switch (*p++) {
+        case LottieBinary::Null: return Null();
+        case LottieBinary::False: return Bool(false);
+        case LottieBinary::True: return Bool(true);
+        case LottieBinary::Int: {
+            if (LottieBinary::read(p, end, value)) return Int(int(LottieBinary::unzigzag(value)));
+            break;
+        }
+        case LottieBinary::Uint: {
+            if (LottieBinary::read(p, end, value)) return Uint(unsigned(value));
+            break;
+        }
+        case LottieBinary::Int64: {
+            if (LottieBinary::read(p, end, value)) return Int64(LottieBinary::unzigzag(value));
+            break;
+        }
+        case LottieBinary::Uint64: {
+            if (LottieBinary::read(p, end, value)) return Uint64(value);
+            break;
+        }
+        case LottieBinary::Float: {
+            if (end - p < int(sizeof(float))) break;
+            auto f = LottieBinary::f32(p);
+            p += sizeof(float);
+            return Double(f);
+        }
+        case LottieBinary::Double: {
+            if (end - p < int(sizeof(double))) break;
+            auto d = LottieBinary::f64(p);
+            p += sizeof(double);
+            return Double(d);
+        }
+        case LottieBinary::String: {
+            if (auto str = _string(p, end, binary.pool, binary.poolSize, len)) return String(str, len, false);
+            break;
+        }
+        case LottieBinary::Key: {
+            if (auto str = _string(p, end, binary.pool, binary.poolSize, len)) return Key(str, len, false);
+            break;
+        }
+        case LottieBinary::StartObject: {
+            ++binary.depth;
+            return StartObject();
+        }
+        case LottieBinary::EndObject: {
+            if (binary.depth == 0) break;
+            --binary.depth;
+            return EndObject(0);
+        }
+        case LottieBinary::StartArray: {
+            ++binary.depth;
+            return StartArray();
+        }
+        case LottieBinary::EndArray: {
+            if (binary.depth == 0) break;
+            --binary.depth;
+            return EndArray(0);
+        }
+    }
+
+    //corrupted, no more advancement
+    p = end;
+    state = kError;
+    return false;
 }
 
 
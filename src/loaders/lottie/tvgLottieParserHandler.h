@@ -47,6 +47,7 @@
 
 #include "rapidjson/document.h"
 #include "tvgCommon.h"
+#include "tvgLottieBinary.h"
 
 
 using namespace rapidjson;
@@ -74,9 +75,25 @@ struct LookaheadParserHandler
     Reader                  reader;
     InsituStringStream      iss;
 
+    //precompiled tokens, replayed instead of the json parsing. see LottieBinary
+    struct {
+        const uint8_t* p = nullptr;
+        const uint8_t* end = nullptr;
+        const char* pool = nullptr;
+        uint32_t poolSize = 0;
+        uint32_t depth = 0;
+    } binary;
+
     LookaheadParserHandler(const char *str) : iss((char*)str)
     {
-        reader.IterativeParseInit();
+        //the loader verified the binary integrity already
+        if (!strncmp(str, LOTTIE_BINARY_MAGIC, LOTTIE_BINARY_MAGIC_LEN)) {
+            auto header = LottieBinary::header(str);
+            binary.p = LottieBinary::tokens(str);
+            binary.end = binary.p + header.tokens;
+            binary.pool = LottieBinary::pool(str, header);
+            binary.poolSize = header.pool;
+        } else reader.IterativeParseInit();
     }
 
     bool Null()
@@ -175,7 +192,9 @@ struct LookaheadParserHandler
     {
         TVGERR("LOTTIE", "Invalid JSON: unexpected or misaligned data fields.");
         state = kError;
-        reader.IterativeParseNext<PARSE_FLAGS>(iss, *this);   //something wrong but try advancement.
+        //something wrong but try advancement.
+        if (binary.p) replay();
+        else reader.IterativeParseNext<PARSE_FLAGS>(iss, *this);
     }
 
     bool Invalid()
@@ -193,6 +212,7 @@ struct LookaheadParserHandler
     bool getBool();
     void getNull();
     bool parseNext();
+    bool replay();
     const char* nextObjectKey();
     void skip();
     void skipOut(int depth);
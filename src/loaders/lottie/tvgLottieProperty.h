@@ -135,6 +135,8 @@ struct LottieExpression
     };
 
     char* code;
+    void* bytecode = nullptr;  //compiled code, built at the first evaluation
+    uint32_t generation = 0;   //the expressions engine the bytecode belongs to
     LottieComposition* comp;
     LottieLayer* layer;
     LottieObject* object;
@@ -165,6 +167,7 @@ struct LottieExpression
         ARRAY_FOREACH(p, writables) {
             tvg::free(p->var);
         }
+        LottieExpressions::release(bytecode, generation);
         tvg::free(code);
     }
 
@@ -183,6 +186,26 @@ struct LottieExpression
 };
 
 
+//The last looked up keyframes of the instance which the current thread is building.
+//The composition is shared among the instances, so the cursors can't stay in the properties. see LottieBuilder
+struct LottieCursors
+{
+    static thread_local Array<uint32_t>* current;
+
+    Array<uint32_t>* prev;
+
+    LottieCursors(Array<uint32_t>* cursors) : prev(current)
+    {
+        current = cursors;
+    }
+
+    ~LottieCursors()
+    {
+        current = prev;
+    }
+};
+
+
 //Property would have an either keyframes or single value.
 struct LottieProperty
 {
@@ -191,6 +214,7 @@ struct LottieProperty
     LottieExpression* exp = nullptr;
     Type type;
     uint8_t ix;  //property index
+    uint32_t cursor = UINT32_MAX;  //index of the keyframe cursor in the instances. see LottieCursors
 
     LottieProperty(Type type = Type::Invalid) : type(type) {}
     virtual ~LottieProperty() {}
@@ -199,10 +223,17 @@ struct LottieProperty
     virtual uint32_t nearest(float frameNo) = 0;
     virtual float frameNo(int32_t key) = 0;
 
+    //the value is constant over the time
+    bool invariant()
+    {
+        return !exp && frameCnt() <= 1;
+    }
+
     bool copy(LottieProperty* rhs, bool shallow)
     {
         type = rhs->type;
         ix = rhs->ix;
+        cursor = rhs->cursor;
 
         if (!rhs->exp) return false;
         if (shallow) {
@@ -261,6 +292,24 @@ uint32_t _bsearch(T* frames, float frameNo)
 }
 
 
+//the sequential playback mostly stays in the same or the next keyframe of the last lookup
+template<typename T>
+uint32_t _lookup(T* frames, float frameNo, uint32_t idx)
+{
+    auto cursors = LottieCursors::current;
+    if (!cursors || idx >= cursors->count) return _bsearch(frames, frameNo);
+
+    auto& cursor = cursors->data[idx];
+    auto key = cursor;
+    if (key + 1 < frames->count && frames->data[key].no <= frameNo) {
+        if (frameNo < frames->data[key + 1].no) return key;
+        if (key + 2 < frames->count && frameNo < frames->data[key + 2].no) return ++cursor;
+    }
+    cursor = _bsearch(frames, frameNo);
+    return cursor;
+}
+
+
 template<typename T>
 uint32_t _nearest(T* frames, float frameNo)
 {
@@ -396,7 +445,7 @@ struct LottieGenericProperty : LottieProperty
         if (frames->count == 1 || frameNo <= frames->first().no) return frames->first().value;
         if (frameNo >= frames->last().no) return frames->last().value;
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _lookup(frames, frameNo, cursor);
         if (tvg::equal(frame->no, frameNo)) return frame->value;
         return frame->interpolate(frame + 1, frameNo);
     }
@@ -435,7 +484,7 @@ struct LottieGenericProperty : LottieProperty
             return frame->angle(frame + 1, frames->last().no);
         }
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _lookup(frames, frameNo, cursor);
         return frame->angle(frame + 1, frameNo);
     }
 
@@ -529,7 +578,7 @@ struct LottiePathSet : LottieProperty
         else if (frames->count == 1 || frameNo <= frames->first().no) path = &frames->first().value;
         else if (frameNo >= frames->last().no) path = &frames->last().value;
         else {
-            frame = frames->data + _bsearch(frames, frameNo);
+            frame = frames->data + _lookup(frames, frameNo, cursor);
             if (tvg::equal(frame->no, frameNo)) path = &frame->value;
             else if (frame->value.ptsCnt != (frame + 1)->value.ptsCnt) {
                 path = &frame->value;
@@ -718,7 +767,7 @@ struct LottieColorStop : LottieProperty
 
     Result tweening(float frameNo, Fill* fill, Tween& tween, LottieExpressions* exps)
     {
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _lookup(frames, frameNo, cursor);
         if (tvg::equal(frame->no, frameNo)) return fill->colorStops(frame->value.data, count);
 
         //from
@@ -764,7 +813,7 @@ struct LottieColorStop : LottieProperty
 
         if (frameNo >= frames->last().no) return fill->colorStops(frames->last().value.data, count);
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _lookup(frames, frameNo, cursor);
         if (tvg::equal(frame->no, frameNo)) return fill->colorStops(frame->value.data, count);
 
         //interpolate
@@ -904,7 +953,7 @@ struct LottieTextDoc : LottieProperty
         if (frames->count == 1 || frameNo <= frames->first().no) return frames->first().value;
         if (frameNo >= frames->last().no) return frames->last().value;
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _lookup(frames, frameNo, cursor);
         return frame->value;
     }
 
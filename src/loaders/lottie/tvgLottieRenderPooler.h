@@ -34,13 +34,19 @@ struct LottieRenderPooler
     Array<T*> pooler;
 
     ~LottieRenderPooler()
+    {
+        clear();
+    }
+
+    void clear()
     {
         ARRAY_FOREACH(p, pooler) {
             (*p)->unref();
         }
+        pooler.clear();
     }
 
-    T* pooling(bool copy = false)
+    T* pooling(const T* origin = nullptr)
     {
         //return available one.
         ARRAY_FOREACH(p, pooler) {
@@ -48,7 +54,7 @@ struct LottieRenderPooler
         }
 
         //no empty, generate a new one.
-        auto p = copy ? static_cast<T*>(pooler[0]->duplicate()) : T::gen();
+        auto p = origin ? static_cast<T*>(origin->duplicate()) : T::gen();
         p->ref();
         pooler.push(p);
         return p;
@@ -56,4 +62,31 @@ struct LottieRenderPooler
 };
 
 
+//The render data of a composition object. The composition can be shared among the animation instances,
+//while each of them keeps its own states which are indexed by LottieObject::stateIdx.
+struct LottieRenderState
+{
+    LottieRenderPooler<tvg::Shape> shapes;
+    Scene* scene = nullptr;
+    Scene* retained = nullptr;                    //scene kept alive across the frames
+
+    //layer only
+    Scene* wrapper = nullptr;                     //retained intermediate scene for masking
+    LottieRenderPooler<tvg::Shape> statical;      //copies of the solid fill or the viewport clipper
+    LottieRenderPooler<tvg::Picture> images;      //copies of the image
+
+    struct {
+        float frameNo = -1.0f;
+        Matrix matrix;
+        uint8_t opacity;
+    } cache;
+
+    ~LottieRenderState()
+    {
+        if (retained) retained->unref();
+        if (wrapper) wrapper->unref();
+    }
+};
+
+
 #endif //_TVG_LOTTIE_RENDER_POOLER_H_
\ No newline at end of file
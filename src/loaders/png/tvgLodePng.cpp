@@ -1936,7 +1936,30 @@ static void getPixelColorRGBA16(unsigned short* r, unsigned short* g, unsigned s
   For 16-bit per channel colors, uses big endian format like PNG does.
   Return value is LodePNG error code
 */
-static unsigned lodepng_convert(unsigned char* out, const unsigned char* in, const LodePNGColorMode* mode_out, const LodePNGColorMode* mode_in, unsigned w, unsigned h)
+/* Applies the requested channel order and premultiplication to 8-bit RGBA pixels.
+   The premultiplication is bit-exact with the one of the software raster engine.*/
+static void finalizeRGBA8(unsigned char* buffer, size_t numpixels, const LodePNGDecoderSettings* settings)
+{
+    if (!settings || (!settings->premultiply && !settings->swap_rb)) return;
+
+    for (size_t i = 0; i != numpixels; ++i, buffer += 4) {
+        if (settings->swap_rb) {
+            unsigned char t = buffer[0];
+            buffer[0] = buffer[2];
+            buffer[2] = t;
+        }
+        if (settings->premultiply) {
+            unsigned a = buffer[3];
+            if (a == 255) continue;
+            buffer[0] = (unsigned char)((buffer[0] * a) >> 8);
+            buffer[1] = (unsigned char)((buffer[1] * a) >> 8);
+            buffer[2] = (unsigned char)((buffer[2] * a) >> 8);
+        }
+    }
+}
+
+
+static unsigned lodepng_convert(unsigned char* out, const unsigned char* in, const LodePNGColorMode* mode_out, const LodePNGColorMode* mode_in, unsigned w, unsigned h, const LodePNGDecoderSettings* settings)
 {
     size_t i;
     ColorTree tree;
@@ -1989,7 +2012,15 @@ static unsigned lodepng_convert(unsigned char* out, const unsigned char* in, con
                 rgba16ToPixel(out, i, mode_out, r, g, b, a);
             }
         } else if (mode_out->bitdepth == 8 && mode_out->colortype == LCT_RGBA) {
-            getPixelColorsRGBA8(out, numpixels, in, mode_in);
+            /* convert in chunks so that the finalization hits the pixels while they are still in the cache.
+               the chunk is a multiple of 8 pixels, so every chunk starts at a byte of the packed input. */
+            const size_t chunk = 1024;
+            size_t bpp = lodepng_get_bpp_lct(mode_in->colortype, mode_in->bitdepth);
+            for (i = 0; i < numpixels; i += chunk) {
+                size_t n = (numpixels - i < chunk) ? (numpixels - i) : chunk;
+                getPixelColorsRGBA8(&out[i * 4], n, &in[i * bpp / 8], mode_in);
+                finalizeRGBA8(&out[i * 4], n, settings);
+            }
         } else if(mode_out->bitdepth == 8 && mode_out->colortype == LCT_RGB) {
             getPixelColorsRGB8(out, numpixels, in, mode_in);
         } else {
@@ -2170,13 +2201,14 @@ static unsigned unfilterScanline(unsigned char* recon, const unsigned char* scan
 }
 
 
-static unsigned unfilter(unsigned char* out, const unsigned char* in, unsigned w, unsigned h, unsigned bpp)
+static unsigned unfilter(unsigned char* out, const unsigned char* in, unsigned w, unsigned h, unsigned bpp, const LodePNGDecoderSettings* finalize)
 {
     /* For PNG filter method 0
        this function unfilters a single image (e.g. without interlacing this is called once, with Adam7 seven times)
        out must have enough bytes allocated already, in must have the scanlines + 1 filtertype byte per scanline
        w and h are image dimensions or dimensions of reduced image, bpp is bits per pixel
-       in and out are allowed to be the same memory address (but aren't the same size since in has the extra filter bytes) */
+       in and out are allowed to be the same memory address (but aren't the same size since in has the extra filter bytes)
+       finalize, if given, is applied to 8-bit RGBA scanlines as soon as the next scanline doesn't refer to them anymore */
 
     unsigned y;
     unsigned char* prevline = 0;
@@ -2191,8 +2223,10 @@ static unsigned unfilter(unsigned char* out, const unsigned char* in, unsigned w
         size_t inindex = (1 + linebytes) * y; /* the extra filterbyte added to each row */
         unsigned char filterType = in[inindex];
         CERROR_TRY_RETURN(unfilterScanline(&out[outindex], &in[inindex + 1], prevline, bytewidth, filterType, linebytes));
+        if (finalize && prevline) finalizeRGBA8(prevline, w, finalize);
         prevline = &out[outindex];
     }
+    if (finalize && prevline) finalizeRGBA8(prevline, w, finalize);
 
     return 0;
 }
@@ -2273,23 +2307,25 @@ static void removePaddingBits(unsigned char* out, const unsigned char* in, size_
 /* out must be buffer big enough to contain full image, and in must contain the full decompressed data from
    the IDAT chunks (with filter index bytes and possible padding bits)
    return value is error */
-static unsigned postProcessScanlines(unsigned char* out, unsigned char* in, unsigned w, unsigned h, const LodePNGInfo* info_png)
+static unsigned postProcessScanlines(unsigned char* out, unsigned char* in, unsigned w, unsigned h, const LodePNGInfo* info_png, const LodePNGDecoderSettings* finalize)
 {
     /* This function converts the filtered-padded-interlaced data into pure 2D image buffer with the PNG's colortype.
        Steps:
        *) if no Adam7: 1) unfilter 2) remove padding bits (= possible extra bits per scanline if bpp < 8)
        *) if adam7: 1) 7x unfilter 2) 7x remove padding bits 3) Adam7_deinterlace
-       NOTE: the in buffer will be overwritten with intermediate data! */
+       NOTE: the in buffer will be overwritten with intermediate data!
+       finalize is only applicable to the 8-bit RGBA images, it's ignored otherwise. */
     unsigned bpp = lodepng_get_bpp_lct(info_png->color.colortype, info_png->color.bitdepth);
     if (bpp == 0) return 31; /* error: invalid colortype */
+    if (info_png->color.colortype != LCT_RGBA || info_png->color.bitdepth != 8) finalize = 0;
 
     if (info_png->interlace_method == 0) {
         if (bpp < 8 && w * bpp != ((w * bpp + 7u) / 8u) * 8u) {
-            CERROR_TRY_RETURN(unfilter(in, in, w, h, bpp));
+            CERROR_TRY_RETURN(unfilter(in, in, w, h, bpp, 0));
             removePaddingBits(out, in, w * bpp, ((w * bpp + 7u) / 8u) * 8u, h);
         }
         /* we can immediately filter into the out buffer, no other steps needed */
-        else CERROR_TRY_RETURN(unfilter(out, in, w, h, bpp));
+        else CERROR_TRY_RETURN(unfilter(out, in, w, h, bpp, finalize));
     } else /* interlace_method is 1 (Adam7) */ {
         unsigned passw[7], passh[7]; size_t filter_passstart[8], padded_passstart[8], passstart[8];
         unsigned i;
@@ -2297,7 +2333,7 @@ static unsigned postProcessScanlines(unsigned char* out, unsigned char* in, unsi
         Adam7_getpassvalues(passw, passh, filter_passstart, padded_passstart, passstart, w, h, bpp);
 
         for (i = 0; i != 7; ++i) {
-            CERROR_TRY_RETURN(unfilter(&in[padded_passstart[i]], &in[filter_passstart[i]], passw[i], passh[i], bpp));
+            CERROR_TRY_RETURN(unfilter(&in[padded_passstart[i]], &in[filter_passstart[i]], passw[i], passh[i], bpp, finalize));
             /* TODO: possible efficiency improvement: if in this reduced image the bits fit nicely in 1 scanline,
                move bytes instead of bits or move not at all */
             if (bpp < 8) {
@@ -2491,7 +2527,9 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h, LodePNG
     }
     if (!state->error) {
         lodepng_memset(*out, 0, outsize);
-        state->error = postProcessScanlines(*out, scanlines, *w, *h, &state->info_png);
+        /* the 8-bit RGBA output is finalized while unfiltering unless a color conversion follows */
+        auto direct = !state->decoder.color_convert || lodepng_color_mode_equal(&state->info_raw, &state->info_png.color);
+        state->error = postProcessScanlines(*out, scanlines, *w, *h, &state->info_png, direct ? &state->decoder : 0);
     }
     tvg::free(scanlines);
 }
@@ -2503,6 +2541,8 @@ static void lodepng_decoder_settings_init(LodePNGDecoderSettings* settings)
     settings->ignore_crc = 0;
     settings->ignore_critical = 0;
     settings->ignore_end = 0;
+    settings->premultiply = 0;
+    settings->swap_rb = 0;
     lodepng_decompress_settings_init(&settings->zlibsettings);
 }
 
@@ -2605,7 +2645,7 @@ unsigned lodepng_decode(unsigned char** out, unsigned* w, unsigned* h, LodePNGSt
         if (!(*out)) {
             state->error = 83; /*alloc fail*/
         }
-        else state->error = lodepng_convert(*out, data, &state->info_raw, &state->info_png.color, *w, *h);
+        else state->error = lodepng_convert(*out, data, &state->info_raw, &state->info_png.color, *w, *h, &state->decoder);
         tvg::free(data);
     }
     return state->error;
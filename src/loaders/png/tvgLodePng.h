@@ -155,6 +155,10 @@ struct LodePNGDecoderSettings
        in string keys, etc... */
 
     unsigned color_convert; /*whether to convert the PNG to the color type you want. Default: yes*/
+
+    /*applied to the 8-bit RGBA output while the scanlines are decoded, so no extra pass over the image is needed*/
+    unsigned premultiply; /*multiply the color channels by the alpha channel. Default: no*/
+    unsigned swap_rb; /*swap the red and blue channels (BGRA output). Default: no*/
 };
 
 /*The settings, state and information for extended encoding and decoding.*/
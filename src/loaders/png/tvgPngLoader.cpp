@@ -36,6 +36,10 @@ void PngLoader::run(unsigned tid)
 
     state.info_raw.colortype = LCT_RGBA;   //request this image format
 
+    //decode straight into the premultiplied target format, no more conversion passes by the renderer
+    state.decoder.premultiply = 1;
+    state.decoder.swap_rb = (surface.cs == ColorSpace::ARGB8888 || surface.cs == ColorSpace::ARGB8888S);
+
     if (lodepng_decode(&surface.buf8, &width, &height, &state, data, size)) {
         TVGERR("PNG", "Failed to decode image");
     }
@@ -44,8 +48,9 @@ void PngLoader::run(unsigned tid)
     surface.stride = width;
     surface.w = width;
     surface.h = height;
-    surface.cs = ColorSpace::ABGR8888S;
+    surface.cs = state.decoder.swap_rb ? ColorSpace::ARGB8888 : ColorSpace::ABGR8888;
     surface.channelSize = sizeof(uint32_t);
+    surface.premultiplied = true;
 }
 
 
@@ -138,6 +143,8 @@ bool PngLoader::read()
 
     if (!LoadModule::read()) return true;
 
+    surface.cs = ImageLoader::cs;
+
     TaskScheduler::request(this);
 
     return true;
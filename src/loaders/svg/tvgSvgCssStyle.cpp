@@ -21,6 +21,7 @@
  */
 
 #include "tvgStr.h"
+#include "tvgCompressor.h"
 #include "tvgSvgCssStyle.h"
 
 /************************************************************************/
@@ -178,6 +179,13 @@ static void _copyStyle(SvgStyleProperty* to, const SvgStyleProperty* from)
 }
 
 
+//selectors are identified by the name and the element type (tag.name, .name or tag)
+static unsigned long _key(const char* title, SvgNodeType type)
+{
+    return djb2Encode(title) * 31 + static_cast<unsigned long>(type);
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -206,54 +214,52 @@ void cssCopyStyleAttr(SvgNode* to, const SvgNode* from)
 }
 
 
-SvgNode* cssFindStyleNode(const SvgNode* style, const char* title, SvgNodeType type)
+void cssIndexStyleNode(SvgIndex<SvgNode>& css, SvgNode* style)
 {
-    if (!style) return nullptr;
+    css.push(_key(style->id, style->type), style);
+}
 
-    ARRAY_FOREACH(p, style->child) {
-        if ((*p)->type == type) {
-            if ((!title && !(*p)->id) || (title && (*p)->id && !strcmp((*p)->id, title))) return *p;
-        }
-    }
-    return nullptr;
+
+SvgNode* cssFindStyleNode(const SvgIndex<SvgNode>& css, const char* title, SvgNodeType type)
+{
+    return css.find(_key(title, type), [&](SvgNode* style) {
+        return style->type == type && ((!title && !style->id) || (title && style->id && !strcmp(style->id, title)));
+    });
 }
 
 
-SvgNode* cssFindStyleNode(const SvgNode* style, const char* title)
+SvgNode* cssFindStyleNode(const SvgIndex<SvgNode>& css, const char* title)
 {
-    if (!style || !title) return nullptr;
+    if (!title) return nullptr;
 
-    ARRAY_FOREACH(p, style->child) {
-        if ((*p)->type == SvgNodeType::CssStyle) {
-            if ((*p)->id && !strcmp((*p)->id, title)) return *p;
-        }
-    }
-    return nullptr;
+    return css.find(_key(title, SvgNodeType::CssStyle), [&](SvgNode* style) {
+        return style->type == SvgNodeType::CssStyle && style->id && !strcmp(style->id, title);
+    });
 }
 
 
-void cssUpdateStyle(SvgNode* doc, SvgNode* style)
+void cssUpdateStyle(SvgNode* doc, const SvgIndex<SvgNode>& css)
 {
     if (doc->child.count > 0) {
         ARRAY_FOREACH(p, doc->child) {
-            if (auto cssNode = cssFindStyleNode(style, nullptr, (*p)->type)) {
+            if (auto cssNode = cssFindStyleNode(css, nullptr, (*p)->type)) {
                 cssCopyStyleAttr(*p, cssNode);
             }
-            cssUpdateStyle(*p, style);
+            cssUpdateStyle(*p, css);
         }
     }
 }
 
 
-void cssApplyStyleToPostponeds(Array<SvgNodeIdPair>& postponeds, SvgNode* style)
+void cssApplyStyleToPostponeds(Array<SvgNodeIdPair>& postponeds, const SvgIndex<SvgNode>& css)
 {
     ARRAY_FOREACH(p, postponeds) {
         auto nodeIdPair = *p;
         //css styling: tag.name has higher priority than .name
-        if (auto cssNode = cssFindStyleNode(style, nodeIdPair.id, nodeIdPair.node->type)) {
+        if (auto cssNode = cssFindStyleNode(css, nodeIdPair.id, nodeIdPair.node->type)) {
             cssCopyStyleAttr(nodeIdPair.node, cssNode);
         }
-        if (auto cssNode = cssFindStyleNode(style, nodeIdPair.id)) {
+        if (auto cssNode = cssFindStyleNode(css, nodeIdPair.id)) {
             cssCopyStyleAttr(nodeIdPair.node, cssNode);
         }
     }
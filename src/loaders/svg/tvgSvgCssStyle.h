@@ -26,9 +26,10 @@
 #include "tvgSvgLoaderCommon.h"
 
 void cssCopyStyleAttr(SvgNode* to, const SvgNode* from);
-SvgNode* cssFindStyleNode(const SvgNode* style, const char* title, SvgNodeType type);
-SvgNode* cssFindStyleNode(const SvgNode* style, const char* title);
-void cssUpdateStyle(SvgNode* doc, SvgNode* style);
-void cssApplyStyleToPostponeds(Array<SvgNodeIdPair>& postponeds, SvgNode* style);
+void cssIndexStyleNode(SvgIndex<SvgNode>& css, SvgNode* style);
+SvgNode* cssFindStyleNode(const SvgIndex<SvgNode>& css, const char* title, SvgNodeType type);
+SvgNode* cssFindStyleNode(const SvgIndex<SvgNode>& css, const char* title);
+void cssUpdateStyle(SvgNode* doc, const SvgIndex<SvgNode>& css);
+void cssApplyStyleToPostponeds(Array<SvgNodeIdPair>& postponeds, const SvgIndex<SvgNode>& css);
 
 #endif //_TVG_SVG_CSS_STYLE_H_
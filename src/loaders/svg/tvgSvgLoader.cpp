@@ -20,9 +20,9 @@
  * SOFTWARE.
  */
 
-#include <fstream>
 #include "tvgStr.h"
 #include "tvgMath.h"
+#include "tvgCompressor.h"
 #include "tvgLoader.h"
 #include "tvgXmlParser.h"
 #include "tvgSvgLoader.h"
@@ -1148,11 +1148,11 @@ static void _handleCssClassAttr(SvgLoaderData* loader, SvgNode* node, const char
     bool cssClassFound = false;
 
     //css styling: tag.name has higher priority than .name
-    if (auto cssNode = cssFindStyleNode(loader->cssStyle, *cssClass, node->type)) {
+    if (auto cssNode = cssFindStyleNode(loader->css, *cssClass, node->type)) {
         cssClassFound = true;
         cssCopyStyleAttr(node, cssNode);
     }
-    if (auto cssNode = cssFindStyleNode(loader->cssStyle, *cssClass)) {
+    if (auto cssNode = cssFindStyleNode(loader->css, *cssClass)) {
         cssClassFound = true;
         cssCopyStyleAttr(node, cssNode);
     }
@@ -2127,18 +2127,22 @@ static SvgNode* _getDefsNode(SvgNode* node)
 }
 
 
-static SvgNode* _findNodeById(SvgNode *node, const char* id)
+//the nodes are indexed in the creation order, so the earliest one is the first one in the tree order
+static SvgNode* _findNodeById(SvgLoaderData* loader, SvgNode* root, const char* id)
 {
-    if (!node) return nullptr;
+    if (!root || !id) return nullptr;
 
-    if (node->id && STR_AS(node->id, id)) return node;
+    return loader->ids.find(djb2Encode(id), [&](SvgNode* node) {
+        if (!node->id || !STR_AS(node->id, id)) return false;
+        while (node && node != root) node = node->parent;
+        return node == root;
+    });
+}
 
-    if (node->child.count > 0) {
-        ARRAY_FOREACH(p, node->child) {
-            if (auto result = _findNodeById(*p, id)) return result;
-        }
-    }
-    return nullptr;
+
+static void _indexNode(SvgLoaderData* loader, SvgNode* node)
+{
+    if (node && node->id) loader->ids.push(djb2Encode(node->id), node);
 }
 
 
@@ -2193,7 +2197,7 @@ static bool _attrParseUseNode(void* data, const char* key, const char* value)
     if (STR_AS(key, "href") || STR_AS(key, "xlink:href")) {
         id = _idFromHref(value);
         defs = _getDefsNode(node);
-        nodeFrom = _findNodeById(defs, id);
+        nodeFrom = _findNodeById(loader, defs, id);
         if (nodeFrom) {
             if (!_findParentById(node, id, loader->doc)) {
                 _cloneNode(nodeFrom, node, 0);
@@ -3230,7 +3234,7 @@ static void _styleCopy(SvgStyleProperty* to, const SvgStyleProperty* from)
 }
 
 
-static void _copyAttr(SvgNode* to, const SvgNode* from)
+static void _copyAttr(SvgNode* to, SvgNode* from)
 {
     //Copy matrix attribute
     if (from->transform) {
@@ -3272,9 +3276,11 @@ static void _copyAttr(SvgNode* to, const SvgNode* from)
             break;
         }
         case SvgNodeType::Path: {
+            //the path data is immutable, refer the origin's one instead of the copy
             if (from->node.path.path) {
                 tvg::free(to->node.path.path);
-                to->node.path.path = duplicate(from->node.path.path);
+                to->node.path.path = from->node.path.path;
+                to->node.path.origin = from->node.path.origin ? from->node.path.origin : from;
             }
             break;
         }
@@ -3356,13 +3362,13 @@ static void _cloneNode(SvgNode* from, SvgNode* parent, int depth)
 }
 
 
-static void _clonePostponedNodes(Array<SvgNodeIdPair>* cloneNodes, SvgNode* doc)
+static void _clonePostponedNodes(SvgLoaderData* loader, Array<SvgNodeIdPair>* cloneNodes, SvgNode* doc)
 {
     ARRAY_FOREACH(p, *cloneNodes) {
         auto nodeIdPair = *p;
         auto defs = _getDefsNode(nodeIdPair.node);
-        auto nodeFrom = _findNodeById(defs, nodeIdPair.id);
-        if (!nodeFrom) nodeFrom = _findNodeById(doc, nodeIdPair.id);
+        auto nodeFrom = _findNodeById(loader, defs, nodeIdPair.id);
+        if (!nodeFrom) nodeFrom = _findNodeById(loader, doc, nodeIdPair.id);
         if (!_findParentById(nodeIdPair.node, nodeIdPair.id, doc)) {
             _cloneNode(nodeFrom, nodeIdPair.node, 0);
             if (nodeFrom && nodeFrom->type == SvgNodeType::Symbol && nodeIdPair.node->type == SvgNodeType::Use) {
@@ -3477,6 +3483,7 @@ static void _svgLoaderParserXmlOpen(SvgLoaderData* loader, const char* content,
         }
 
         if (!node) return;
+        _indexNode(loader, node);
         if (node->type != SvgNodeType::Defs || !empty) {
             loader->stack.push(node);
         }
@@ -3484,6 +3491,7 @@ static void _svgLoaderParserXmlOpen(SvgLoaderData* loader, const char* content,
         if (loader->stack.count > 0) parent = loader->stack.last();
         else parent = loader->doc;
         node = method(loader, parent, attrs, attrsLength, xmlParseAttributes);
+        _indexNode(loader, node);
         if (node && !empty) {
             if (STR_AS(tagName, "text")) loader->openedTag = OpenedTagType::Text;
             auto defs = _createDefsNode(loader, nullptr, nullptr, 0, nullptr);
@@ -3543,6 +3551,7 @@ static void _svgLoaderParserXmlCssStyle(SvgLoaderData* loader, const char* conte
     SvgNode *node = nullptr;
 
     while (auto next = xmlParseCSSAttribute(content, length, &tag, &name, &attrs, &attrsLength)) {
+        node = nullptr;
         if ((method = _findGroupFactory(tag))) {
             if ((node = method(loader, loader->cssStyle, attrs, attrsLength, xmlParseW3CAttribute))) node->id = _copyId(name);
         } else if ((method = _findGraphicsFactory(tag))) {
@@ -3559,6 +3568,8 @@ static void _svgLoaderParserXmlCssStyle(SvgLoaderData* loader, const char* conte
             TVGLOG("SVG", "Unsupported elements used in the internal CSS style sheets [Elements: %s]", tag);
         }
 
+        if (node) cssIndexStyleNode(loader->css, node);
+
         length -= next - content;
         content = next;
 
@@ -3618,24 +3629,18 @@ static void _updateStyle(SvgNode* node, SvgStyleProperty* parentStyle)
 }
 
 
-static void _updateGradient(SvgLoaderData* loader, SvgNode* node, Array<SvgStyleGradient*>* gradients)
+static void _updateGradient(SvgLoaderData* loader, SvgNode* node, const SvgIndex<SvgStyleGradient>& gradients)
 {
-    auto duplicate = [&](SvgLoaderData* loader, Array<SvgStyleGradient*>* gradients, const char* id) -> SvgStyleGradient* {
+    auto find = [&](const char* id) -> SvgStyleGradient* {
+        return gradients.find(djb2Encode(id), [&](SvgStyleGradient* gradient) { return STR_AS(gradient->id, id); });
+    };
+
+    auto duplicate = [&](const char* id) -> SvgStyleGradient* {
         SvgStyleGradient* result = nullptr;
 
-        ARRAY_FOREACH(p, *gradients) {
-            if ((*p)->id && STR_AS((*p)->id, id)) {
-                result = _cloneGradient(*p);
-                break;
-            }
-        }
+        if (auto gradient = find(id)) result = _cloneGradient(gradient);
         if (result && result->ref) {
-            ARRAY_FOREACH(p, *gradients) {
-                if ((*p)->id && STR_AS((*p)->id, result->ref)) {
-                    _inheritGradient(loader, result, *p);
-                    break;
-                }
-            }
+            if (auto gradient = find(result->ref)) _inheritGradient(loader, result, gradient);
         }
         return result;
     };
@@ -3646,7 +3651,7 @@ static void _updateGradient(SvgLoaderData* loader, SvgNode* node, Array<SvgStyle
         }
     } else {
         if (node->style->fill.paint.url) {
-            auto newGrad = duplicate(loader, gradients, node->style->fill.paint.url);
+            auto newGrad = duplicate(node->style->fill.paint.url);
             if (newGrad) {
                 if (node->style->fill.paint.gradient) {
                     node->style->fill.paint.gradient->clear();
@@ -3656,7 +3661,7 @@ static void _updateGradient(SvgLoaderData* loader, SvgNode* node, Array<SvgStyle
             }
         }
         if (node->style->stroke.paint.url) {
-            auto newGrad = duplicate(loader, gradients, node->style->stroke.paint.url);
+            auto newGrad = duplicate(node->style->stroke.paint.url);
             if (newGrad) {
                 if (node->style->stroke.paint.gradient) {
                     node->style->stroke.paint.gradient->clear();
@@ -3669,31 +3674,41 @@ static void _updateGradient(SvgLoaderData* loader, SvgNode* node, Array<SvgStyle
 }
 
 
-static void _updateComposite(SvgNode* node, SvgNode* root)
+static void _updateGradient(SvgLoaderData* loader, SvgNode* doc, Array<SvgStyleGradient*>& gradients)
+{
+    SvgIndex<SvgStyleGradient> index;
+    ARRAY_FOREACH(p, gradients) {
+        if ((*p)->id) index.push(djb2Encode((*p)->id), *p);
+    }
+    _updateGradient(loader, doc, index);
+}
+
+
+static void _updateComposite(SvgLoaderData* loader, SvgNode* node, SvgNode* root)
 {
     if (node->style->clipPath.url && !node->style->clipPath.node) {
-        SvgNode* findResult = _findNodeById(root, node->style->clipPath.url);
+        SvgNode* findResult = _findNodeById(loader, root, node->style->clipPath.url);
         if (findResult) node->style->clipPath.node = findResult;
     }
     if (node->style->mask.url && !node->style->mask.node) {
-        SvgNode* findResult = _findNodeById(root, node->style->mask.url);
+        SvgNode* findResult = _findNodeById(loader, root, node->style->mask.url);
         if (findResult) node->style->mask.node = findResult;
     }
     if (node->child.count > 0) {
         ARRAY_FOREACH(p, node->child) {
-            _updateComposite(*p, root);
+            _updateComposite(loader, *p, root);
         }
     }
 }
 
 
-static void _updateFilter(SvgNode* node, SvgNode* root)
+static void _updateFilter(SvgLoaderData* loader, SvgNode* node, SvgNode* root)
 {
     if (node->style->filter.url && !node->style->filter.node) {
-        node->style->filter.node = _findNodeById(root, node->style->filter.url);
+        node->style->filter.node = _findNodeById(loader, root, node->style->filter.url);
     }
     ARRAY_FOREACH(child, node->child) {
-        _updateFilter(*child, root);
+        _updateFilter(loader, *child, root);
     }
 }
 
@@ -3735,7 +3750,9 @@ static void _freeNode(SvgNode* node)
     _freeNodeStyle(node->style);
     switch (node->type) {
          case SvgNodeType::Path: {
+             if (node->node.path.origin) break;
              tvg::free(node->node.path.path);
+             delete(node->node.path.parsed);
              break;
          }
          case SvgNodeType::Polygon: {
@@ -3806,6 +3823,7 @@ static bool _svgLoaderParserForValidCheckXmlOpen(SvgLoaderData* loader, const ch
         if (!loader->doc) {
             if (!STR_AS(tagName, "svg")) return true; //Not a valid svg document
             node = method(loader, nullptr, attrs, attrsLength, xmlParseAttributes);
+            _indexNode(loader, node);
             loader->doc = node;
             loader->stack.push(node);
             return false;
@@ -3844,6 +3862,8 @@ void SvgLoader::clear(bool all)
     _freeNode(loaderData.doc);
     loaderData.doc = nullptr;
     loaderData.stack.reset();
+    loaderData.ids.reset();
+    loaderData.css.reset();
 
     if (!all) return;
 
@@ -3858,6 +3878,7 @@ void SvgLoader::clear(bool all)
     loaderData.fonts.reset();
 
     if (copy) tvg::free((char*)content);
+    file.unmap();
 
     delete(root);
     root = nullptr;
@@ -3898,22 +3919,22 @@ void SvgLoader::run(unsigned tid)
     if (loaderData.doc) {
         auto defs = loaderData.doc->node.doc.defs;
 
-        if (loaderData.nodesToStyle.count > 0) cssApplyStyleToPostponeds(loaderData.nodesToStyle, loaderData.cssStyle);
-        if (loaderData.cssStyle) cssUpdateStyle(loaderData.doc, loaderData.cssStyle);
+        if (loaderData.nodesToStyle.count > 0) cssApplyStyleToPostponeds(loaderData.nodesToStyle, loaderData.css);
+        if (loaderData.cssStyle) cssUpdateStyle(loaderData.doc, loaderData.css);
 
-        if (loaderData.cloneNodes.count > 0) _clonePostponedNodes(&loaderData.cloneNodes, loaderData.doc);
+        if (loaderData.cloneNodes.count > 0) _clonePostponedNodes(&loaderData, &loaderData.cloneNodes, loaderData.doc);
 
-        _updateComposite(loaderData.doc, loaderData.doc);
-        if (defs) _updateComposite(loaderData.doc, defs);
+        _updateComposite(&loaderData, loaderData.doc, loaderData.doc);
+        if (defs) _updateComposite(&loaderData, loaderData.doc, defs);
 
-        _updateFilter(loaderData.doc, loaderData.doc);
-        if (defs) _updateFilter(loaderData.doc, defs);
+        _updateFilter(&loaderData, loaderData.doc, loaderData.doc);
+        if (defs) _updateFilter(&loaderData, loaderData.doc, defs);
 
         _updateStyle(loaderData.doc, nullptr);
         if (defs) _updateStyle(defs, nullptr);
 
-        if (loaderData.gradients.count > 0) _updateGradient(&loaderData, loaderData.doc, &loaderData.gradients);
-        if (defs) _updateGradient(&loaderData, loaderData.doc, &defs->node.defs.gradients);
+        if (loaderData.gradients.count > 0) _updateGradient(&loaderData, loaderData.doc, loaderData.gradients);
+        if (defs) _updateGradient(&loaderData, loaderData.doc, defs->node.defs.gradients);
 
         root = svgSceneBuild(loaderData, vbox, w, h, align, meetOrSlice, svgPath, viewFlag);
 
@@ -4024,19 +4045,12 @@ bool SvgLoader::open(const char* path)
 #ifdef THORVG_FILE_IO_SUPPORT
     clear();
 
-    ifstream f;
-    f.open(path);
-
-    if (!f.is_open()) return false;
+    //the xml is parsed without modifying the content
+    if (!file.map(path)) return false;
 
     svgPath = path;
-    getline(f, filePath, '\0');
-    f.close();
-
-    if (filePath.empty()) return false;
-
-    content = (char*)filePath.c_str();
-    size = filePath.size();
+    content = file.data;
+    size = strnlen(content, file.size);
 
     return header();
 #else
@@ -23,13 +23,14 @@
 #ifndef _TVG_SVG_LOADER_H_
 #define _TVG_SVG_LOADER_H_
 
+#include "tvgFile.h"
 #include "tvgTaskScheduler.h"
 #include "tvgSvgLoaderCommon.h"
 
 class SvgLoader : public ImageLoader, public Task
 {
 public:
-    string filePath;
+    FileMap file;
     string svgPath = "";
     char* content = nullptr;
     uint32_t size = 0;
@@ -25,6 +25,7 @@
 
 #include "tvgCommon.h"
 #include "tvgArray.h"
+#include "tvgRender.h"
 
 struct Box
 {
@@ -353,6 +354,9 @@ struct SvgImageNode
 struct SvgPathNode
 {
     char* path;
+    SvgNode* origin;      //the <use> instance borrows the path data of the origin node
+    RenderPath* parsed;   //the path data parsed once, shared among the <use> instances
+    bool invalid;
 };
 
 struct SvgPolygonNode
@@ -568,6 +572,74 @@ struct SvgNodeIdPair
     char *id;
 };
 
+//Open addressing hash table for the lookups by id. The items sharing a key are
+//kept all, find() returns the earliest pushed one which satisfies the match.
+template<typename T>
+struct SvgIndex
+{
+    struct Slot
+    {
+        T* item;
+        unsigned long key;
+        uint32_t seq;
+    };
+
+    Slot* slots = nullptr;
+    uint32_t count = 0;
+    uint32_t size = 0;      //power of 2
+
+    ~SvgIndex()
+    {
+        reset();
+    }
+
+    void push(unsigned long key, T* item)
+    {
+        if ((count + 1) * 4 > size * 3) grow();
+        insert({item, key, count++});
+    }
+
+    template<typename Match>
+    T* find(unsigned long key, Match match) const
+    {
+        if (count == 0) return nullptr;
+        Slot* found = nullptr;
+        for (auto i = key & (size - 1); slots[i].item; i = (i + 1) & (size - 1)) {
+            auto slot = &slots[i];
+            if (slot->key != key || (found && found->seq < slot->seq) || !match(slot->item)) continue;
+            found = slot;
+        }
+        return found ? found->item : nullptr;
+    }
+
+    void reset()
+    {
+        tvg::free(slots);
+        slots = nullptr;
+        count = size = 0;
+    }
+
+private:
+    void insert(const Slot& slot)
+    {
+        auto i = slot.key & (size - 1);
+        while (slots[i].item) i = (i + 1) & (size - 1);
+        slots[i] = slot;
+    }
+
+    void grow()
+    {
+        auto old = slots;
+        auto oldSize = size;
+        size = size ? size * 2 : 64;
+        slots = tvg::calloc<Slot*>(size, sizeof(Slot));
+        for (uint32_t i = 0; i < oldSize; ++i) {
+            if (old[i].item) insert(old[i]);
+        }
+        tvg::free(old);
+    }
+};
+
 struct FontFace
 {
     char* name = nullptr;
@@ -594,6 +666,8 @@ struct SvgLoaderData
     SvgParser* svgParse = nullptr;
     Array<SvgNodeIdPair> cloneNodes;
     Array<SvgNodeIdPair> nodesToStyle;
+    SvgIndex<SvgNode> ids;      //the document nodes by their ids
+    SvgIndex<SvgNode> css;      //the css style nodes by their selectors
     Array<char*> images;        //embedded images
     Array<FontFace> fonts;
     int level = 0;
@@ -515,7 +515,7 @@ static char* _nextCommand(char* path, char* cmd, float* arr, int* count, bool* c
 /************************************************************************/
 
 
-bool svgPathToShape(const char* svgPath, Shape* shape)
+bool svgPathToShape(const char* svgPath, RenderPath& path)
 {
     float numberArray[7];
     int numberCount = 0;
@@ -525,15 +525,15 @@ bool svgPathToShape(const char* svgPath, Shape* shape)
     char cmd = 0;
     bool isQuadratic = false;
     bool closed = false;
-    char* path = (char*)svgPath;
+    char* str = (char*)svgPath;
 
-    auto& pts = SHAPE(shape)->rs.path.pts;
-    auto& cmds = SHAPE(shape)->rs.path.cmds;
+    auto& pts = path.pts;
+    auto& cmds = path.cmds;
     auto lastCmds = cmds.count;
 
-    while ((path[0] != '\0')) {
-        path = _nextCommand(path, &cmd, numberArray, &numberCount, &closed);
-        if (!path) break;
+    while ((str[0] != '\0')) {
+        str = _nextCommand(str, &cmd, numberArray, &numberCount, &closed);
+        if (!str) break;
         closed = false;
         if (!_processCommand(&cmds, &pts, cmd, numberArray, numberCount, &cur, &curCtl, &startPoint, &isQuadratic, &closed)) break;
     }
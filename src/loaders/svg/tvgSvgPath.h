@@ -24,7 +24,8 @@
 #define _TVG_SVG_PATH_H_
 
 #include <tvgCommon.h>
+#include "tvgRender.h"
 
-bool svgPathToShape(const char* svgPath, Shape* shape);
+bool svgPathToShape(const char* svgPath, RenderPath& path);
 
 #endif //_TVG_SVG_PATH_H_
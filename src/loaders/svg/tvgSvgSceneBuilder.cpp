@@ -449,12 +449,34 @@ static Paint* _applyProperty(SvgLoaderData& loaderData, SvgNode* node, Shape* vg
 }
 
 
+//The path data of the <use> instances is parsed once and copied to each shape
+static bool _appendPath(SvgNode* node, Shape* shape)
+{
+    auto& path = SHAPE(shape)->rs.path;
+    auto origin = node->node.path.origin;
+
+    if (!origin) {
+        if (!node->node.path.parsed) return svgPathToShape(node->node.path.path, path);
+        origin = node;
+    }
+
+    auto& shared = origin->node.path;
+    if (!shared.parsed) {
+        shared.parsed = new RenderPath;
+        shared.invalid = !svgPathToShape(shared.path, *shared.parsed);
+    }
+    path.cmds.push(shared.parsed->cmds);
+    path.pts.push(shared.parsed->pts);
+    return !shared.invalid;
+}
+
+
 static bool _recognizeShape(SvgNode* node, Shape* shape)
 {
     switch (node->type) {
         case SvgNodeType::Path: {
             if (node->node.path.path) {
-                if (!svgPathToShape(node->node.path.path, shape)) {
+                if (!_appendPath(node, shape)) {
                     TVGERR("SVG", "Invalid path information.");
                     return false;
                 }
@@ -508,7 +530,10 @@ static bool _recognizeShape(SvgNode* node, Shape* shape)
 static Paint* _shapeBuildHelper(SvgLoaderData& loaderData, SvgNode* node, const Box& vBox, const string& svgPath)
 {
     auto shape = Shape::gen();
-    if (!_recognizeShape(node, shape)) return nullptr;
+    if (!_recognizeShape(node, shape)) {
+        delete(shape);
+        return nullptr;
+    }
     return _applyProperty(loaderData, node, shape, vBox, svgPath, false);
 }
 
@@ -22,143 +22,14 @@
 
 
 #include "tvgStr.h"
+#include "tvgShape.h"
 #include "tvgTtfLoader.h"
 
-#if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
-    #include <windows.h>
-#elif defined(__linux__)
-    #include <fcntl.h>
-    #include <unistd.h>
-    #include <sys/mman.h>
-    #include <sys/stat.h>
-#endif
-
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
-#ifdef THORVG_FILE_IO_SUPPORT
-
-#if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
-
-static bool _map(TtfLoader* loader, const string& path)
-{
-    auto& reader = loader->reader;
-
-	auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
-	if (file == INVALID_HANDLE_VALUE) return false;
-
-	DWORD high;
-	auto low = GetFileSize(file, &high);
-	if (low == INVALID_FILE_SIZE) {
-		CloseHandle(file);
-		return false;
-	}
-
-	reader.size = (uint32_t)((size_t)high << (8 * sizeof(DWORD)) | low);
-
-	loader->mapping = (uint8_t*)CreateFileMapping(file, NULL, PAGE_READONLY, high, low, NULL);
-
-	CloseHandle(file);
-
-	if (!loader->mapping) return false;
-
-	loader->reader.data = (uint8_t*) MapViewOfFile(loader->mapping, FILE_MAP_READ, 0, 0, 0);
-	if (!loader->reader.data) {
-		CloseHandle(loader->mapping);
-		loader->mapping = nullptr;
-		return false;
-	}
-	return true;
-}
-
-static void _unmap(TtfLoader* loader)
-{
-    auto& reader = loader->reader;
-
-	if (reader.data) {
-		UnmapViewOfFile(reader.data);
-		reader.data = nullptr;
-	}
-	if (loader->mapping) {
-		CloseHandle(loader->mapping);
-		loader->mapping = nullptr;
-	}
-}
-
-#elif defined(__linux__)
-
-static bool _map(TtfLoader* loader, const char* path)
-{
-    auto& reader = loader->reader;
-
-    auto fd = open(path, O_RDONLY);
-    if (fd < 0) return false;
-
-    struct stat info;
-    if (fstat(fd, &info) < 0) {
-        close(fd);
-        return false;
-    }
-
-    reader.data = (uint8_t*)mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
-    if (reader.data == (uint8_t*)-1) return false;
-    reader.size = (uint32_t) info.st_size;
-    close(fd);
-
-    return true;
-}
-
-
-static void _unmap(TtfLoader* loader)
-{
-    auto& reader = loader->reader;
-    if (reader.data == (uint8_t*) -1) return;
-    munmap((void *) reader.data, reader.size);
-    reader.data = (uint8_t*)-1;
-    reader.size = 0;
-}
-#else
-static bool _map(TtfLoader* loader, const char* path)
-{
-    auto& reader = loader->reader;
-
-    auto f = fopen(path, "rb");
-    if (!f) return false;
-
-    fseek(f, 0, SEEK_END);
-
-    reader.size = ftell(f);
-    if (reader.size == 0) {
-        fclose(f);
-        return false;
-    }
-
-    reader.data = tvg::malloc<uint8_t*>(reader.size);
-
-    fseek(f, 0, SEEK_SET);
-    auto ret = fread(reader.data, sizeof(char), reader.size, f);
-    if (ret < reader.size) {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
-    return true;
-}
-
-
-static void _unmap(TtfLoader* loader)
-{
-    auto& reader = loader->reader;
-    tvg::free(reader.data);
-    reader.data = nullptr;
-    reader.size = 0;
-}
-#endif
-
-#endif //THORVG_FILE_IO_SUPPORT
+static atomic<uint32_t> _fontIds{};
 
 
 static uint32_t* _codepoints(const char* text, size_t n)
@@ -196,6 +67,15 @@ static uint32_t* _codepoints(const char* text, size_t n)
 }
 
 
+//append the glyph outline at the given position
+static void _append(RenderPath& path, const RenderPath& glyph, const Point& offset)
+{
+    path.cmds.push(glyph.cmds);
+    path.pts.grow(glyph.pts.count);
+    ARRAY_FOREACH(p, glyph.pts) path.pts.push(*p + offset);
+}
+
+
 void TtfLoader::clear()
 {
     if (nomap) {
@@ -205,10 +85,11 @@ void TtfLoader::clear()
         freeData = false;
         nomap = false;
     } else {
-#ifdef THORVG_FILE_IO_SUPPORT
-        _unmap(this);
-#endif
+        file.unmap();
+        reader.data = nullptr;
+        reader.size = 0;
     }
+    reader.clear();
 
     tvg::free(name);
     name = nullptr;
@@ -236,6 +117,7 @@ float TtfLoader::transform(Paint* paint, FontMetrics& metrics, float fontSize, b
 
 TtfLoader::TtfLoader() : FontLoader(FileType::Ttf)
 {
+    id = ++_fontIds;
 }
 
 
@@ -249,7 +131,10 @@ bool TtfLoader::open(const char* path)
 {
 #ifdef THORVG_FILE_IO_SUPPORT
     clear();
-    if (!_map(this, path)) return false;
+    if (!file.map(path)) return false;
+
+    reader.data = (uint8_t*)file.data;
+    reader.size = file.size;
 
     name = tvg::filename(path);
 
@@ -286,24 +171,36 @@ bool TtfLoader::read(Shape* shape, char* text, FontMetrics& out)
     auto code = _codepoints(text, n);
     if (!code) return false;
 
-    //TODO: optimize with the texture-atlas?
-    TtfGlyphMetrics gmetrics;
+    //the glyph layout lets the raster engine cache the glyph images
+    auto& rs = SHAPE(shape)->rs;
+    if (!rs.text) rs.text = new RenderText;
+    rs.text->font = id;
+
+    auto& path = rs.path;
     Point offset = {0.0f, reader.metrics.hhea.ascent};
     Point kerning = {0.0f, 0.0f};
     auto lglyph = INVALID_GLYPH;
     auto loadMinw = true;
 
+    //the decoded glyphs are cached, the text is composed of their outlines
+    ScopedLock lock(key);
+
     size_t idx = 0;
     while (code[idx] && idx < n) {
-        auto rglyph = reader.glyph(code[idx], gmetrics);
-        if (rglyph != INVALID_GLYPH) {
-            if (lglyph != INVALID_GLYPH) reader.kerning(lglyph, rglyph, kerning);
-            if (!reader.convert(shape, gmetrics, offset, kerning, 1U)) break;
-            offset.x += (gmetrics.advanceWidth + kerning.x);
-            lglyph = rglyph;
+        if (auto rglyph = reader.glyph(code[idx])) {
+            if (lglyph != INVALID_GLYPH) reader.kerning(lglyph, rglyph->id, kerning);
+            _append(path, rglyph->path, offset + kerning);
+            //the broken outline is not a glyph, drop the layout
+            if (!rglyph->valid) {
+                rs.text->glyphs.clear();
+                break;
+            }
+            rs.text->glyphs.push({offset + kerning, rglyph->id, rglyph->path.cmds.count, rglyph->path.pts.count});
+            offset.x += (rglyph->metrics.advanceWidth + kerning.x);
+            lglyph = rglyph->id;
             //store the first glyph with outline min size for italic transform.
-            if (loadMinw && gmetrics.outline) {
-                out.minw = gmetrics.minw;
+            if (loadMinw && rglyph->metrics.outline) {
+                out.minw = rglyph->metrics.minw;
                 loadMinw = false;
             }
         }
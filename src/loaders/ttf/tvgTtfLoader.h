@@ -25,15 +25,17 @@
 
 #include "tvgLoader.h"
 #include "tvgTaskScheduler.h"
+#include "tvgLock.h"
+#include "tvgFile.h"
 #include "tvgTtfReader.h"
 
 
 struct TtfLoader : public FontLoader
 {
-#if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
-    void* mapping = nullptr;
-#endif
+    FileMap file;
     TtfReader reader;
+    Key key;                  //guards the glyph cache of the reader
+    uint32_t id;              //unique font id, the raster engines identify the glyph images with it
     char* text = nullptr;
     Shape* shape = nullptr;
     bool nomap = false;
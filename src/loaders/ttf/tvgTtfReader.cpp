@@ -22,7 +22,6 @@
 
 #include "tvgTtfReader.h"
 #include "tvgMath.h"
-#include "tvgShape.h"
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
@@ -188,6 +187,50 @@ uint32_t TtfReader::cmap_6(uint32_t table, uint32_t codepoint) const
 }
 
 
+//Finds the unicode cmap subtable, the full repertory (non-BMP) map is preferred
+void TtfReader::subtable()
+{
+    auto cmap = table("cmap");
+    if (!cmap || !validate(cmap, 4)) return;
+
+    auto entryCnt = _u16(data, cmap + 2);
+    if (!validate(cmap, 4 + entryCnt * 8)) return;
+
+    //full repertory (non-BMP map).
+    for (auto idx = 0; idx < entryCnt; ++idx) {
+        auto entry = cmap + 4 + idx * 8;
+        auto type = _u16(data, entry) * 0100 + _u16(data, entry + 2);
+        //unicode map
+        if (type == 0004 || type == 0312) {
+            auto table = cmap + _u32(data, entry + 4);
+            if (!validate(table, 8)) return;
+            if (_u16(data, table) == 12) {
+                this->cmap.table = table;
+                this->cmap.format = 12;
+            }
+            return;
+        }
+    }
+
+    //Try looking for a BMP map.
+    for (auto idx = 0; idx < entryCnt; ++idx) {
+        auto entry = cmap + 4 + idx * 8;
+        auto type = _u16(data, entry) * 0100 + _u16(data, entry + 2);
+        //Unicode BMP
+        if (type == 0003 || type == 0301) {
+            auto table = cmap + _u32(data, entry + 4);
+            if (!validate(table, 6)) return;
+            auto format = _u16(data, table);
+            if (format == 4 || format == 6) {
+                this->cmap.table = table + 6;
+                this->cmap.format = format;
+            }
+            return;
+        }
+    }
+}
+
+
 //Returns the offset into the font that the glyph's outline is stored at
 uint32_t TtfReader::outlineOffset(uint32_t glyph)
 {
@@ -325,68 +368,85 @@ bool TtfReader::header()
         if (_u16(data, kern) != 0) return false;
     }
 
+    subtable();
+
     return true;
 }
 
 
-uint32_t TtfReader::glyph(uint32_t codepoint)
+uint32_t TtfReader::glyphIndex(uint32_t codepoint)
 {
-    auto cmap = this->cmap.load();
-    if (cmap == 0) {
-        this->cmap = cmap = table("cmap");
-        if (!validate(cmap, 4)) return -1;
+    switch (cmap.format) {
+        case 12: return cmap_12_13(cmap.table, codepoint, 12);
+        case 4: return cmap_4(cmap.table, codepoint);
+        case 6: return cmap_6(cmap.table, codepoint);
+        default: return -1;
     }
+}
 
-    auto entryCnt = _u16(data, cmap + 2);
-    if (!validate(cmap, 4 + entryCnt * 8)) return -1;
 
-    //full repertory (non-BMP map).
-    for (auto idx = 0; idx < entryCnt; ++idx) {
-        auto entry = cmap + 4 + idx * 8;
-        auto type = _u16(data, entry) * 0100 + _u16(data, entry + 2);
-        //unicode map
-        if (type == 0004 || type == 0312) {
-            auto table = cmap + _u32(data, entry + 4);
-            if (!validate(table, 8)) return -1;
-            //dispatch based on cmap format.
-            auto format = _u16(data, table);
-            switch (format) {
-                case 12: return cmap_12_13(table, codepoint, 12);
-                default: return -1;
-            }
-        }
+TtfGlyph* TtfReader::glyph(uint32_t codepoint)
+{
+    auto id = glyphIndex(codepoint);
+    if (id == INVALID_GLYPH) {
+        TVGERR("TTF", "invalid glyph id, codepoint(0x%x)", codepoint);
+        return nullptr;
     }
 
-    //Try looking for a BMP map.
-    for (auto idx = 0; idx < entryCnt; ++idx) {
-        auto entry = cmap + 4 + idx * 8;
-        auto type = _u16(data, entry) * 0100 + _u16(data, entry + 2);
-        //Unicode BMP
-        if (type == 0003 || type == 0301) {
-            auto table = cmap + _u32(data, entry + 4);
-            if (!validate(table, 6)) return -1;
-            //Dispatch based on cmap format.
-            switch (_u16(data, table)) {
-                case 4: return cmap_4(table + 6, codepoint);
-                case 6: return cmap_6(table + 6, codepoint);
-                default: return -1;
-            }
-        }
-    }
-    return -1;
-}
+    auto& bucket = buckets[id % GLYPH_BUCKETS];
 
+    for (auto glyph = bucket; glyph; glyph = glyph->sibling) {
+        if (glyph->id != id) continue;
+        glyphs.remove(glyph);
+        glyphs.front(glyph);
+        return glyph;
+    }
 
-uint32_t TtfReader::glyph(uint32_t codepoint, TtfGlyphMetrics& gmetrics)
-{
-    auto glyph = this->glyph(codepoint);
-    if (glyph == INVALID_GLYPH || !glyphMetrics(glyph, gmetrics)) {
+    TtfGlyphMetrics metrics;
+    if (!glyphMetrics(id, metrics)) {
         TVGERR("TTF", "invalid glyph id, codepoint(0x%x)", codepoint);
-        return INVALID_GLYPH;
+        return nullptr;
     }
+
+    //recycle the least recently used one
+    TtfGlyph* glyph;
+    if (glyphCnt == GLYPH_CACHE_SIZE) {
+        glyph = glyphs.tail;
+        glyphs.remove(glyph);
+        auto sibling = &buckets[glyph->id % GLYPH_BUCKETS];
+        while (*sibling != glyph) sibling = &(*sibling)->sibling;
+        *sibling = glyph->sibling;
+        glyph->path.clear();
+    } else {
+        glyph = new TtfGlyph;
+        ++glyphCnt;
+    }
+
+    glyph->id = id;
+    glyph->metrics = metrics;
+    glyph->valid = convert(glyph->path, glyph->metrics, {0.0f, 0.0f}, {0.0f, 0.0f}, 1U);
+    glyph->sibling = bucket;
+    bucket = glyph;
+    glyphs.front(glyph);
+
     return glyph;
 }
 
+
+void TtfReader::clear()
+{
+    glyphs.free();
+    memset(buckets, 0, sizeof(buckets));
+    glyphCnt = 0;
+
+    for (auto& kerning : kernings) kerning.lglyph = kerning.rglyph = INVALID_GLYPH;
+
+    cmap.table = 0;
+    cmap.format = 0;
+    hmtx = loca = glyf = kern = maxp = 0;
+}
+
+
 bool TtfReader::glyphMetrics(uint32_t glyphIndex, TtfGlyphMetrics& gmetrics)
 {
     //horizontal metrics
@@ -436,7 +496,7 @@ bool TtfReader::glyphMetrics(uint32_t glyphIndex, TtfGlyphMetrics& gmetrics)
     return true;
 }
 
-bool TtfReader::convert(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth)
+bool TtfReader::convert(RenderPath& path, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth)
 {
     #define ON_CURVE 0x01
 
@@ -451,7 +511,7 @@ bool TtfReader::convert(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& of
             maxComponentDepth = _u16(data, maxp + 30);
         }
         if (componentDepth > maxComponentDepth) return false;
-        return convertComposite(shape, gmetrics, offset, kerning, componentDepth + 1);
+        return convertComposite(path, gmetrics, offset, kerning, componentDepth + 1);
     }
     auto cntrsCnt = (uint32_t) outlineCnt;
 
@@ -474,8 +534,8 @@ bool TtfReader::convert(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& of
     if (!this->points(outline, flags, pts, ptsCnt, offset + kerning)) return false;
 
     //generate tvg paths.
-    auto& pathCmds = SHAPE(shape)->rs.path.cmds;
-    auto& pathPts = SHAPE(shape)->rs.path.pts;
+    auto& pathCmds = path.cmds;
+    auto& pathPts = path.pts;
     pathCmds.reserve(ptsCnt);
     pathPts.reserve(ptsCnt);
 
@@ -526,7 +586,7 @@ bool TtfReader::convert(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& of
     return true;
 }
 
-bool TtfReader::convertComposite(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth)
+bool TtfReader::convertComposite(RenderPath& path, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth)
 {
     #define ARG_1_AND_2_ARE_WORDS 0x0001
     #define ARGS_ARE_XY_VALUES 0x0002
@@ -588,7 +648,7 @@ bool TtfReader::convertComposite(Shape* shape, TtfGlyphMetrics& gmetrics, const
             pointer += 8U;
         }
         if (!glyphMetrics(glyphIndex, componentGmetrics)) return false;
-        if (!convert(shape, componentGmetrics, offset + componentOffset, kerning, componentDepth)) return false;
+        if (!convert(path, componentGmetrics, offset + componentOffset, kerning, componentDepth)) return false;
     } while (flags & MORE_COMPONENTS);
     return true;
 }
@@ -602,6 +662,12 @@ void TtfReader::kerning(uint32_t lglyph, uint32_t rglyph, Point& out)
 
     if (!kern) return;
 
+    auto& cached = kernings[(lglyph * 31 + rglyph) % KERNING_CACHE_SIZE];
+    if (cached.lglyph == lglyph && cached.rglyph == rglyph) {
+        out = cached.value;
+        return;
+    }
+
     auto kern = this->kern.load();
 
     out.x = out.y = 0.0f;
@@ -612,7 +678,7 @@ void TtfReader::kerning(uint32_t lglyph, uint32_t rglyph, Point& out)
 
     while (tableCnt > 0) {
         //read subtable header.
-        if (!validate(kern, 6)) return;
+        if (!validate(kern, 6)) break;
         auto length = _u16(data, kern + 2);
         auto format = _u8(data, kern + 4);
         auto flags = _u8(data, kern + 5);
@@ -620,7 +686,7 @@ void TtfReader::kerning(uint32_t lglyph, uint32_t rglyph, Point& out)
 
         if (format == 0 && (flags & HORIZONTAL_KERNING) && !(flags & MINIMUM_KERNING)) {
             //read format 0 header.
-            if (!validate(kern, 8)) return;
+            if (!validate(kern, 8)) break;
             auto pairCnt = _u16(data, kern);
             kern += 8;
 
@@ -642,4 +708,8 @@ void TtfReader::kerning(uint32_t lglyph, uint32_t rglyph, Point& out)
         kern += length;
         --tableCnt;
     }
+
+    cached.lglyph = lglyph;
+    cached.rglyph = rglyph;
+    cached.value = out;
 }
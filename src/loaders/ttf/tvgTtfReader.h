@@ -26,6 +26,8 @@
 #include <atomic>
 #include "tvgCommon.h"
 #include "tvgArray.h"
+#include "tvgInlist.h"
+#include "tvgRender.h"
 
 #define INVALID_GLYPH ((uint32_t)-1)
 
@@ -40,6 +42,17 @@ struct TtfGlyphMetrics
     float minh;
 };
 
+//A decoded glyph, its outline is placed at the origin
+struct TtfGlyph
+{
+    INLIST_ITEM(TtfGlyph);
+    TtfGlyph* sibling;         //the next glyph in the same hash bucket
+    uint32_t id;
+    TtfGlyphMetrics metrics;
+    RenderPath path;
+    bool valid;                //false if the outline is (partially) broken
+};
+
 
 struct TtfReader
 {
@@ -62,13 +75,33 @@ public:
     } metrics;
 
     bool header();
-    uint32_t glyph(uint32_t codepoint, TtfGlyphMetrics& gmetrics);
+    TtfGlyph* glyph(uint32_t codepoint);
     void kerning(uint32_t lglyph, uint32_t rglyph, Point& out);
-    bool convert(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth);
+    void clear();
 
 private:
+    //the glyph cache, the least recently used glyph is at the tail
+    static constexpr uint32_t GLYPH_CACHE_SIZE = 512;
+    static constexpr uint32_t GLYPH_BUCKETS = 256;
+    static constexpr uint32_t KERNING_CACHE_SIZE = 256;
+
+    Inlist<TtfGlyph> glyphs;
+    TtfGlyph* buckets[GLYPH_BUCKETS] = {};
+    uint32_t glyphCnt = 0;
+
+    struct {
+        uint32_t lglyph = INVALID_GLYPH;
+        uint32_t rglyph = INVALID_GLYPH;
+        Point value;
+    } kernings[KERNING_CACHE_SIZE];
+
+    //the unicode cmap subtable, resolved once
+    struct {
+        uint32_t table = 0;
+        uint16_t format = 0;
+    } cmap;
+
     //table offsets
-    atomic<uint32_t> cmap{};
     atomic<uint32_t> hmtx{};
     atomic<uint32_t> loca{};
     atomic<uint32_t> glyf{};
@@ -81,9 +114,11 @@ private:
     bool validate(uint32_t offset, uint32_t margin) const;
     uint32_t table(const char* tag);
     uint32_t outlineOffset(uint32_t glyph);
-    uint32_t glyph(uint32_t codepoint);
+    void subtable();
+    uint32_t glyphIndex(uint32_t codepoint);
     bool glyphMetrics(uint32_t glyphIndex, TtfGlyphMetrics& gmetrics);
-    bool convertComposite(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth);
+    bool convert(RenderPath& path, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth);
+    bool convertComposite(RenderPath& path, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth);
     bool genPath(uint8_t* flags, uint16_t basePoint, uint16_t count);
     bool genSimpleOutline(Shape* shape, uint32_t outline, uint32_t cntrsCnt);
     bool points(uint32_t outline, uint8_t* flags, Point* pts, uint32_t ptsCnt, const Point& offset);
@@ -24,6 +24,7 @@
 #define _TVG_SW_COMMON_H_
 
 #include <algorithm>
+#include <atomic>
 #include "tvgCommon.h"
 #include "tvgMath.h"
 #include "tvgRender.h"
@@ -33,6 +34,10 @@
 #define SW_ANGLE_PI (180L << 16)
 #define SW_ANGLE_2PI (SW_ANGLE_PI << 1)
 #define SW_ANGLE_PI2 (SW_ANGLE_PI >> 1)
+#define SW_MAX_BANDS 32
+#define GRADIENT_STOP_SIZE 1024
+#define FIXPT_BITS 8
+#define FIXPT_SIZE (1<<FIXPT_BITS)
 
 
 static inline float TO_FLOAT(int32_t val)
@@ -269,6 +274,7 @@ typedef uint8_t(*SwMask)(uint8_t s, uint8_t d, uint8_t a);                  //sr
 typedef uint32_t(*SwBlender)(uint32_t s, uint32_t d, uint8_t a);            //src, dst, alpha
 typedef uint32_t(*SwJoin)(uint8_t r, uint8_t g, uint8_t b, uint8_t a);      //color channel join
 typedef uint8_t(*SwAlpha)(uint8_t*);                                        //blending alpha
+typedef void(*SwBandFunc)(void* data, const RenderRegion& band);            //raster band job
 
 struct SwCompositor;
 
@@ -279,6 +285,7 @@ struct SwSurface : RenderSurface
     SwBlender blender = nullptr;          //blender (optional)
     SwCompositor* compositor = nullptr;   //compositor (optional)
     BlendMethod blendMethod = BlendMethod::Normal;
+    uint8_t bands = 1;                    //max raster bands (parallel rasterization if greater than 1)
 
     SwAlpha alpha(MaskMethod method)
     {
@@ -297,6 +304,7 @@ struct SwSurface : RenderSurface
         blender = rhs->blender;
         compositor = rhs->compositor;
         blendMethod = rhs->blendMethod;
+        bands = rhs->bands;
      }
 };
 
@@ -309,14 +317,58 @@ struct SwCompositor : RenderCompositor
     bool valid;
 };
 
+//Pixel kernels which are selected by the cpu features at the engine initialization.
+//The scaled image sampling, the masking compositions, the blending methods and the 8bits mattings are still done per pixel.
+struct SwKernels
+{
+    void (*fill32)(uint32_t* dst, uint32_t val, uint32_t len);
+    void (*fill8)(uint8_t* dst, uint8_t val, uint32_t len);
+    void (*translucentColor)(uint32_t* dst, uint32_t color, uint32_t len);                                                                      //color over dst
+    void (*translucentPixels)(uint32_t* dst, const uint32_t* src, uint32_t len, uint8_t opacity);                                              //src over dst
+    void (*mattedColor)(uint32_t* dst, uint32_t color, const uint8_t* cmp, uint32_t len, uint8_t csize, bool inverse);                           //color over dst, masked by the cmp alpha
+    void (*mattedPixels)(uint32_t* dst, const uint32_t* src, const uint8_t* cmp, uint32_t len, uint8_t csize, uint8_t opacity, bool inverse);    //src over dst, masked by the cmp alpha
+    void (*luma)(uint8_t* dst, const uint32_t* src, uint32_t len, bool abgr, bool inverse);                                                    //luminance of the pixels, the luma matting masks
+    void (*premultiply)(uint32_t* buffer, uint32_t len);
+    void (*unpremultiply)(uint32_t* buffer, uint32_t len);
+    void (*swapRB)(uint32_t* buffer, uint32_t len);                                                                                              //ARGB <-> ABGR
+    void (*linear[3])(const uint32_t* ctable, uint32_t* dst, int32_t t, int32_t inc, uint32_t len);                                              //gradient colors by the fixed point positions, per FillSpread
+    void (*radial[3])(const uint32_t* ctable, uint32_t* dst, float& b, float deltaB, float& det, float& deltaDet, float deltaDeltaDet, uint32_t len);   //gradient colors by the quadratic roots, per FillSpread
+    void (*boxBlur)(uint32_t* dst, const uint32_t* in, const uint32_t* out, uint32_t len, int32_t* acc, float iarr);                             //slides the per channel sums of a box filter window, in/out: the entering/leaving pixels
+    void (*shadowBlur)(uint32_t* dst, const uint32_t* in, const uint32_t* out, uint32_t len, int32_t& acc, uint32_t color, float iarr);          //slides the alpha sum of a box filter window, filled with the color
+    void (*transpose)(uint32_t* dst, int32_t dstride, const uint32_t* src, int32_t sstride, int32_t w, int32_t h);                              //dst[x][y] = src[y][x]
+    const char* name;
+};
+
+extern SwKernels swKernels;
+extern const SwKernels swScalarKernels;    //the C versions, the others override them on top of these
+
+//Per thread bump allocator for the transient memory, which lives only within a task or a raster call
+//(the texture mapper's anti-aliasing spans and the glyph coverage buffer). The main block grows up to the peak usage
+//of a frame at mpoolReset(), so these are served without any heap calls in the steady frames. The shape data
+//(rle spans, stroke borders, gradient tables) outlive a frame and keep their own capacity instead.
+struct SwArena
+{
+    uint8_t* data;          //main block
+    uint32_t size;          //main block size in bytes
+    uint32_t used;          //allocated bytes from the main block
+    uint32_t live;          //alive allocations in the main block, it's rewound when all of them are returned
+    uint32_t spilled;       //allocated bytes out of the main block
+    uint32_t peak;          //the most bytes in use at once in the current frame
+};
+
 struct SwMpool
 {
     SwOutline* outline;
     SwOutline* strokeOutline;
     SwOutline* dashOutline;
+    RenderPath* path;
+    SwArena* arena;
     unsigned allocSize;
+    std::atomic<uint32_t> users;     //the running tasks of the renderers sharing this pool
 };
 
+struct SwGlyphCache;
+
 static inline int32_t TO_SWCOORD(float val)
 {
     return int32_t(val * 64.0f);
@@ -385,6 +437,31 @@ static inline bool UNPREMULTIPLY(uint32_t color, RenderColor& out)
     return true;
 }
 
+static inline uint32_t PREMULTIPLY(uint32_t c)
+{
+    auto a = (c >> 24);
+    return (c & 0xff000000) + ((((c >> 8) & 0xff) * a) & 0xff00) + ((((c & 0x00ff00ff) * a) >> 8) & 0x00ff00ff);
+}
+
+//the color table index of the gradient position
+template<FillSpread SPREAD>
+static inline int32_t fillClamp(int32_t pos)
+{
+    if (SPREAD == FillSpread::Pad) {
+        if (pos >= GRADIENT_STOP_SIZE) pos = GRADIENT_STOP_SIZE - 1;
+        else if (pos < 0) pos = 0;
+    } else if (SPREAD == FillSpread::Repeat) {
+        pos = pos % GRADIENT_STOP_SIZE;
+        if (pos < 0) pos = GRADIENT_STOP_SIZE + pos;
+    } else {
+        auto limit = GRADIENT_STOP_SIZE * 2;
+        pos = pos % limit;
+        if (pos < 0) pos = limit + pos;
+        if (pos >= GRADIENT_STOP_SIZE) pos = (limit - pos - 1);
+    }
+    return pos;
+}
+
 static inline uint32_t opBlendInterp(uint32_t s, uint32_t d, uint8_t a)
 {
     return INTERPOLATE(s, d, a);
@@ -585,6 +662,7 @@ int64_t mathMean(int64_t angle1, int64_t angle2);
 SwPoint mathTransform(const Point* to, const Matrix& transform);
 bool mathUpdateOutlineBBox(const SwOutline* outline, const RenderRegion& clipBox, RenderRegion& renderBox, bool fastTrack);
 
+void shapeGenOutline(SwOutline& outline, const PathCommand* cmds, uint32_t cmdCnt, const Point* pts, const Matrix& transform);
 void shapeReset(SwShape* shape);
 bool shapePrepare(SwShape* shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool hasComposite);
 bool shapePrepared(const SwShape* shape);
@@ -612,18 +690,26 @@ void imageDelOutline(SwImage* image, SwMpool* mpool, uint32_t tid);
 void imageReset(SwImage* image);
 void imageFree(SwImage* image);
 
+SwGlyphCache* glyphCacheInit(uint32_t threads);
+void glyphCacheTerm(SwGlyphCache* cache);
+bool glyphGenRle(SwShape* shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwGlyphCache* cache, SwMpool* mpool, unsigned tid);
+
 bool fillGenColorTable(SwFill* fill, const Fill* fdata, const Matrix& transform, SwSurface* surface, uint8_t opacity, bool ctable);
 const Fill::ColorStop* fillFetchSolid(const SwFill* fill, const Fill* fdata);
 void fillReset(SwFill* fill);
 void fillFree(SwFill* fill);
 
 //OPTIMIZE_ME: Skip the function pointer access
+void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len);                                                                   //copy ver.
+void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t a);                                                        //normal blending ver.
 void fillLinear(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32_t len, SwMask maskOp, uint8_t opacity);                                   //composite masking ver.
 void fillLinear(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t* cmp, SwMask maskOp, uint8_t opacity);                     //direct masking ver.
 void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, SwBlender op, uint8_t a);                                         //blending ver.
 void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, SwBlender op, SwBlender op2, uint8_t a);                          //blending + BlendingMethod(op2) ver.
 void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t* cmp, SwAlpha alpha, uint8_t csize, uint8_t opacity);     //matting ver.
 
+void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len);                                                                   //copy ver.
+void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t a);                                                        //normal blending ver.
 void fillRadial(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32_t len, SwMask op, uint8_t a);                                             //composite masking ver.
 void fillRadial(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t* cmp, SwMask op, uint8_t a) ;                              //direct masking ver.
 void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, SwBlender op, uint8_t a);                                         //blending ver.
@@ -647,10 +733,19 @@ SwOutline* mpoolReqStrokeOutline(SwMpool* mpool, unsigned idx);
 void mpoolRetStrokeOutline(SwMpool* mpool, unsigned idx);
 SwOutline* mpoolReqDashOutline(SwMpool* mpool, unsigned idx);
 void mpoolRetDashOutline(SwMpool* mpool, unsigned idx);
+RenderPath* mpoolReqPath(SwMpool* mpool, unsigned idx);
+void mpoolRetPath(SwMpool* mpool, unsigned idx);
+void* mpoolAlloc(SwMpool* mpool, unsigned idx, uint32_t size);
+void mpoolFree(SwMpool* mpool, unsigned idx, void* ptr, uint32_t size);
+void mpoolReset(SwMpool* mpool);
+void mpoolRetain(SwMpool* mpool);
+void mpoolRelease(SwMpool* mpool);
+
+void kernelInit();
 
 bool rasterCompositor(SwSurface* surface);
 bool rasterShape(SwSurface* surface, SwShape* shape, const RenderRegion& bbox, RenderColor& c);
-bool rasterTexmapPolygon(SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity);
+bool rasterTexmapPolygon(SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity, SwMpool* mpool, unsigned tid);
 bool rasterScaledImage(SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity);
 bool rasterDirectImage(SwSurface* surface, const SwImage& image, const RenderRegion& bbox, uint8_t opacity);
 bool rasterScaledRleImage(SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity);
@@ -663,11 +758,18 @@ void rasterPixel32(uint32_t *dst, uint32_t val, uint32_t offset, int32_t len);
 void rasterTranslucentPixel32(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity);
 void rasterPixel32(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity);
 void rasterGrayscale8(uint8_t *dst, uint8_t val, uint32_t offset, int32_t len);
-void rasterXYFlip(uint32_t* src, uint32_t* dst, int32_t stride, int32_t w, int32_t h, const RenderRegion& bbox, bool flipped);
+void rasterXYFlip(const SwSurface* surface, uint32_t* src, uint32_t* dst, int32_t stride, int32_t w, int32_t h, const RenderRegion& bbox, bool flipped);
 void rasterUnpremultiply(RenderSurface* surface);
 void rasterPremultiply(RenderSurface* surface);
 bool rasterConvertCS(RenderSurface* surface, ColorSpace to);
 uint32_t rasterUnpremultiply(uint32_t data);
+void rasterBands(const SwSurface* surface, const RenderRegion& bbox, SwBandFunc func, void* data);
+
+template<typename Func>
+static inline void rasterBands(const SwSurface* surface, const RenderRegion& bbox, const Func& func)
+{
+    rasterBands(surface, bbox, [](void* data, const RenderRegion& band) { (*static_cast<const Func*>(data))(band); }, (void*)&func);
+}
 
 bool effectGaussianBlur(SwCompositor* cmp, SwSurface* surface, const RenderEffectGaussianBlur* params);
 bool effectGaussianBlurRegion(RenderEffectGaussianBlur* effect);
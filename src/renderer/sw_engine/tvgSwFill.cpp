@@ -28,9 +28,8 @@
 /************************************************************************/
 
 #define RADIAL_A_THRESHOLD 0.0005f
-#define GRADIENT_STOP_SIZE 1024
-#define FIXPT_BITS 8
-#define FIXPT_SIZE (1<<FIXPT_BITS)
+
+constexpr uint32_t SPAN_CHUNK_SIZE = 128;   //gradient colors generated at once
 
 /*
  * quadratic equation with the following coefficients (rx and ry defined in the _calculateCoefficients()):
@@ -277,23 +276,9 @@ bool _prepareRadial(SwFill* fill, const RadialGradient* radial, const Matrix& pT
 static inline uint32_t _clamp(const SwFill* fill, int32_t pos)
 {
     switch (fill->spread) {
-        case FillSpread::Pad: {
-            if (pos >= GRADIENT_STOP_SIZE) pos = GRADIENT_STOP_SIZE - 1;
-            else if (pos < 0) pos = 0;
-            break;
-        }
-        case FillSpread::Repeat: {
-            pos = pos % GRADIENT_STOP_SIZE;
-            if (pos < 0) pos = GRADIENT_STOP_SIZE + pos;
-            break;
-        }
-        case FillSpread::Reflect: {
-            auto limit = GRADIENT_STOP_SIZE * 2;
-            pos = pos % limit;
-            if (pos < 0) pos = limit + pos;
-            if (pos >= GRADIENT_STOP_SIZE) pos = (limit - pos - 1);
-            break;
-        }
+        case FillSpread::Pad: return fillClamp<FillSpread::Pad>(pos);
+        case FillSpread::Repeat: return fillClamp<FillSpread::Repeat>(pos);
+        case FillSpread::Reflect: return fillClamp<FillSpread::Reflect>(pos);
     }
     return pos;
 }
@@ -313,466 +298,266 @@ static inline uint32_t _pixel(const SwFill* fill, float pos)
 }
 
 
-/************************************************************************/
-/* External Class Implementation                                        */
-/************************************************************************/
+//Generates the gradient colors of the span by chunks and passes them to the composer.
+template<typename Composer>
+static void _fillLinear(const SwFill* fill, uint32_t y, uint32_t x, uint32_t len, Composer composer)
+{
+    uint32_t colors[SPAN_CHUNK_SIZE];
 
+    //Rotation
+    float rx = x + 0.5f;
+    float ry = y + 0.5f;
+    float t = (fill->linear.dx * rx + fill->linear.dy * ry + fill->linear.offset) * (GRADIENT_STOP_SIZE - 1);
+    float inc = (fill->linear.dx) * (GRADIENT_STOP_SIZE - 1);
 
-void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t* cmp, SwAlpha alpha, uint8_t csize, uint8_t opacity)
+    if (tvg::zero(inc)) {
+        auto color = _fixedPixel(fill, static_cast<int32_t>(t * FIXPT_SIZE));
+        swKernels.fill32(colors, color, std::min(len, SPAN_CHUNK_SIZE));
+        while (len > 0) {
+            auto n = std::min(len, SPAN_CHUNK_SIZE);
+            composer(colors, n);
+            len -= n;
+        }
+        return;
+    }
+
+    auto vMax = static_cast<float>(INT32_MAX >> (FIXPT_BITS + 1));
+    auto vMin = -vMax;
+    auto v = t + (inc * len);
+
+    //we can use fixed point math
+    if (v < vMax && v > vMin) {
+        auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
+        auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
+        auto linear = swKernels.linear[static_cast<int>(fill->spread)];
+        while (len > 0) {
+            auto n = std::min(len, SPAN_CHUNK_SIZE);
+            linear(fill->ctable, colors, t2, inc2, n);
+            composer(colors, n);
+            t2 += inc2 * static_cast<int32_t>(n);
+            len -= n;
+        }
+    //we have to fallback to float math
+    } else {
+        while (len > 0) {
+            auto n = std::min(len, SPAN_CHUNK_SIZE);
+            for (uint32_t i = 0; i < n; ++i, t += inc) {
+                colors[i] = _pixel(fill, t / GRADIENT_STOP_SIZE);
+            }
+            composer(colors, n);
+            len -= n;
+        }
+    }
+}
+
+
+//Generates the gradient colors of the span by chunks and passes them to the composer.
+template<typename Composer>
+static void _fillRadial(const SwFill* fill, uint32_t y, uint32_t x, uint32_t len, Composer composer)
 {
+    uint32_t colors[SPAN_CHUNK_SIZE];
+
     //edge case
     if (fill->radial.a < RADIAL_A_THRESHOLD) {
         auto radial = &fill->radial;
         auto rx = (x + 0.5f) * radial->a11 + (y + 0.5f) * radial->a12 + radial->a13 - radial->fx;
         auto ry = (x + 0.5f) * radial->a21 + (y + 0.5f) * radial->a22 + radial->a23 - radial->fy;
-
-        if (opacity == 255) {
-            for (uint32_t i = 0 ; i < len ; ++i, ++dst, cmp += csize) {
+        while (len > 0) {
+            auto n = std::min(len, SPAN_CHUNK_SIZE);
+            for (uint32_t i = 0; i < n; ++i) {
                 auto x0 = 0.5f * (rx * rx + ry * ry - radial->fr * radial->fr) / (radial->dr * radial->fr + rx * radial->dx + ry * radial->dy);
-                *dst = opBlendNormal(_pixel(fill, x0), *dst, alpha(cmp));
-                rx += radial->a11;
-                ry += radial->a21;
-            }
-        } else {
-            for (uint32_t i = 0 ; i < len ; ++i, ++dst, cmp += csize) {
-                auto x0 = 0.5f * (rx * rx + ry * ry - radial->fr * radial->fr) / (radial->dr * radial->fr + rx * radial->dx + ry * radial->dy);
-                *dst = opBlendNormal(_pixel(fill, x0), *dst, MULTIPLY(opacity, alpha(cmp)));
+                colors[i] = _pixel(fill, x0);
                 rx += radial->a11;
                 ry += radial->a21;
             }
+            composer(colors, n);
+            len -= n;
         }
     } else {
         float b, deltaB, det, deltaDet, deltaDeltaDet;
         _calculateCoefficients(fill, x, y, b, deltaB, det, deltaDet, deltaDeltaDet);
+        auto radial = swKernels.radial[static_cast<int>(fill->spread)];
+        while (len > 0) {
+            auto n = std::min(len, SPAN_CHUNK_SIZE);
+            radial(fill->ctable, colors, b, deltaB, det, deltaDet, deltaDeltaDet, n);
+            composer(colors, n);
+            len -= n;
+        }
+    }
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len)
+{
+    _fillRadial(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
+        memcpy(dst, src, len * sizeof(uint32_t));
+        dst += len;
+    });
+}
+
+
+void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t a)
+{
+    _fillRadial(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
+        swKernels.translucentPixels(dst, src, len, a);
+        dst += len;
+    });
+}
+
 
+void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t* cmp, SwAlpha alpha, uint8_t csize, uint8_t opacity)
+{
+    _fillRadial(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
         if (opacity == 255) {
-            for (uint32_t i = 0 ; i < len ; ++i, ++dst, cmp += csize) {
-                *dst = opBlendNormal(_pixel(fill, sqrtf(det) - b), *dst, alpha(cmp));
-                det += deltaDet;
-                deltaDet += deltaDeltaDet;
-                b += deltaB;
+            for (uint32_t i = 0; i < len; ++i, ++dst, ++src, cmp += csize) {
+                *dst = opBlendNormal(*src, *dst, alpha(cmp));
             }
         } else {
-            for (uint32_t i = 0 ; i < len ; ++i, ++dst, cmp += csize) {
-                *dst = opBlendNormal(_pixel(fill, sqrtf(det) - b), *dst, MULTIPLY(opacity, alpha(cmp)));
-                det += deltaDet;
-                deltaDet += deltaDeltaDet;
-                b += deltaB;
+            for (uint32_t i = 0; i < len; ++i, ++dst, ++src, cmp += csize) {
+                *dst = opBlendNormal(*src, *dst, MULTIPLY(opacity, alpha(cmp)));
             }
         }
-    }
+    });
 }
 
 
 void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, SwBlender op, uint8_t a)
 {
-    if (fill->radial.a < RADIAL_A_THRESHOLD) {
-        auto radial = &fill->radial;
-        auto rx = (x + 0.5f) * radial->a11 + (y + 0.5f) * radial->a12 + radial->a13 - radial->fx;
-        auto ry = (x + 0.5f) * radial->a21 + (y + 0.5f) * radial->a22 + radial->a23 - radial->fy;
-        for (uint32_t i = 0; i < len; ++i, ++dst) {
-            auto x0 = 0.5f * (rx * rx + ry * ry - radial->fr * radial->fr) / (radial->dr * radial->fr + rx * radial->dx + ry * radial->dy);
-            *dst = op(_pixel(fill, x0), *dst, a);
-            rx += radial->a11;
-            ry += radial->a21;
-        }
-    } else {
-        float b, deltaB, det, deltaDet, deltaDeltaDet;
-        _calculateCoefficients(fill, x, y, b, deltaB, det, deltaDet, deltaDeltaDet);
-
-        for (uint32_t i = 0; i < len; ++i, ++dst) {
-            *dst = op(_pixel(fill, sqrtf(det) - b), *dst, a);
-            det += deltaDet;
-            deltaDet += deltaDeltaDet;
-            b += deltaB;
+    _fillRadial(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
+        for (uint32_t i = 0; i < len; ++i, ++dst, ++src) {
+            *dst = op(*src, *dst, a);
         }
-    }
+    });
 }
 
 
 void fillRadial(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32_t len, SwMask maskOp, uint8_t a)
 {
-    if (fill->radial.a < RADIAL_A_THRESHOLD) {
-        auto radial = &fill->radial;
-        auto rx = (x + 0.5f) * radial->a11 + (y + 0.5f) * radial->a12 + radial->a13 - radial->fx;
-        auto ry = (x + 0.5f) * radial->a21 + (y + 0.5f) * radial->a22 + radial->a23 - radial->fy;
-        for (uint32_t i = 0 ; i < len ; ++i, ++dst) {
-            auto x0 = 0.5f * (rx * rx + ry * ry - radial->fr * radial->fr) / (radial->dr * radial->fr + rx * radial->dx + ry * radial->dy);
-            auto src = MULTIPLY(a, A(_pixel(fill, x0)));
-            *dst = maskOp(src, *dst, ~src);
-            rx += radial->a11;
-            ry += radial->a21;
-        }
-    } else {
-        float b, deltaB, det, deltaDet, deltaDeltaDet;
-        _calculateCoefficients(fill, x, y, b, deltaB, det, deltaDet, deltaDeltaDet);
-
-        for (uint32_t i = 0 ; i < len ; ++i, ++dst) {
-            auto src = MULTIPLY(a, A(_pixel(fill, sqrtf(det) - b)));
-            *dst = maskOp(src, *dst, ~src);
-            det += deltaDet;
-            deltaDet += deltaDeltaDet;
-            b += deltaB;
+    _fillRadial(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
+        for (uint32_t i = 0; i < len; ++i, ++dst, ++src) {
+            auto tmp = MULTIPLY(a, A(*src));
+            *dst = maskOp(tmp, *dst, ~tmp);
         }
-    }
+    });
 }
 
 
 void fillRadial(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t* cmp, SwMask maskOp, uint8_t a)
 {
-    if (fill->radial.a < RADIAL_A_THRESHOLD) {
-        auto radial = &fill->radial;
-        auto rx = (x + 0.5f) * radial->a11 + (y + 0.5f) * radial->a12 + radial->a13 - radial->fx;
-        auto ry = (x + 0.5f) * radial->a21 + (y + 0.5f) * radial->a22 + radial->a23 - radial->fy;
-        for (uint32_t i = 0 ; i < len ; ++i, ++dst, ++cmp) {
-            auto x0 = 0.5f * (rx * rx + ry * ry - radial->fr * radial->fr) / (radial->dr * radial->fr + rx * radial->dx + ry * radial->dy);
-            auto src = MULTIPLY(A(A(_pixel(fill, x0))), a);
-            auto tmp = maskOp(src, *cmp, 0);
+    _fillRadial(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
+        for (uint32_t i = 0; i < len; ++i, ++dst, ++src, ++cmp) {
+            auto tmp = maskOp(MULTIPLY(A(*src), a), *cmp, 0);
             *dst = tmp + MULTIPLY(*dst, ~tmp);
-            rx += radial->a11;
-            ry += radial->a21;
         }
-    } else {
-        float b, deltaB, det, deltaDet, deltaDeltaDet;
-        _calculateCoefficients(fill, x, y, b, deltaB, det, deltaDet, deltaDeltaDet);
-
-        for (uint32_t i = 0 ; i < len ; ++i, ++dst, ++cmp) {
-            auto src = MULTIPLY(A(_pixel(fill, sqrtf(det))), a);
-            auto tmp = maskOp(src, *cmp, 0);
-            *dst = tmp + MULTIPLY(*dst, ~tmp);
-            det += deltaDet;
-            deltaDet += deltaDeltaDet;
-            b += deltaB;
-        }
-    }
+    });
 }
 
 
 void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, SwBlender op, SwBlender op2, uint8_t a)
 {
-    if (fill->radial.a < RADIAL_A_THRESHOLD) {
-        auto radial = &fill->radial;
-        auto rx = (x + 0.5f) * radial->a11 + (y + 0.5f) * radial->a12 + radial->a13 - radial->fx;
-        auto ry = (x + 0.5f) * radial->a21 + (y + 0.5f) * radial->a22 + radial->a23 - radial->fy;
-
-        if (a == 255) {
-            for (uint32_t i = 0; i < len; ++i, ++dst) {
-                auto x0 = 0.5f * (rx * rx + ry * ry - radial->fr * radial->fr) / (radial->dr * radial->fr + rx * radial->dx + ry * radial->dy);
-                auto tmp = op(_pixel(fill, x0), *dst, 255);
-                *dst = op2(tmp, *dst, 255);
-                rx += radial->a11;
-                ry += radial->a21;
-            }
-        } else {
-            for (uint32_t i = 0; i < len; ++i, ++dst) {
-                auto x0 = 0.5f * (rx * rx + ry * ry - radial->fr * radial->fr) / (radial->dr * radial->fr + rx * radial->dx + ry * radial->dy);
-                auto tmp = op(_pixel(fill, x0), *dst, 255);
-                auto tmp2 = op2(tmp, *dst, 255);
-                *dst = INTERPOLATE(tmp2, *dst, a);
-                rx += radial->a11;
-                ry += radial->a21;
-            }
-        }
-    } else {
-        float b, deltaB, det, deltaDet, deltaDeltaDet;
-        _calculateCoefficients(fill, x, y, b, deltaB, det, deltaDet, deltaDeltaDet);
+    _fillRadial(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
         if (a == 255) {
-            for (uint32_t i = 0 ; i < len ; ++i, ++dst) {
-                auto tmp = op(_pixel(fill, sqrtf(det) - b), *dst, 255);
+            for (uint32_t i = 0; i < len; ++i, ++dst, ++src) {
+                auto tmp = op(*src, *dst, 255);
                 *dst = op2(tmp, *dst, 255);
-                det += deltaDet;
-                deltaDet += deltaDeltaDet;
-                b += deltaB;
             }
         } else {
-            for (uint32_t i = 0 ; i < len ; ++i, ++dst) {
-                auto tmp = op(_pixel(fill, sqrtf(det) - b), *dst, 255);
+            for (uint32_t i = 0; i < len; ++i, ++dst, ++src) {
+                auto tmp = op(*src, *dst, 255);
                 auto tmp2 = op2(tmp, *dst, 255);
                 *dst = INTERPOLATE(tmp2, *dst, a);
-                det += deltaDet;
-                deltaDet += deltaDeltaDet;
-                b += deltaB;
             }
         }
-    }
+    });
 }
 
 
-void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t* cmp, SwAlpha alpha, uint8_t csize, uint8_t opacity)
+void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len)
 {
-    //Rotation
-    float rx = x + 0.5f;
-    float ry = y + 0.5f;
-    float t = (fill->linear.dx * rx + fill->linear.dy * ry + fill->linear.offset) * (GRADIENT_STOP_SIZE - 1);
-    float inc = (fill->linear.dx) * (GRADIENT_STOP_SIZE - 1);
+    _fillLinear(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
+        memcpy(dst, src, len * sizeof(uint32_t));
+        dst += len;
+    });
+}
 
-    if (opacity == 255) {
-        if (tvg::zero(inc)) {
-            auto color = _fixedPixel(fill, static_cast<int32_t>(t * FIXPT_SIZE));
-            for (uint32_t i = 0; i < len; ++i, ++dst, cmp += csize) {
-                *dst = opBlendNormal(color, *dst, alpha(cmp));
-            }
-            return;
-        }
 
-        auto vMax = static_cast<float>(INT32_MAX >> (FIXPT_BITS + 1));
-        auto vMin = -vMax;
-        auto v = t + (inc * len);
-
-        //we can use fixed point math
-        if (v < vMax && v > vMin) {
-            auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
-            auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-            for (uint32_t j = 0; j < len; ++j, ++dst, cmp += csize) {
-                *dst = opBlendNormal(_fixedPixel(fill, t2), *dst, alpha(cmp));
-                t2 += inc2;
-            }
-        //we have to fallback to float math
-        } else {
-            uint32_t counter = 0;
-            while (counter++ < len) {
-                *dst = opBlendNormal(_pixel(fill, t / GRADIENT_STOP_SIZE), *dst, alpha(cmp));
-                ++dst;
-                t += inc;
-                cmp += csize;
-            }
-        }
-    } else {
-        if (tvg::zero(inc)) {
-            auto color = _fixedPixel(fill, static_cast<int32_t>(t * FIXPT_SIZE));
-            for (uint32_t i = 0; i < len; ++i, ++dst, cmp += csize) {
-                *dst = opBlendNormal(color, *dst, MULTIPLY(alpha(cmp), opacity));
-            }
-            return;
-        }
+void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t a)
+{
+    _fillLinear(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
+        swKernels.translucentPixels(dst, src, len, a);
+        dst += len;
+    });
+}
 
-        auto vMax = static_cast<float>(INT32_MAX >> (FIXPT_BITS + 1));
-        auto vMin = -vMax;
-        auto v = t + (inc * len);
-
-        //we can use fixed point math
-        if (v < vMax && v > vMin) {
-            auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
-            auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-            for (uint32_t j = 0; j < len; ++j, ++dst, cmp += csize) {
-                *dst = opBlendNormal(_fixedPixel(fill, t2), *dst, MULTIPLY(alpha(cmp), opacity));
-                t2 += inc2;
+
+void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t* cmp, SwAlpha alpha, uint8_t csize, uint8_t opacity)
+{
+    _fillLinear(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
+        if (opacity == 255) {
+            for (uint32_t i = 0; i < len; ++i, ++dst, ++src, cmp += csize) {
+                *dst = opBlendNormal(*src, *dst, alpha(cmp));
             }
-        //we have to fallback to float math
         } else {
-            uint32_t counter = 0;
-            while (counter++ < len) {
-                *dst = opBlendNormal(_pixel(fill, t / GRADIENT_STOP_SIZE), *dst, MULTIPLY(opacity, alpha(cmp)));
-                ++dst;
-                t += inc;
-                cmp += csize;
+            for (uint32_t i = 0; i < len; ++i, ++dst, ++src, cmp += csize) {
+                *dst = opBlendNormal(*src, *dst, MULTIPLY(opacity, alpha(cmp)));
             }
         }
-    }
+    });
 }
 
 
 void fillLinear(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32_t len, SwMask maskOp, uint8_t a)
 {
-    //Rotation
-    float rx = x + 0.5f;
-    float ry = y + 0.5f;
-    float t = (fill->linear.dx * rx + fill->linear.dy * ry + fill->linear.offset) * (GRADIENT_STOP_SIZE - 1);
-    float inc = (fill->linear.dx) * (GRADIENT_STOP_SIZE - 1);
-
-    if (tvg::zero(inc)) {
-        auto src = MULTIPLY(a, A(_fixedPixel(fill, static_cast<int32_t>(t * FIXPT_SIZE))));
-        for (uint32_t i = 0; i < len; ++i, ++dst) {
-            *dst = maskOp(src, *dst, ~src);
+    _fillLinear(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
+        for (uint32_t i = 0; i < len; ++i, ++dst, ++src) {
+            auto tmp = MULTIPLY(a, A(*src));
+            *dst = maskOp(tmp, *dst, ~tmp);
         }
-        return;
-    }
-
-    auto vMax = static_cast<float>(INT32_MAX >> (FIXPT_BITS + 1));
-    auto vMin = -vMax;
-    auto v = t + (inc * len);
-
-    //we can use fixed point math
-    if (v < vMax && v > vMin) {
-        auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
-        auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-        for (uint32_t j = 0; j < len; ++j, ++dst) {
-            auto src = MULTIPLY(A(_fixedPixel(fill, t2)), a);
-            *dst = maskOp(src, *dst, ~src);
-            t2 += inc2;
-        }
-    //we have to fallback to float math
-    } else {
-        uint32_t counter = 0;
-        while (counter++ < len) {
-            auto src = MULTIPLY(A(_pixel(fill, t / GRADIENT_STOP_SIZE)), a);
-            *dst = maskOp(src, *dst, ~src);
-            ++dst;
-            t += inc;
-        }
-    }
+    });
 }
 
 
 void fillLinear(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t* cmp, SwMask maskOp, uint8_t a)
 {
-    //Rotation
-    float rx = x + 0.5f;
-    float ry = y + 0.5f;
-    float t = (fill->linear.dx * rx + fill->linear.dy * ry + fill->linear.offset) * (GRADIENT_STOP_SIZE - 1);
-    float inc = (fill->linear.dx) * (GRADIENT_STOP_SIZE - 1);
-
-    if (tvg::zero(inc)) {
-        auto src = A(_fixedPixel(fill, static_cast<int32_t>(t * FIXPT_SIZE)));
-        src = MULTIPLY(src, a);
-        for (uint32_t i = 0; i < len; ++i, ++dst, ++cmp) {
-            auto tmp = maskOp(src, *cmp, 0);
-            *dst = tmp + MULTIPLY(*dst, ~tmp);
-        }
-        return;
-    }
-
-    auto vMax = static_cast<float>(INT32_MAX >> (FIXPT_BITS + 1));
-    auto vMin = -vMax;
-    auto v = t + (inc * len);
-
-    //we can use fixed point math
-    if (v < vMax && v > vMin) {
-        auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
-        auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-        for (uint32_t j = 0; j < len; ++j, ++dst, ++cmp) {
-            auto src = MULTIPLY(a, A(_fixedPixel(fill, t2)));
-            auto tmp = maskOp(src, *cmp, 0);
-            *dst = tmp + MULTIPLY(*dst, ~tmp);
-            t2 += inc2;
-        }
-    //we have to fallback to float math
-    } else {
-        uint32_t counter = 0;
-        while (counter++ < len) {
-            auto src = MULTIPLY(A(_pixel(fill, t / GRADIENT_STOP_SIZE)), a);
-            auto tmp = maskOp(src, *cmp, 0);
+    _fillLinear(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
+        for (uint32_t i = 0; i < len; ++i, ++dst, ++src, ++cmp) {
+            auto tmp = maskOp(MULTIPLY(A(*src), a), *cmp, 0);
             *dst = tmp + MULTIPLY(*dst, ~tmp);
-            ++dst;
-            ++cmp;
-            t += inc;
         }
-    }
+    });
 }
 
 
 void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, SwBlender op, uint8_t a)
 {
-    //Rotation
-    float rx = x + 0.5f;
-    float ry = y + 0.5f;
-    float t = (fill->linear.dx * rx + fill->linear.dy * ry + fill->linear.offset) * (GRADIENT_STOP_SIZE - 1);
-    float inc = (fill->linear.dx) * (GRADIENT_STOP_SIZE - 1);
-
-    if (tvg::zero(inc)) {
-        auto color = _fixedPixel(fill, static_cast<int32_t>(t * FIXPT_SIZE));
-        for (uint32_t i = 0; i < len; ++i, ++dst) {
-            *dst = op(color, *dst, a);
+    _fillLinear(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
+        for (uint32_t i = 0; i < len; ++i, ++dst, ++src) {
+            *dst = op(*src, *dst, a);
         }
-        return;
-    }
-
-    auto vMax = static_cast<float>(INT32_MAX >> (FIXPT_BITS + 1));
-    auto vMin = -vMax;
-    auto v = t + (inc * len);
-
-    //we can use fixed point math
-    if (v < vMax && v > vMin) {
-        auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
-        auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-        for (uint32_t j = 0; j < len; ++j, ++dst) {
-            *dst = op(_fixedPixel(fill, t2), *dst, a);
-            t2 += inc2;
-        }
-    //we have to fallback to float math
-    } else {
-        uint32_t counter = 0;
-        while (counter++ < len) {
-            *dst = op(_pixel(fill, t / GRADIENT_STOP_SIZE), *dst, a);
-            ++dst;
-            t += inc;
-        }
-    }
+    });
 }
 
 
 void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, SwBlender op, SwBlender op2, uint8_t a)
 {
-    //Rotation
-    float rx = x + 0.5f;
-    float ry = y + 0.5f;
-    float t = (fill->linear.dx * rx + fill->linear.dy * ry + fill->linear.offset) * (GRADIENT_STOP_SIZE - 1);
-    float inc = (fill->linear.dx) * (GRADIENT_STOP_SIZE - 1);
-
-    if (tvg::zero(inc)) {
-        auto color = _fixedPixel(fill, static_cast<int32_t>(t * FIXPT_SIZE));
+    _fillLinear(fill, y, x, len, [&](const uint32_t* src, uint32_t len) {
         if (a == 255) {
-            for (uint32_t i = 0; i < len; ++i, ++dst) {
-                auto tmp = op(color, *dst, a);
-                *dst = op2(tmp, *dst, 255);
-            }
-        } else {
-            for (uint32_t i = 0; i < len; ++i, ++dst) {
-                auto tmp = op(color, *dst, a);
-                auto tmp2 = op2(tmp, *dst, 255);
-                *dst = INTERPOLATE(tmp2, *dst, a);
-            }
-        }
-        return;
-    }
-
-    auto vMax = static_cast<float>(INT32_MAX >> (FIXPT_BITS + 1));
-    auto vMin = -vMax;
-    auto v = t + (inc * len);
-
-    if (a == 255) {
-        //we can use fixed point math
-        if (v < vMax && v > vMin) {
-            auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
-            auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-            for (uint32_t j = 0; j < len; ++j, ++dst) {
-                auto tmp = op(_fixedPixel(fill, t2), *dst, 255);
+            for (uint32_t i = 0; i < len; ++i, ++dst, ++src) {
+                auto tmp = op(*src, *dst, 255);
                 *dst = op2(tmp, *dst, 255);
-                t2 += inc2;
             }
-        //we have to fallback to float math
         } else {
-            uint32_t counter = 0;
-            while (counter++ < len) {
-                auto tmp = op(_pixel(fill, t / GRADIENT_STOP_SIZE), *dst, 255);
-                *dst = op2(tmp, *dst, 255);
-                ++dst;
-                t += inc;
-            }
-        }
-    } else {
-        //we can use fixed point math
-        if (v < vMax && v > vMin) {
-            auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
-            auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-            for (uint32_t j = 0; j < len; ++j, ++dst) {
-                auto tmp = op(_fixedPixel(fill, t2), *dst, 255);
+            for (uint32_t i = 0; i < len; ++i, ++dst, ++src) {
+                auto tmp = op(*src, *dst, 255);
                 auto tmp2 = op2(tmp, *dst, 255);
                 *dst = INTERPOLATE(tmp2, *dst, a);
-                t2 += inc2;
-            }
-        //we have to fallback to float math
-        } else {
-            uint32_t counter = 0;
-            while (counter++ < len) {
-                auto tmp = op(_pixel(fill, t / GRADIENT_STOP_SIZE), *dst, 255);
-                auto tmp2 = op2(tmp, *dst, 255);
-                *dst = INTERPOLATE(tmp2, *dst, a);
-                ++dst;
-                t += inc;
             }
         }
-    }
+    });
 }
 
 
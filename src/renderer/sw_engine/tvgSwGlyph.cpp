@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgSwCommon.h"
+#include "tvgInlist.h"
+#include "tvgLock.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#define GLYPH_MAX_SIZE 64                   //the larger glyphs are rasterized with their outlines
+#define GLYPH_CACHE_BYTES (1024 * 1024)     //the coverage budget of the cached glyphs
+#define GLYPH_BUCKETS 1024
+#define GLYPH_SUBPIXELS 4                   //the glyph positions are quantized to the quarter pixels
+
+struct SwGlyph
+{
+    INLIST_ITEM(SwGlyph);
+    SwGlyph* sibling;       //the next glyph in the same hash bucket
+    uint32_t font, id;
+    float sx, sy;           //the glyph scale
+    uint8_t fx, fy;         //the subpixel offset of the glyph origin
+    int32_t x, y;           //the image offset from the glyph origin
+    int32_t w, h;
+    uint8_t* coverage;      //w * h, 8-bit coverage
+    uint32_t refs = 0;      //the texts in progress referring this glyph, it is not evictable until they are done
+
+    ~SwGlyph()
+    {
+        tvg::free(coverage);
+    }
+};
+
+struct SwGlyphCache
+{
+    struct Placement
+    {
+        SwGlyph* glyph;
+        int32_t x, y;
+    };
+
+    //the working set of a text task, one per thread
+    struct Scratch
+    {
+        Array<Placement> placements;        //the glyph images of the current text
+        SwRle* rle = nullptr;               //the glyph rasterization buffer
+    };
+
+    Key key;                                //guards the glyphs, buckets and bytes
+    Inlist<SwGlyph> glyphs;                 //the most recently used one comes first
+    SwGlyph* buckets[GLYPH_BUCKETS] = {};
+    Scratch* scratches;
+    uint32_t scratchCnt;
+    uint32_t bytes = 0;
+
+    SwGlyphCache(uint32_t threads) : scratchCnt(threads + 1)
+    {
+        scratches = new Scratch[scratchCnt];
+    }
+
+    ~SwGlyphCache()
+    {
+        for (uint32_t i = 0; i < scratchCnt; ++i) rleFree(scratches[i].rle);
+        delete[](scratches);
+    }
+};
+
+
+static uint32_t _bucket(uint32_t font, uint32_t id, uint8_t fx, uint8_t fy)
+{
+    return ((font * 31 + id) * GLYPH_SUBPIXELS * GLYPH_SUBPIXELS + fx * GLYPH_SUBPIXELS + fy) % GLYPH_BUCKETS;
+}
+
+
+//must be called with the cache locked
+static void _evict(SwGlyphCache* cache)
+{
+    auto glyph = cache->glyphs.tail;
+    while (cache->bytes > GLYPH_CACHE_BYTES && glyph) {
+        auto prev = glyph->prev;
+        if (glyph->refs == 0) {
+            cache->glyphs.remove(glyph);
+            auto sibling = &cache->buckets[_bucket(glyph->font, glyph->id, glyph->fx, glyph->fy)];
+            while (*sibling != glyph) sibling = &(*sibling)->sibling;
+            *sibling = glyph->sibling;
+            cache->bytes -= glyph->w * glyph->h;
+            delete(glyph);
+        }
+        glyph = prev;
+    }
+}
+
+
+//must be called with the cache locked
+static SwGlyph* _find(SwGlyphCache* cache, uint32_t font, uint32_t id, const Matrix& transform, uint8_t fx, uint8_t fy)
+{
+    for (auto glyph = cache->buckets[_bucket(font, id, fx, fy)]; glyph; glyph = glyph->sibling) {
+        if (glyph->id != id || glyph->font != font || glyph->fx != fx || glyph->fy != fy) continue;
+        if (glyph->sx != transform.e11 || glyph->sy != transform.e22) continue;
+        cache->glyphs.remove(glyph);
+        cache->glyphs.front(glyph);
+        ++glyph->refs;
+        return glyph;
+    }
+    return nullptr;
+}
+
+
+static SwGlyph* _gen(SwGlyphCache::Scratch* scratch, const RenderShape* rshape, const RenderText::Glyph& layout, const PathCommand* cmds, const Point* pts, const Matrix& transform, uint8_t fx, uint8_t fy, SwMpool* mpool, unsigned tid)
+{
+    //the image bounds in the glyph space
+    auto ox = float(fx) / GLYPH_SUBPIXELS;
+    auto oy = float(fy) / GLYPH_SUBPIXELS;
+    auto min = Point{FLT_MAX, FLT_MAX};
+    auto max = Point{-FLT_MAX, -FLT_MAX};
+
+    for (auto pt = pts; pt < pts + layout.ptsCnt; ++pt) {
+        auto x = transform.e11 * (pt->x - layout.origin.x) + ox;
+        auto y = transform.e22 * (pt->y - layout.origin.y) + oy;
+        if (x < min.x) min.x = x;
+        if (x > max.x) max.x = x;
+        if (y < min.y) min.y = y;
+        if (y > max.y) max.y = y;
+    }
+
+    auto x = int32_t(floorf(min.x));
+    auto y = int32_t(floorf(min.y));
+    auto w = int32_t(ceilf(max.x)) - x;
+    auto h = int32_t(ceilf(max.y)) - y;
+
+    if (w > GLYPH_MAX_SIZE || h > GLYPH_MAX_SIZE) return nullptr;
+
+    uint8_t* coverage = nullptr;
+
+    if (w > 0 && h > 0) {
+        //rasterize the glyph outline onto its own image
+        Matrix m = {transform.e11, 0.0f, ox - transform.e11 * layout.origin.x - x, 0.0f, transform.e22, oy - transform.e22 * layout.origin.y - y, 0.0f, 0.0f, 1.0f};
+        auto outline = mpoolReqOutline(mpool, tid);
+        shapeGenOutline(*outline, cmds, layout.cmdCnt, pts, m);
+        outline->fillRule = rshape->rule;
+
+        rleReset(scratch->rle);
+        scratch->rle = rleRender(scratch->rle, outline, {{0, 0}, {w, h}}, true);
+        mpoolRetOutline(mpool, tid);
+        if (!scratch->rle) return nullptr;
+
+        coverage = tvg::calloc<uint8_t*>(w * h, 1);
+        if (!coverage) return nullptr;
+        ARRAY_FOREACH(span, scratch->rle->spans) {
+            memset(coverage + span->y * w + span->x, span->coverage, span->len);
+        }
+    } else {
+        w = h = 0;
+    }
+
+    auto glyph = new SwGlyph;
+    glyph->font = rshape->text->font;
+    glyph->id = layout.id;
+    glyph->sx = transform.e11;
+    glyph->sy = transform.e22;
+    glyph->fx = fx;
+    glyph->fy = fy;
+    glyph->x = x;
+    glyph->y = y;
+    glyph->w = w;
+    glyph->h = h;
+    glyph->coverage = coverage;
+
+    return glyph;
+}
+
+
+//returns the glyph referred by the caller, only the lookup and the insertion are locked
+static SwGlyph* _glyph(SwGlyphCache* cache, SwGlyphCache::Scratch* scratch, const RenderShape* rshape, const RenderText::Glyph& layout, const PathCommand* cmds, const Point* pts, const Matrix& transform, uint8_t fx, uint8_t fy, SwMpool* mpool, unsigned tid)
+{
+    auto font = rshape->text->font;
+
+    {
+        ScopedLock lock(cache->key);
+        if (auto glyph = _find(cache, font, layout.id, transform, fx, fy)) return glyph;
+    }
+
+    auto glyph = _gen(scratch, rshape, layout, cmds, pts, transform, fx, fy, mpool, tid);
+    if (!glyph) return nullptr;
+
+    ScopedLock lock(cache->key);
+
+    //another task might have generated the same one in the meantime
+    if (auto cached = _find(cache, font, layout.id, transform, fx, fy)) {
+        delete(glyph);
+        return cached;
+    }
+
+    auto& bucket = cache->buckets[_bucket(font, layout.id, fx, fy)];
+    glyph->sibling = bucket;
+    bucket = glyph;
+    glyph->refs = 1;
+    cache->glyphs.front(glyph);
+    cache->bytes += glyph->w * glyph->h;
+
+    return glyph;
+}
+
+
+//split the glyph position into the pixel and its quantized subpixel offset
+static void _position(float pos, int32_t& pixel, uint8_t& subpixel)
+{
+    auto floor = floorf(pos);
+    auto offset = int32_t(roundf((pos - floor) * GLYPH_SUBPIXELS));
+    pixel = int32_t(floor);
+    if (offset == GLYPH_SUBPIXELS) {
+        ++pixel;
+        offset = 0;
+    }
+    subpixel = uint8_t(offset);
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+SwGlyphCache* glyphCacheInit(uint32_t threads)
+{
+    return new SwGlyphCache(threads);
+}
+
+
+void glyphCacheTerm(SwGlyphCache* cache)
+{
+    delete(cache);
+}
+
+
+/* Composes the coverage of the text with the cached glyph images instead of scanning its whole outline.
+   Only the axis-aligned unstroked text with the small glyphs is eligible, the glyph positions are
+   quantized to the quarter pixels and the overlapped glyphs are accumulated rather than applying the fill rule. */
+bool glyphGenRle(SwShape* shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwGlyphCache* cache, SwMpool* mpool, unsigned tid)
+{
+    if (!cache || !rshape->text || rshape->text->glyphs.empty() || rshape->stroke) return false;
+    if (!tvg::zero(transform.e12) || !tvg::zero(transform.e21) || transform.e11 <= 0.0f || transform.e22 <= 0.0f) return false;
+
+    //the layout must describe the path as it is
+    uint32_t cmdCnt = 0, ptsCnt = 0;
+    ARRAY_FOREACH(p, rshape->text->glyphs) {
+        cmdCnt += p->cmdCnt;
+        ptsCnt += p->ptsCnt;
+    }
+    if (cmdCnt != rshape->path.cmds.count || ptsCnt != rshape->path.pts.count) return false;
+
+    auto scratch = cache->scratches + tid;
+    auto& placements = scratch->placements;
+    placements.clear();
+
+    RenderRegion bbox = {{INT32_MAX, INT32_MAX}, {INT32_MIN, INT32_MIN}};
+    auto cmds = rshape->path.cmds.data;
+    auto pts = rshape->path.pts.data;
+    auto ret = true;
+
+    ARRAY_FOREACH(p, rshape->text->glyphs) {
+        if (p->cmdCnt > 0) {
+            int32_t x, y;
+            uint8_t fx, fy;
+            _position(transform.e11 * p->origin.x + transform.e13, x, fx);
+            _position(transform.e22 * p->origin.y + transform.e23, y, fy);
+
+            auto glyph = _glyph(cache, scratch, rshape, *p, cmds, pts, transform, fx, fy, mpool, tid);
+            if (!glyph) {
+                ret = false;
+                break;
+            }
+            x += glyph->x;
+            y += glyph->y;
+            placements.push({glyph, x, y});
+            if (glyph->coverage) bbox.add({{x, y}, {x + glyph->w, y + glyph->h}});
+        }
+        cmds += p->cmdCnt;
+        pts += p->ptsCnt;
+    }
+
+    if (ret) {
+        bbox.intersect(clipBox);
+        ret = bbox.valid();
+    }
+
+    //accumulate the glyph images, then encode them to the spans
+    uint8_t* buffer = nullptr;
+    if (ret) {
+        buffer = static_cast<uint8_t*>(mpoolAlloc(mpool, tid, bbox.w() * bbox.h()));
+        ret = (buffer != nullptr);
+    }
+
+    if (ret) {
+        auto w = bbox.w();
+        auto h = bbox.h();
+        memset(buffer, 0, w * h);
+
+        ARRAY_FOREACH(p, placements) {
+            auto glyph = p->glyph;
+            if (!glyph->coverage) continue;
+            auto x0 = std::max(p->x, bbox.min.x);
+            auto y0 = std::max(p->y, bbox.min.y);
+            auto x1 = std::min(p->x + glyph->w, bbox.max.x);
+            auto y1 = std::min(p->y + glyph->h, bbox.max.y);
+            for (auto y = y0; y < y1; ++y) {
+                auto src = glyph->coverage + (y - p->y) * glyph->w + (x0 - p->x);
+                auto dst = buffer + (y - bbox.min.y) * w + (x0 - bbox.min.x);
+                for (auto x = x0; x < x1; ++x, ++src, ++dst) {
+                    auto sum = *dst + *src;
+                    *dst = sum > 255 ? 255 : uint8_t(sum);
+                }
+            }
+        }
+
+        if (!shape->rle) shape->rle = new SwRle;
+        else rleReset(shape->rle);
+
+        auto& spans = shape->rle->spans;
+        auto row = buffer;
+        for (uint32_t y = 0; y < h; ++y, row += w) {
+            uint32_t x = 0;
+            while (x < w) {
+                auto coverage = row[x];
+                if (coverage == 0) {
+                    ++x;
+                    continue;
+                }
+                auto begin = x;
+                while (++x < w && row[x] == coverage);
+                spans.push({uint16_t(bbox.min.x + begin), uint16_t(bbox.min.y + y), uint16_t(x - begin), coverage});
+            }
+        }
+
+        mpoolFree(mpool, tid, buffer, w * h);
+
+        shape->bbox = renderBox = bbox;
+    }
+
+    //the glyphs of this text are no longer referred
+    ScopedLock lock(cache->key);
+    ARRAY_FOREACH(p, placements) {
+        --p->glyph->refs;
+    }
+    _evict(cache);
+
+    return ret;
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgSwCommon.h"
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+#endif
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define SW_KERNEL_X86 1
+    void kernelSse41(SwKernels& kernels);
+    void kernelAvx2(SwKernels& kernels);
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #define SW_KERNEL_NEON 1
+    void kernelNeon(SwKernels& kernels);
+#endif
+
+
+template<typename PIXEL_T>
+static void _fill(PIXEL_T* dst, PIXEL_T val, uint32_t len)
+{
+    //fix the misaligned memory
+    auto alignOffset = (long long) dst % 8;
+    if (alignOffset > 0) {
+        if (sizeof(PIXEL_T) == 4) alignOffset /= 4;
+        else if (sizeof(PIXEL_T) == 1) alignOffset = 8 - alignOffset;
+        while (alignOffset > 0 && len > 0) {
+            *dst++ = val;
+            --len;
+            --alignOffset;
+        }
+    }
+
+    //64bits faster clear
+    if ((sizeof(PIXEL_T) == 4)) {
+        auto val64 = (uint64_t(val) << 32) | uint64_t(val);
+        while (len > 1) {
+            *reinterpret_cast<uint64_t*>(dst) = val64;
+            len -= 2;
+            dst += 2;
+        }
+    } else if (sizeof(PIXEL_T) == 1) {
+        auto val32 = (uint32_t(val) << 24) | (uint32_t(val) << 16) | (uint32_t(val) << 8) | uint32_t(val);
+        auto val64 = (uint64_t(val32) << 32) | val32;
+        while (len > 7) {
+            *reinterpret_cast<uint64_t*>(dst) = val64;
+            len -= 8;
+            dst += 8;
+        }
+    }
+
+    //leftovers
+    while (len--) *dst++ = val;
+}
+
+
+static void _fill32(uint32_t* dst, uint32_t val, uint32_t len)
+{
+    _fill(dst, val, len);
+}
+
+
+static void _fill8(uint8_t* dst, uint8_t val, uint32_t len)
+{
+    _fill(dst, val, len);
+}
+
+
+static void _translucentColor(uint32_t* dst, uint32_t color, uint32_t len)
+{
+    auto ialpha = IA(color);
+    for (uint32_t x = 0; x < len; ++x, ++dst) {
+        *dst = color + ALPHA_BLEND(*dst, ialpha);
+    }
+}
+
+
+static void _translucentPixels(uint32_t* dst, const uint32_t* src, uint32_t len, uint8_t opacity)
+{
+    if (opacity == 255) {
+        for (uint32_t x = 0; x < len; ++x, ++dst, ++src) {
+            *dst = *src + ALPHA_BLEND(*dst, IA(*src));
+        }
+    } else {
+        for (uint32_t x = 0; x < len; ++x, ++dst, ++src) {
+            auto tmp = ALPHA_BLEND(*src, opacity);
+            *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+        }
+    }
+}
+
+
+static void _mattedColor(uint32_t* dst, uint32_t color, const uint8_t* cmp, uint32_t len, uint8_t csize, bool inverse)
+{
+    auto mask = inverse ? 0xff : 0x00;
+    for (uint32_t x = 0; x < len; ++x, ++dst, cmp += csize) {
+        auto tmp = ALPHA_BLEND(color, *cmp ^ mask);
+        *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+    }
+}
+
+
+static void _mattedPixels(uint32_t* dst, const uint32_t* src, const uint8_t* cmp, uint32_t len, uint8_t csize, uint8_t opacity, bool inverse)
+{
+    auto mask = inverse ? 0xff : 0x00;
+    if (opacity == 255) {
+        for (uint32_t x = 0; x < len; ++x, ++dst, ++src, cmp += csize) {
+            auto tmp = ALPHA_BLEND(*src, *cmp ^ mask);
+            *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+        }
+    } else {
+        for (uint32_t x = 0; x < len; ++x, ++dst, ++src, cmp += csize) {
+            auto tmp = ALPHA_BLEND(*src, MULTIPLY(opacity, *cmp ^ mask));
+            *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+        }
+    }
+}
+
+
+static void _luma(uint8_t* dst, const uint32_t* src, uint32_t len, bool abgr, bool inverse)
+{
+    auto w0 = abgr ? 54 : 19;   //0.2126*R + 0.7152*G + 0.0722*B
+    auto w2 = abgr ? 19 : 54;
+    auto mask = inverse ? 0xff : 0x00;
+    for (uint32_t x = 0; x < len; ++x, ++dst, ++src) {
+        auto v = *src;
+        *dst = ((((v & 0xff) * w0) + (((v >> 8) & 0xff) * 182) + (((v >> 16) & 0xff) * w2)) >> 8) ^ mask;
+    }
+}
+
+
+static void _premultiply(uint32_t* buffer, uint32_t len)
+{
+    for (uint32_t x = 0; x < len; ++x, ++buffer) {
+        if (A(*buffer) < 255) *buffer = PREMULTIPLY(*buffer);
+    }
+}
+
+
+static void _unpremultiply(uint32_t* buffer, uint32_t len)
+{
+    for (uint32_t x = 0; x < len; ++x, ++buffer) {
+        *buffer = rasterUnpremultiply(*buffer);
+    }
+}
+
+
+static void _swapRB(uint32_t* buffer, uint32_t len)
+{
+    //64bits faster converting
+    auto dst = buffer;
+    for (uint32_t x = 0; x < len / 2; ++x, dst += 2) {
+        uint64_t c;
+        memcpy(&c, dst, sizeof(c));
+        c = (c & 0xff00ff00ff00ff00) + ((c & 0x00ff000000ff0000) >> 16) + ((c & 0x000000ff000000ff) << 16);
+        memcpy(dst, &c, sizeof(c));
+    }
+    //leftover
+    if (len % 2) {
+        auto c = *dst;
+        *dst = (c & 0xff00ff00) + ((c & 0x00ff0000) >> 16) + ((c & 0x000000ff) << 16);
+    }
+}
+
+
+template<FillSpread SPREAD>
+static void _linear(const uint32_t* ctable, uint32_t* dst, int32_t t, int32_t inc, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; ++i, ++dst, t += inc) {
+        *dst = ctable[fillClamp<SPREAD>((t + (FIXPT_SIZE / 2)) >> FIXPT_BITS)];
+    }
+}
+
+
+template<FillSpread SPREAD>
+static void _radial(const uint32_t* ctable, uint32_t* dst, float& b, float deltaB, float& det, float& deltaDet, float deltaDeltaDet, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; ++i, ++dst) {
+        *dst = ctable[fillClamp<SPREAD>(static_cast<int32_t>((sqrtf(det) - b) * (GRADIENT_STOP_SIZE - 1) + 0.5f))];
+        det += deltaDet;
+        deltaDet += deltaDeltaDet;
+        b += deltaB;
+    }
+}
+
+
+
+static void _boxBlur(uint32_t* dst, const uint32_t* in, const uint32_t* out, uint32_t len, int32_t* acc, float iarr)
+{
+    for (uint32_t i = 0; i < len; ++i) {
+        auto s = reinterpret_cast<const uint8_t*>(in + i);
+        auto e = reinterpret_cast<const uint8_t*>(out + i);
+        auto d = reinterpret_cast<uint8_t*>(dst + i);
+        for (int c = 0; c < 4; ++c) {
+            acc[c] += s[c] - e[c];
+            d[c] = static_cast<uint8_t>(acc[c] * iarr);
+        }
+    }
+}
+
+
+static void _shadowBlur(uint32_t* dst, const uint32_t* in, const uint32_t* out, uint32_t len, int32_t& acc, uint32_t color, float iarr)
+{
+    for (uint32_t i = 0; i < len; ++i) {
+        acc += A(in[i]) - A(out[i]);
+        dst[i] = ALPHA_BLEND(color, static_cast<uint8_t>(acc * iarr));
+    }
+}
+
+
+static void _transpose(uint32_t* dst, int32_t dstride, const uint32_t* src, int32_t sstride, int32_t w, int32_t h)
+{
+    for (int32_t x = 0; x < w; ++x, dst += dstride) {
+        auto p = src + x;
+        for (int32_t y = 0; y < h; ++y, p += sstride) {
+            dst[y] = *p;
+        }
+    }
+}
+
+#ifdef SW_KERNEL_X86
+
+static void _cpuFeatures(bool& sse41, bool& avx2)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    auto ids = info[0];
+    __cpuid(info, 1);
+    sse41 = (info[2] & (1 << 19)) != 0;
+    //the os must save the ymm registers as well
+    auto ymm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 0x6) == 0x6);
+    avx2 = false;
+    if (ids >= 7 && ymm) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    sse41 = __builtin_cpu_supports("sse4.1");
+    avx2 = __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+const SwKernels swScalarKernels = {
+    _fill32, _fill8, _translucentColor, _translucentPixels, _mattedColor, _mattedPixels, _luma, _premultiply, _unpremultiply, _swapRB,
+    {_linear<FillSpread::Pad>, _linear<FillSpread::Reflect>, _linear<FillSpread::Repeat>},
+    {_radial<FillSpread::Pad>, _radial<FillSpread::Reflect>, _radial<FillSpread::Repeat>},
+    _boxBlur, _shadowBlur, _transpose,
+    "C"
+};
+
+SwKernels swKernels = swScalarKernels;
+
+
+void kernelInit()
+{
+    swKernels = swScalarKernels;
+
+#if defined(SW_KERNEL_X86)
+    bool sse41, avx2;
+    _cpuFeatures(sse41, avx2);
+    //avx2 implies sse4.1, it overrides the kernels it has the better version of
+    if (sse41) kernelSse41(swKernels);
+    if (avx2) kernelAvx2(swKernels);
+#elif defined(SW_KERNEL_NEON)
+    kernelNeon(swKernels);
+#endif
+    TVGLOG("SW_ENGINE", "Pixel Kernels = %s", swKernels.name);
+}
@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgSwCommon.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <immintrin.h>
+
+//compiled in regardless of the build flags, the engine selects it only if the cpu supports it.
+#if defined(__GNUC__) || defined(__clang__)
+    #define AVX2 __attribute__((target("avx2")))
+#else
+    #define AVX2
+#endif
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+//per channel (c * m) >> 8, m is the 32bits vector of the 9bits multipliers of eight pixels
+AVX2 static inline __m256i _scale(__m256i c, __m256i m)
+{
+    //the unpacking and shuffling work on each 128bits lane
+    const auto zero = _mm256_setzero_si256();
+    const auto lo = _mm256_setr_epi8(0, 1, 0, 1, 0, 1, 0, 1, 4, 5, 4, 5, 4, 5, 4, 5, 0, 1, 0, 1, 0, 1, 0, 1, 4, 5, 4, 5, 4, 5, 4, 5);
+    const auto hi = _mm256_setr_epi8(8, 9, 8, 9, 8, 9, 8, 9, 12, 13, 12, 13, 12, 13, 12, 13, 8, 9, 8, 9, 8, 9, 8, 9, 12, 13, 12, 13, 12, 13, 12, 13);
+    auto l = _mm256_mullo_epi16(_mm256_unpacklo_epi8(c, zero), _mm256_shuffle_epi8(m, lo));
+    auto h = _mm256_mullo_epi16(_mm256_unpackhi_epi8(c, zero), _mm256_shuffle_epi8(m, hi));
+    return _mm256_packus_epi16(_mm256_srli_epi16(l, 8), _mm256_srli_epi16(h, 8));
+}
+
+
+//ALPHA_BLEND() with the individual alpha of eight pixels
+AVX2 static inline __m256i _blend(__m256i c, __m256i a)
+{
+    return _scale(c, _mm256_add_epi32(a, _mm256_set1_epi32(1)));
+}
+
+
+//s + ALPHA_BLEND(d, IA(s))
+AVX2 static inline __m256i _over(__m256i s, __m256i d)
+{
+    auto ia = _mm256_xor_si256(_mm256_srli_epi32(s, 24), _mm256_set1_epi32(0xff));
+    return _mm256_add_epi32(s, _blend(d, ia));
+}
+
+
+//MULTIPLY() of the 8bits values in 32bits lanes
+AVX2 static inline __m256i _multiply(__m256i a, __m256i b)
+{
+    return _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi16(a, b), _mm256_set1_epi32(0xff)), 8);
+}
+
+
+//the compositor alpha of eight pixels, the channel size is either 1 or 4 bytes
+AVX2 static inline __m256i _alpha(const uint8_t* cmp, uint8_t csize, __m256i mask)
+{
+    __m256i a;
+    if (csize == sizeof(uint8_t)) {
+        a = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)cmp));
+    } else {
+        a = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)cmp), _mm256_set1_epi32(0xff));
+    }
+    return _mm256_xor_si256(a, mask);
+}
+
+
+AVX2 static void _fill32(uint32_t* dst, uint32_t val, uint32_t len)
+{
+    auto v = _mm256_set1_epi32(val);
+
+    for (; len >= 8; len -= 8, dst += 8) {
+        _mm256_storeu_si256((__m256i*)dst, v);
+    }
+
+    //leftovers
+    while (len--) *dst++ = val;
+}
+
+
+AVX2 static void _fill8(uint8_t* dst, uint8_t val, uint32_t len)
+{
+    auto v = _mm256_set1_epi8(val);
+
+    for (; len >= 32; len -= 32, dst += 32) {
+        _mm256_storeu_si256((__m256i*)dst, v);
+    }
+
+    //leftovers
+    while (len--) *dst++ = val;
+}
+
+
+AVX2 static void _translucentColor(uint32_t* dst, uint32_t color, uint32_t len)
+{
+    auto c = _mm256_set1_epi32(color);
+    auto ia = _mm256_set1_epi32(IA(color) + 1);
+
+    for (; len >= 8; len -= 8, dst += 8) {
+        auto d = _mm256_loadu_si256((const __m256i*)dst);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_add_epi32(c, _scale(d, ia)));
+    }
+
+    //leftovers
+    auto ialpha = IA(color);
+    for (; len > 0; --len, ++dst) {
+        *dst = color + ALPHA_BLEND(*dst, ialpha);
+    }
+}
+
+
+AVX2 static void _translucentPixels(uint32_t* dst, const uint32_t* src, uint32_t len, uint8_t opacity)
+{
+    auto a = _mm256_set1_epi32(opacity);
+
+    for (; len >= 8; len -= 8, dst += 8, src += 8) {
+        auto s = _mm256_loadu_si256((const __m256i*)src);
+        if (opacity < 255) s = _blend(s, a);
+        _mm256_storeu_si256((__m256i*)dst, _over(s, _mm256_loadu_si256((const __m256i*)dst)));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, ++src) {
+        auto tmp = (opacity < 255) ? ALPHA_BLEND(*src, opacity) : *src;
+        *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+    }
+}
+
+
+AVX2 static void _mattedColor(uint32_t* dst, uint32_t color, const uint8_t* cmp, uint32_t len, uint8_t csize, bool inverse)
+{
+    auto c = _mm256_set1_epi32(color);
+    auto mask = _mm256_set1_epi32(inverse ? 0xff : 0);
+
+    for (; len >= 8; len -= 8, dst += 8, cmp += 8 * csize) {
+        auto tmp = _blend(c, _alpha(cmp, csize, mask));
+        _mm256_storeu_si256((__m256i*)dst, _over(tmp, _mm256_loadu_si256((const __m256i*)dst)));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, cmp += csize) {
+        auto tmp = ALPHA_BLEND(color, *cmp ^ (inverse ? 0xff : 0));
+        *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+    }
+}
+
+
+AVX2 static void _mattedPixels(uint32_t* dst, const uint32_t* src, const uint8_t* cmp, uint32_t len, uint8_t csize, uint8_t opacity, bool inverse)
+{
+    auto o = _mm256_set1_epi32(opacity);
+    auto mask = _mm256_set1_epi32(inverse ? 0xff : 0);
+
+    for (; len >= 8; len -= 8, dst += 8, src += 8, cmp += 8 * csize) {
+        auto a = _alpha(cmp, csize, mask);
+        if (opacity < 255) a = _multiply(o, a);
+        auto tmp = _blend(_mm256_loadu_si256((const __m256i*)src), a);
+        _mm256_storeu_si256((__m256i*)dst, _over(tmp, _mm256_loadu_si256((const __m256i*)dst)));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, ++src, cmp += csize) {
+        auto a = *cmp ^ (inverse ? 0xff : 0);
+        auto tmp = ALPHA_BLEND(*src, (opacity < 255) ? MULTIPLY(opacity, a) : a);
+        *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+    }
+}
+
+
+//the weighted sum of the three channels in 32bits lanes, the weights sum up to 255 so that the products fit in 16bits
+AVX2 static inline __m256i _luma(__m256i c, __m256i w0, __m256i w2)
+{
+    const auto ff = _mm256_set1_epi32(0xff);
+    auto l = _mm256_mullo_epi16(_mm256_and_si256(c, ff), w0);
+    l = _mm256_add_epi32(l, _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(c, 8), ff), _mm256_set1_epi32(182)));
+    l = _mm256_add_epi32(l, _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(c, 16), ff), w2));
+    return _mm256_srli_epi32(l, 8);
+}
+
+
+AVX2 static void _luma(uint8_t* dst, const uint32_t* src, uint32_t len, bool abgr, bool inverse)
+{
+    auto w0 = _mm256_set1_epi32(abgr ? 54 : 19);
+    auto w2 = _mm256_set1_epi32(abgr ? 19 : 54);
+    auto mask = _mm256_set1_epi8(inverse ? 0xff : 0);
+    //the packings interleave the 128bits lanes, put the 32bits groups back in order
+    const auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    for (; len >= 32; len -= 32, dst += 32, src += 32) {
+        auto l0 = _luma(_mm256_loadu_si256((const __m256i*)src), w0, w2);
+        auto l1 = _luma(_mm256_loadu_si256((const __m256i*)(src + 8)), w0, w2);
+        auto l2 = _luma(_mm256_loadu_si256((const __m256i*)(src + 16)), w0, w2);
+        auto l3 = _luma(_mm256_loadu_si256((const __m256i*)(src + 24)), w0, w2);
+        auto l = _mm256_packus_epi16(_mm256_packus_epi32(l0, l1), _mm256_packus_epi32(l2, l3));
+        l = _mm256_permutevar8x32_epi32(l, order);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_xor_si256(l, mask));
+    }
+
+    //leftovers
+    auto iw0 = abgr ? 54 : 19;
+    auto iw2 = abgr ? 19 : 54;
+    for (; len > 0; --len, ++dst, ++src) {
+        auto v = *src;
+        *dst = ((((v & 0xff) * iw0) + (((v >> 8) & 0xff) * 182) + (((v >> 16) & 0xff) * iw2)) >> 8) ^ (inverse ? 0xff : 0);
+    }
+}
+
+
+AVX2 static void _premultiply(uint32_t* buffer, uint32_t len)
+{
+    const auto ff = _mm256_set1_epi32(0xff);
+    const auto amask = _mm256_set1_epi32(0xff000000);
+
+    for (; len >= 8; len -= 8, buffer += 8) {
+        auto c = _mm256_loadu_si256((const __m256i*)buffer);
+        auto a = _mm256_srli_epi32(c, 24);
+        auto opaque = _mm256_cmpeq_epi32(a, ff);
+        if (_mm256_movemask_epi8(opaque) == -1) continue;
+        auto p = _mm256_or_si256(_mm256_andnot_si256(amask, _scale(c, a)), _mm256_and_si256(c, amask));
+        _mm256_storeu_si256((__m256i*)buffer, _mm256_blendv_epi8(p, c, opaque));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++buffer) {
+        if (A(*buffer) < 255) *buffer = PREMULTIPLY(*buffer);
+    }
+}
+
+
+//C * 255 / a, the float division is exact enough to truncate to the integer division
+AVX2 static inline __m256i _divide(__m256i c, __m256 a, int shift)
+{
+    auto v = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(c, shift), _mm256_set1_epi32(0xff)));
+    v = _mm256_div_ps(_mm256_mul_ps(v, _mm256_set1_ps(255.0f)), a);
+    return _mm256_slli_epi32(_mm256_and_si256(_mm256_cvttps_epi32(v), _mm256_set1_epi32(0xff)), shift);
+}
+
+
+AVX2 static void _unpremultiply(uint32_t* buffer, uint32_t len)
+{
+    const auto ff = _mm256_set1_epi32(0xff);
+
+    for (; len >= 8; len -= 8, buffer += 8) {
+        auto c = _mm256_loadu_si256((const __m256i*)buffer);
+        auto a = _mm256_srli_epi32(c, 24);
+        auto keep = _mm256_or_si256(_mm256_cmpeq_epi32(a, _mm256_setzero_si256()), _mm256_cmpeq_epi32(a, ff));
+        if (_mm256_movemask_epi8(keep) == -1) continue;
+        auto fa = _mm256_cvtepi32_ps(_mm256_blendv_epi8(a, ff, keep));   //no division by zero
+        auto p = _mm256_and_si256(c, _mm256_set1_epi32(0xff000000));
+        p = _mm256_or_si256(p, _divide(c, fa, 16));
+        p = _mm256_or_si256(p, _divide(c, fa, 8));
+        p = _mm256_or_si256(p, _divide(c, fa, 0));
+        _mm256_storeu_si256((__m256i*)buffer, _mm256_blendv_epi8(p, c, keep));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++buffer) {
+        *buffer = rasterUnpremultiply(*buffer);
+    }
+}
+
+
+AVX2 static void _swapRB(uint32_t* buffer, uint32_t len)
+{
+    const auto swap = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    for (; len >= 8; len -= 8, buffer += 8) {
+        auto c = _mm256_loadu_si256((const __m256i*)buffer);
+        _mm256_storeu_si256((__m256i*)buffer, _mm256_shuffle_epi8(c, swap));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++buffer) {
+        auto c = *buffer;
+        *buffer = (c & 0xff00ff00) + ((c & 0x00ff0000) >> 16) + ((c & 0x000000ff) << 16);
+    }
+}
+
+
+//the color table indices of the gradient positions
+template<FillSpread SPREAD>
+AVX2 static inline __m256i _clamp(__m256i pos)
+{
+    if (SPREAD == FillSpread::Pad) {
+        return _mm256_min_epi32(_mm256_max_epi32(pos, _mm256_setzero_si256()), _mm256_set1_epi32(GRADIENT_STOP_SIZE - 1));
+    } else if (SPREAD == FillSpread::Repeat) {
+        return _mm256_and_si256(pos, _mm256_set1_epi32(GRADIENT_STOP_SIZE - 1));
+    }
+    //reflect: the second half is mirrored, (limit - pos - 1) is identical to (pos ^ (limit - 1))
+    auto limit = _mm256_set1_epi32(GRADIENT_STOP_SIZE * 2 - 1);
+    pos = _mm256_and_si256(pos, limit);
+    auto mirror = _mm256_cmpgt_epi32(pos, _mm256_set1_epi32(GRADIENT_STOP_SIZE - 1));
+    return _mm256_xor_si256(pos, _mm256_and_si256(mirror, limit));
+}
+
+
+AVX2 static inline void _lookup(const uint32_t* ctable, __m256i idx, uint32_t* dst)
+{
+    _mm256_storeu_si256((__m256i*)dst, _mm256_i32gather_epi32((const int*)ctable, idx, sizeof(uint32_t)));
+}
+
+
+template<FillSpread SPREAD>
+AVX2 static void _linear(const uint32_t* ctable, uint32_t* dst, int32_t t, int32_t inc, uint32_t len)
+{
+    if (len >= 8) {
+        auto pos = _mm256_add_epi32(_mm256_set1_epi32(t + FIXPT_SIZE / 2), _mm256_mullo_epi32(_mm256_set1_epi32(inc), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+        auto step = _mm256_set1_epi32(inc * 8);
+        for (; len >= 8; len -= 8, dst += 8, t += inc * 8) {
+            _lookup(ctable, _clamp<SPREAD>(_mm256_srai_epi32(pos, FIXPT_BITS)), dst);
+            pos = _mm256_add_epi32(pos, step);
+        }
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, t += inc) {
+        *dst = ctable[fillClamp<SPREAD>((t + (FIXPT_SIZE / 2)) >> FIXPT_BITS)];
+    }
+}
+
+
+template<FillSpread SPREAD>
+AVX2 static void _radial(const uint32_t* ctable, uint32_t* dst, float& b, float deltaB, float& det, float& deltaDet, float deltaDeltaDet, uint32_t len)
+{
+    //work on the local copies, the references would be reloaded at every step
+    auto d = det, dd = deltaDet, bb = b;
+
+    for (; len >= 8; len -= 8, dst += 8) {
+        //keep the forward differencing sequential, the roots are identical to the scalar ones
+        auto d0 = d; d += dd; dd += deltaDeltaDet;
+        auto d1 = d; d += dd; dd += deltaDeltaDet;
+        auto d2 = d; d += dd; dd += deltaDeltaDet;
+        auto d3 = d; d += dd; dd += deltaDeltaDet;
+        auto d4 = d; d += dd; dd += deltaDeltaDet;
+        auto d5 = d; d += dd; dd += deltaDeltaDet;
+        auto d6 = d; d += dd; dd += deltaDeltaDet;
+        auto d7 = d; d += dd; dd += deltaDeltaDet;
+        auto b0 = bb; bb += deltaB;
+        auto b1 = bb; bb += deltaB;
+        auto b2 = bb; bb += deltaB;
+        auto b3 = bb; bb += deltaB;
+        auto b4 = bb; bb += deltaB;
+        auto b5 = bb; bb += deltaB;
+        auto b6 = bb; bb += deltaB;
+        auto b7 = bb; bb += deltaB;
+        auto pos = _mm256_sub_ps(_mm256_sqrt_ps(_mm256_setr_ps(d0, d1, d2, d3, d4, d5, d6, d7)), _mm256_setr_ps(b0, b1, b2, b3, b4, b5, b6, b7));
+        pos = _mm256_add_ps(_mm256_mul_ps(pos, _mm256_set1_ps(GRADIENT_STOP_SIZE - 1)), _mm256_set1_ps(0.5f));
+        _lookup(ctable, _clamp<SPREAD>(_mm256_cvttps_epi32(pos)), dst);
+    }
+
+    //leftovers
+    det = d;
+    deltaDet = dd;
+    b = bb;
+
+    for (; len > 0; --len, ++dst) {
+        *dst = ctable[fillClamp<SPREAD>(static_cast<int32_t>((sqrtf(det) - b) * (GRADIENT_STOP_SIZE - 1) + 0.5f))];
+        det += deltaDet;
+        deltaDet += deltaDeltaDet;
+        b += deltaB;
+    }
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+void kernelAvx2(SwKernels& kernels)
+{
+    kernels.fill32 = _fill32;
+    kernels.fill8 = _fill8;
+    kernels.translucentColor = _translucentColor;
+    kernels.translucentPixels = _translucentPixels;
+    kernels.mattedColor = _mattedColor;
+    kernels.mattedPixels = _mattedPixels;
+    kernels.luma = _luma;
+    kernels.premultiply = _premultiply;
+    kernels.unpremultiply = _unpremultiply;
+    kernels.swapRB = _swapRB;
+    kernels.linear[static_cast<int>(FillSpread::Pad)] = _linear<FillSpread::Pad>;
+    kernels.linear[static_cast<int>(FillSpread::Reflect)] = _linear<FillSpread::Reflect>;
+    kernels.linear[static_cast<int>(FillSpread::Repeat)] = _linear<FillSpread::Repeat>;
+    kernels.radial[static_cast<int>(FillSpread::Pad)] = _radial<FillSpread::Pad>;
+    kernels.radial[static_cast<int>(FillSpread::Reflect)] = _radial<FillSpread::Reflect>;
+    kernels.radial[static_cast<int>(FillSpread::Repeat)] = _radial<FillSpread::Repeat>;
+    kernels.name = "AVX2";
+}
+
+#endif
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgSwCommon.h"
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    #define SW_NEON_AARCH64 1
+#endif
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+//per channel (c * m) >> 8, m is the 32bits vector of the 9bits multipliers of four pixels
+static inline uint32x4_t _scale(uint32x4_t c, uint32x4_t m)
+{
+    auto c8 = vreinterpretq_u8_u32(c);
+    auto m2 = vzip_u16(vmovn_u32(m), vmovn_u32(m));     //[m0 m0 m1 m1], [m2 m2 m3 m3]
+    auto lo = vzip_u16(m2.val[0], m2.val[0]);           //[m0 m0 m0 m0], [m1 m1 m1 m1]
+    auto hi = vzip_u16(m2.val[1], m2.val[1]);           //[m2 m2 m2 m2], [m3 m3 m3 m3]
+    auto l = vmulq_u16(vmovl_u8(vget_low_u8(c8)), vcombine_u16(lo.val[0], lo.val[1]));
+    auto h = vmulq_u16(vmovl_u8(vget_high_u8(c8)), vcombine_u16(hi.val[0], hi.val[1]));
+    return vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(l, 8), vshrn_n_u16(h, 8)));
+}
+
+
+//ALPHA_BLEND() with the individual alpha of four pixels
+static inline uint32x4_t _blend(uint32x4_t c, uint32x4_t a)
+{
+    return _scale(c, vaddq_u32(a, vdupq_n_u32(1)));
+}
+
+
+//s + ALPHA_BLEND(d, IA(s))
+static inline uint32x4_t _over(uint32x4_t s, uint32x4_t d)
+{
+    auto ia = veorq_u32(vshrq_n_u32(s, 24), vdupq_n_u32(0xff));
+    return vaddq_u32(s, _blend(d, ia));
+}
+
+
+//MULTIPLY() of the 8bits values in 32bits lanes
+static inline uint32x4_t _multiply(uint32x4_t a, uint32x4_t b)
+{
+    return vshrq_n_u32(vaddq_u32(vmulq_u32(a, b), vdupq_n_u32(0xff)), 8);
+}
+
+
+//the compositor alpha of four pixels, the channel size is either 1 or 4 bytes
+static inline uint32x4_t _alpha(const uint8_t* cmp, uint8_t csize, uint32x4_t mask)
+{
+    uint32x4_t a;
+    if (csize == sizeof(uint8_t)) {
+        uint32_t v;
+        memcpy(&v, cmp, sizeof(v));
+        a = vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(v))));
+    } else {
+        a = vandq_u32(vreinterpretq_u32_u8(vld1q_u8(cmp)), vdupq_n_u32(0xff));
+    }
+    return veorq_u32(a, mask);
+}
+
+
+static inline bool _all(uint32x4_t mask)
+{
+#ifdef SW_NEON_AARCH64
+    return vminvq_u32(mask) == 0xffffffff;
+#else
+    auto m = vand_u32(vget_low_u32(mask), vget_high_u32(mask));
+    return (vget_lane_u32(m, 0) & vget_lane_u32(m, 1)) == 0xffffffff;
+#endif
+}
+
+
+static void _fill32(uint32_t* dst, uint32_t val, uint32_t len)
+{
+    auto v = vdupq_n_u32(val);
+
+    for (; len >= 4; len -= 4, dst += 4) {
+        vst1q_u32(dst, v);
+    }
+
+    //leftovers
+    while (len--) *dst++ = val;
+}
+
+
+static void _fill8(uint8_t* dst, uint8_t val, uint32_t len)
+{
+    auto v = vdupq_n_u8(val);
+
+    for (; len >= 16; len -= 16, dst += 16) {
+        vst1q_u8(dst, v);
+    }
+
+    //leftovers
+    while (len--) *dst++ = val;
+}
+
+
+static void _translucentColor(uint32_t* dst, uint32_t color, uint32_t len)
+{
+    auto c = vdupq_n_u32(color);
+    auto ia = vdupq_n_u32(IA(color) + 1);
+
+    for (; len >= 4; len -= 4, dst += 4) {
+        vst1q_u32(dst, vaddq_u32(c, _scale(vld1q_u32(dst), ia)));
+    }
+
+    //leftovers
+    auto ialpha = IA(color);
+    for (; len > 0; --len, ++dst) {
+        *dst = color + ALPHA_BLEND(*dst, ialpha);
+    }
+}
+
+
+static void _translucentPixels(uint32_t* dst, const uint32_t* src, uint32_t len, uint8_t opacity)
+{
+    auto a = vdupq_n_u32(opacity);
+
+    for (; len >= 4; len -= 4, dst += 4, src += 4) {
+        auto s = vld1q_u32(src);
+        if (opacity < 255) s = _blend(s, a);
+        vst1q_u32(dst, _over(s, vld1q_u32(dst)));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, ++src) {
+        auto tmp = (opacity < 255) ? ALPHA_BLEND(*src, opacity) : *src;
+        *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+    }
+}
+
+
+static void _mattedColor(uint32_t* dst, uint32_t color, const uint8_t* cmp, uint32_t len, uint8_t csize, bool inverse)
+{
+    auto c = vdupq_n_u32(color);
+    auto mask = vdupq_n_u32(inverse ? 0xff : 0);
+
+    for (; len >= 4; len -= 4, dst += 4, cmp += 4 * csize) {
+        auto tmp = _blend(c, _alpha(cmp, csize, mask));
+        vst1q_u32(dst, _over(tmp, vld1q_u32(dst)));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, cmp += csize) {
+        auto tmp = ALPHA_BLEND(color, *cmp ^ (inverse ? 0xff : 0));
+        *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+    }
+}
+
+
+static void _mattedPixels(uint32_t* dst, const uint32_t* src, const uint8_t* cmp, uint32_t len, uint8_t csize, uint8_t opacity, bool inverse)
+{
+    auto o = vdupq_n_u32(opacity);
+    auto mask = vdupq_n_u32(inverse ? 0xff : 0);
+
+    for (; len >= 4; len -= 4, dst += 4, src += 4, cmp += 4 * csize) {
+        auto a = _alpha(cmp, csize, mask);
+        if (opacity < 255) a = _multiply(o, a);
+        auto tmp = _blend(vld1q_u32(src), a);
+        vst1q_u32(dst, _over(tmp, vld1q_u32(dst)));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, ++src, cmp += csize) {
+        auto a = *cmp ^ (inverse ? 0xff : 0);
+        auto tmp = ALPHA_BLEND(*src, (opacity < 255) ? MULTIPLY(opacity, a) : a);
+        *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+    }
+}
+
+
+static void _luma(uint8_t* dst, const uint32_t* src, uint32_t len, bool abgr, bool inverse)
+{
+    auto w0 = vdup_n_u8(abgr ? 54 : 19);
+    auto w1 = vdup_n_u8(182);
+    auto w2 = vdup_n_u8(abgr ? 19 : 54);
+    auto mask = vdupq_n_u8(inverse ? 0xff : 0);
+
+    //the weights sum up to 255, the weighted sums fit in 16bits
+    for (; len >= 16; len -= 16, dst += 16, src += 16) {
+        auto c = vld4q_u8((const uint8_t*)src);
+        auto l = vmlal_u8(vmlal_u8(vmull_u8(vget_low_u8(c.val[0]), w0), vget_low_u8(c.val[1]), w1), vget_low_u8(c.val[2]), w2);
+        auto h = vmlal_u8(vmlal_u8(vmull_u8(vget_high_u8(c.val[0]), w0), vget_high_u8(c.val[1]), w1), vget_high_u8(c.val[2]), w2);
+        vst1q_u8(dst, veorq_u8(vcombine_u8(vshrn_n_u16(l, 8), vshrn_n_u16(h, 8)), mask));
+    }
+
+    //leftovers
+    auto iw0 = abgr ? 54 : 19;
+    auto iw2 = abgr ? 19 : 54;
+    for (; len > 0; --len, ++dst, ++src) {
+        auto v = *src;
+        *dst = ((((v & 0xff) * iw0) + (((v >> 8) & 0xff) * 182) + (((v >> 16) & 0xff) * iw2)) >> 8) ^ (inverse ? 0xff : 0);
+    }
+}
+
+
+static void _premultiply(uint32_t* buffer, uint32_t len)
+{
+    const auto ff = vdupq_n_u32(0xff);
+    const auto amask = vdupq_n_u32(0xff000000);
+
+    for (; len >= 4; len -= 4, buffer += 4) {
+        auto c = vld1q_u32(buffer);
+        auto a = vshrq_n_u32(c, 24);
+        auto opaque = vceqq_u32(a, ff);
+        if (_all(opaque)) continue;
+        auto p = vbslq_u32(amask, c, _scale(c, a));
+        vst1q_u32(buffer, vbslq_u32(opaque, c, p));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++buffer) {
+        if (A(*buffer) < 255) *buffer = PREMULTIPLY(*buffer);
+    }
+}
+
+
+#ifdef SW_NEON_AARCH64
+
+//C * 255 / a, the float division is exact enough to truncate to the integer division
+template<int SHIFT>
+static inline uint32x4_t _divide(uint32x4_t c, float32x4_t a)
+{
+    auto v = vcvtq_f32_u32(vandq_u32(vshlq_u32(c, vdupq_n_s32(-SHIFT)), vdupq_n_u32(0xff)));
+    v = vdivq_f32(vmulq_n_f32(v, 255.0f), a);
+    return vshlq_u32(vandq_u32(vcvtq_u32_f32(v), vdupq_n_u32(0xff)), vdupq_n_s32(SHIFT));
+}
+
+
+static void _unpremultiply(uint32_t* buffer, uint32_t len)
+{
+    const auto ff = vdupq_n_u32(0xff);
+
+    for (; len >= 4; len -= 4, buffer += 4) {
+        auto c = vld1q_u32(buffer);
+        auto a = vshrq_n_u32(c, 24);
+        auto keep = vorrq_u32(vceqq_u32(a, vdupq_n_u32(0)), vceqq_u32(a, ff));
+        if (_all(keep)) continue;
+        auto fa = vcvtq_f32_u32(vbslq_u32(keep, ff, a));   //no division by zero
+        auto p = vandq_u32(c, vdupq_n_u32(0xff000000));
+        p = vorrq_u32(p, _divide<16>(c, fa));
+        p = vorrq_u32(p, _divide<8>(c, fa));
+        p = vorrq_u32(p, _divide<0>(c, fa));
+        vst1q_u32(buffer, vbslq_u32(keep, c, p));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++buffer) {
+        *buffer = rasterUnpremultiply(*buffer);
+    }
+}
+
+#endif
+
+
+static void _swapRB(uint32_t* buffer, uint32_t len)
+{
+    auto dst = reinterpret_cast<uint8_t*>(buffer);
+
+    for (; len >= 16; len -= 16, dst += 64) {
+        auto c = vld4q_u8(dst);
+        auto t = c.val[0];
+        c.val[0] = c.val[2];
+        c.val[2] = t;
+        vst4q_u8(dst, c);
+    }
+
+    //leftovers
+    buffer = reinterpret_cast<uint32_t*>(dst);
+    for (; len > 0; --len, ++buffer) {
+        auto c = *buffer;
+        *buffer = (c & 0xff00ff00) + ((c & 0x00ff0000) >> 16) + ((c & 0x000000ff) << 16);
+    }
+}
+
+
+//the color table indices of the gradient positions
+template<FillSpread SPREAD>
+static inline int32x4_t _clamp(int32x4_t pos)
+{
+    if (SPREAD == FillSpread::Pad) {
+        return vminq_s32(vmaxq_s32(pos, vdupq_n_s32(0)), vdupq_n_s32(GRADIENT_STOP_SIZE - 1));
+    } else if (SPREAD == FillSpread::Repeat) {
+        return vandq_s32(pos, vdupq_n_s32(GRADIENT_STOP_SIZE - 1));
+    }
+    //reflect: the second half is mirrored, (limit - pos - 1) is identical to (pos ^ (limit - 1))
+    auto limit = vdupq_n_s32(GRADIENT_STOP_SIZE * 2 - 1);
+    pos = vandq_s32(pos, limit);
+    auto mirror = vreinterpretq_s32_u32(vcgtq_s32(pos, vdupq_n_s32(GRADIENT_STOP_SIZE - 1)));
+    return veorq_s32(pos, vandq_s32(mirror, limit));
+}
+
+
+//only the linear one, the radial roots of the scalar path might be fused by the compiler
+template<FillSpread SPREAD>
+static void _linear(const uint32_t* ctable, uint32_t* dst, int32_t t, int32_t inc, uint32_t len)
+{
+    if (len >= 4) {
+        const int32_t offsets[] = {0, 1, 2, 3};
+        auto pos = vmlaq_n_s32(vdupq_n_s32(t + FIXPT_SIZE / 2), vld1q_s32(offsets), inc);
+        auto step = vdupq_n_s32(inc * 4);
+        for (; len >= 4; len -= 4, dst += 4, t += inc * 4) {
+            auto idx = _clamp<SPREAD>(vshrq_n_s32(pos, FIXPT_BITS));
+            dst[0] = ctable[vgetq_lane_s32(idx, 0)];
+            dst[1] = ctable[vgetq_lane_s32(idx, 1)];
+            dst[2] = ctable[vgetq_lane_s32(idx, 2)];
+            dst[3] = ctable[vgetq_lane_s32(idx, 3)];
+            pos = vaddq_s32(pos, step);
+        }
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, t += inc) {
+        *dst = ctable[fillClamp<SPREAD>((t + (FIXPT_SIZE / 2)) >> FIXPT_BITS)];
+    }
+}
+
+
+static void _boxBlur(uint32_t* dst, const uint32_t* in, const uint32_t* out, uint32_t len, int32_t* acc, float iarr)
+{
+    //the four channel sums in one register
+    auto sum = vld1q_s32(acc);
+    auto scale = vdupq_n_f32(iarr);
+
+    for (uint32_t i = 0; i < len; ++i) {
+        auto s = vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(in[i])))));
+        auto e = vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(out[i])))));
+        sum = vaddq_s32(sum, vreinterpretq_s32_u32(vsubq_u32(s, e)));
+        auto v = vmovn_u32(vcvtq_u32_f32(vmulq_f32(vcvtq_f32_s32(sum), scale)));
+        dst[i] = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(v, v))), 0);
+    }
+
+    vst1q_s32(acc, sum);
+}
+
+
+static void _transpose(uint32_t* dst, int32_t dstride, const uint32_t* src, int32_t sstride, int32_t w, int32_t h)
+{
+    int32_t x = 0;
+
+    //4x4 tiles
+    for (; x + 4 <= w; x += 4) {
+        int32_t y = 0;
+        for (; y + 4 <= h; y += 4) {
+            auto p = src + y * sstride + x;
+            auto t01 = vtrnq_u32(vld1q_u32(p), vld1q_u32(p + sstride));
+            auto t23 = vtrnq_u32(vld1q_u32(p + sstride * 2), vld1q_u32(p + sstride * 3));
+            auto q = dst + x * dstride + y;
+            vst1q_u32(q, vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0])));
+            vst1q_u32(q + dstride, vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1])));
+            vst1q_u32(q + dstride * 2, vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])));
+            vst1q_u32(q + dstride * 3, vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1])));
+        }
+        //leftover rows
+        for (; y < h; ++y) {
+            for (int32_t i = 0; i < 4; ++i) dst[(x + i) * dstride + y] = src[y * sstride + x + i];
+        }
+    }
+
+    //leftover columns
+    for (; x < w; ++x) {
+        for (int32_t y = 0; y < h; ++y) dst[x * dstride + y] = src[y * sstride + x];
+    }
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+void kernelNeon(SwKernels& kernels)
+{
+    kernels.fill32 = _fill32;
+    kernels.fill8 = _fill8;
+    kernels.translucentColor = _translucentColor;
+    kernels.translucentPixels = _translucentPixels;
+    kernels.mattedColor = _mattedColor;
+    kernels.mattedPixels = _mattedPixels;
+    kernels.luma = _luma;
+    kernels.premultiply = _premultiply;
+#ifdef SW_NEON_AARCH64
+    kernels.unpremultiply = _unpremultiply;    //armv7 has no vector division
+#endif
+    kernels.swapRB = _swapRB;
+    kernels.linear[static_cast<int>(FillSpread::Pad)] = _linear<FillSpread::Pad>;
+    kernels.linear[static_cast<int>(FillSpread::Reflect)] = _linear<FillSpread::Reflect>;
+    kernels.linear[static_cast<int>(FillSpread::Repeat)] = _linear<FillSpread::Repeat>;
+    kernels.boxBlur = _boxBlur;
+    kernels.transpose = _transpose;
+    kernels.name = "NEON";
+}
+
+#endif
@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgSwCommon.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <immintrin.h>
+
+//compiled in regardless of the build flags, the engine selects it only if the cpu supports it.
+#if defined(__GNUC__) || defined(__clang__)
+    #define SSE41 __attribute__((target("sse4.1")))
+#else
+    #define SSE41
+#endif
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+//per channel (c * m) >> 8, m is the 32bits vector of the 9bits multipliers of four pixels
+SSE41 static inline __m128i _scale(__m128i c, __m128i m)
+{
+    const auto zero = _mm_setzero_si128();
+    const auto lo = _mm_setr_epi8(0, 1, 0, 1, 0, 1, 0, 1, 4, 5, 4, 5, 4, 5, 4, 5);
+    const auto hi = _mm_setr_epi8(8, 9, 8, 9, 8, 9, 8, 9, 12, 13, 12, 13, 12, 13, 12, 13);
+    auto l = _mm_mullo_epi16(_mm_unpacklo_epi8(c, zero), _mm_shuffle_epi8(m, lo));
+    auto h = _mm_mullo_epi16(_mm_unpackhi_epi8(c, zero), _mm_shuffle_epi8(m, hi));
+    return _mm_packus_epi16(_mm_srli_epi16(l, 8), _mm_srli_epi16(h, 8));
+}
+
+
+//ALPHA_BLEND() with the individual alpha of four pixels
+SSE41 static inline __m128i _blend(__m128i c, __m128i a)
+{
+    return _scale(c, _mm_add_epi32(a, _mm_set1_epi32(1)));
+}
+
+
+//s + ALPHA_BLEND(d, IA(s))
+SSE41 static inline __m128i _over(__m128i s, __m128i d)
+{
+    auto ia = _mm_xor_si128(_mm_srli_epi32(s, 24), _mm_set1_epi32(0xff));
+    return _mm_add_epi32(s, _blend(d, ia));
+}
+
+
+//MULTIPLY() of the 8bits values in 32bits lanes
+SSE41 static inline __m128i _multiply(__m128i a, __m128i b)
+{
+    return _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(a, b), _mm_set1_epi32(0xff)), 8);
+}
+
+
+//the compositor alpha of four pixels, the channel size is either 1 or 4 bytes
+SSE41 static inline __m128i _alpha(const uint8_t* cmp, uint8_t csize, __m128i mask)
+{
+    __m128i a;
+    if (csize == sizeof(uint8_t)) {
+        int32_t v;
+        memcpy(&v, cmp, sizeof(v));
+        a = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(v));
+    } else {
+        a = _mm_and_si128(_mm_loadu_si128((const __m128i*)cmp), _mm_set1_epi32(0xff));
+    }
+    return _mm_xor_si128(a, mask);
+}
+
+
+SSE41 static void _fill32(uint32_t* dst, uint32_t val, uint32_t len)
+{
+    auto v = _mm_set1_epi32(val);
+
+    for (; len >= 4; len -= 4, dst += 4) {
+        _mm_storeu_si128((__m128i*)dst, v);
+    }
+
+    //leftovers
+    while (len--) *dst++ = val;
+}
+
+
+SSE41 static void _fill8(uint8_t* dst, uint8_t val, uint32_t len)
+{
+    auto v = _mm_set1_epi8(val);
+
+    for (; len >= 16; len -= 16, dst += 16) {
+        _mm_storeu_si128((__m128i*)dst, v);
+    }
+
+    //leftovers
+    while (len--) *dst++ = val;
+}
+
+
+SSE41 static void _translucentColor(uint32_t* dst, uint32_t color, uint32_t len)
+{
+    auto c = _mm_set1_epi32(color);
+    auto ia = _mm_set1_epi32(IA(color) + 1);
+
+    for (; len >= 4; len -= 4, dst += 4) {
+        auto d = _mm_loadu_si128((const __m128i*)dst);
+        _mm_storeu_si128((__m128i*)dst, _mm_add_epi32(c, _scale(d, ia)));
+    }
+
+    //leftovers
+    auto ialpha = IA(color);
+    for (; len > 0; --len, ++dst) {
+        *dst = color + ALPHA_BLEND(*dst, ialpha);
+    }
+}
+
+
+SSE41 static void _translucentPixels(uint32_t* dst, const uint32_t* src, uint32_t len, uint8_t opacity)
+{
+    auto a = _mm_set1_epi32(opacity);
+
+    for (; len >= 4; len -= 4, dst += 4, src += 4) {
+        auto s = _mm_loadu_si128((const __m128i*)src);
+        if (opacity < 255) s = _blend(s, a);
+        _mm_storeu_si128((__m128i*)dst, _over(s, _mm_loadu_si128((const __m128i*)dst)));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, ++src) {
+        auto tmp = (opacity < 255) ? ALPHA_BLEND(*src, opacity) : *src;
+        *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+    }
+}
+
+
+SSE41 static void _mattedColor(uint32_t* dst, uint32_t color, const uint8_t* cmp, uint32_t len, uint8_t csize, bool inverse)
+{
+    auto c = _mm_set1_epi32(color);
+    auto mask = _mm_set1_epi32(inverse ? 0xff : 0);
+
+    for (; len >= 4; len -= 4, dst += 4, cmp += 4 * csize) {
+        auto tmp = _blend(c, _alpha(cmp, csize, mask));
+        _mm_storeu_si128((__m128i*)dst, _over(tmp, _mm_loadu_si128((const __m128i*)dst)));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, cmp += csize) {
+        auto tmp = ALPHA_BLEND(color, *cmp ^ (inverse ? 0xff : 0));
+        *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+    }
+}
+
+
+SSE41 static void _mattedPixels(uint32_t* dst, const uint32_t* src, const uint8_t* cmp, uint32_t len, uint8_t csize, uint8_t opacity, bool inverse)
+{
+    auto o = _mm_set1_epi32(opacity);
+    auto mask = _mm_set1_epi32(inverse ? 0xff : 0);
+
+    for (; len >= 4; len -= 4, dst += 4, src += 4, cmp += 4 * csize) {
+        auto a = _alpha(cmp, csize, mask);
+        if (opacity < 255) a = _multiply(o, a);
+        auto tmp = _blend(_mm_loadu_si128((const __m128i*)src), a);
+        _mm_storeu_si128((__m128i*)dst, _over(tmp, _mm_loadu_si128((const __m128i*)dst)));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, ++src, cmp += csize) {
+        auto a = *cmp ^ (inverse ? 0xff : 0);
+        auto tmp = ALPHA_BLEND(*src, (opacity < 255) ? MULTIPLY(opacity, a) : a);
+        *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+    }
+}
+
+
+//the weighted sum of the three channels in 32bits lanes, the weights sum up to 255 so that the products fit in 16bits
+SSE41 static inline __m128i _luma(__m128i c, __m128i w0, __m128i w2)
+{
+    const auto ff = _mm_set1_epi32(0xff);
+    auto l = _mm_mullo_epi16(_mm_and_si128(c, ff), w0);
+    l = _mm_add_epi32(l, _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(c, 8), ff), _mm_set1_epi32(182)));
+    l = _mm_add_epi32(l, _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(c, 16), ff), w2));
+    return _mm_srli_epi32(l, 8);
+}
+
+
+SSE41 static void _luma(uint8_t* dst, const uint32_t* src, uint32_t len, bool abgr, bool inverse)
+{
+    auto w0 = _mm_set1_epi32(abgr ? 54 : 19);
+    auto w2 = _mm_set1_epi32(abgr ? 19 : 54);
+    auto mask = _mm_set1_epi8(inverse ? 0xff : 0);
+
+    for (; len >= 16; len -= 16, dst += 16, src += 16) {
+        auto l0 = _luma(_mm_loadu_si128((const __m128i*)src), w0, w2);
+        auto l1 = _luma(_mm_loadu_si128((const __m128i*)(src + 4)), w0, w2);
+        auto l2 = _luma(_mm_loadu_si128((const __m128i*)(src + 8)), w0, w2);
+        auto l3 = _luma(_mm_loadu_si128((const __m128i*)(src + 12)), w0, w2);
+        auto l = _mm_packus_epi16(_mm_packus_epi32(l0, l1), _mm_packus_epi32(l2, l3));
+        _mm_storeu_si128((__m128i*)dst, _mm_xor_si128(l, mask));
+    }
+
+    //leftovers
+    auto iw0 = abgr ? 54 : 19;
+    auto iw2 = abgr ? 19 : 54;
+    for (; len > 0; --len, ++dst, ++src) {
+        auto v = *src;
+        *dst = ((((v & 0xff) * iw0) + (((v >> 8) & 0xff) * 182) + (((v >> 16) & 0xff) * iw2)) >> 8) ^ (inverse ? 0xff : 0);
+    }
+}
+
+
+SSE41 static void _premultiply(uint32_t* buffer, uint32_t len)
+{
+    const auto ff = _mm_set1_epi32(0xff);
+    const auto amask = _mm_set1_epi32(0xff000000);
+
+    for (; len >= 4; len -= 4, buffer += 4) {
+        auto c = _mm_loadu_si128((const __m128i*)buffer);
+        auto a = _mm_srli_epi32(c, 24);
+        auto opaque = _mm_cmpeq_epi32(a, ff);
+        if (_mm_movemask_epi8(opaque) == 0xffff) continue;
+        auto p = _mm_or_si128(_mm_andnot_si128(amask, _scale(c, a)), _mm_and_si128(c, amask));
+        _mm_storeu_si128((__m128i*)buffer, _mm_blendv_epi8(p, c, opaque));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++buffer) {
+        if (A(*buffer) < 255) *buffer = PREMULTIPLY(*buffer);
+    }
+}
+
+
+//C * 255 / a, the float division is exact enough to truncate to the integer division
+SSE41 static inline __m128i _divide(__m128i c, __m128 a, int shift)
+{
+    auto v = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c, shift), _mm_set1_epi32(0xff)));
+    v = _mm_div_ps(_mm_mul_ps(v, _mm_set1_ps(255.0f)), a);
+    return _mm_slli_epi32(_mm_and_si128(_mm_cvttps_epi32(v), _mm_set1_epi32(0xff)), shift);
+}
+
+
+SSE41 static void _unpremultiply(uint32_t* buffer, uint32_t len)
+{
+    const auto ff = _mm_set1_epi32(0xff);
+
+    for (; len >= 4; len -= 4, buffer += 4) {
+        auto c = _mm_loadu_si128((const __m128i*)buffer);
+        auto a = _mm_srli_epi32(c, 24);
+        auto keep = _mm_or_si128(_mm_cmpeq_epi32(a, _mm_setzero_si128()), _mm_cmpeq_epi32(a, ff));
+        if (_mm_movemask_epi8(keep) == 0xffff) continue;
+        auto fa = _mm_cvtepi32_ps(_mm_blendv_epi8(a, ff, keep));   //no division by zero
+        auto p = _mm_and_si128(c, _mm_set1_epi32(0xff000000));
+        p = _mm_or_si128(p, _divide(c, fa, 16));
+        p = _mm_or_si128(p, _divide(c, fa, 8));
+        p = _mm_or_si128(p, _divide(c, fa, 0));
+        _mm_storeu_si128((__m128i*)buffer, _mm_blendv_epi8(p, c, keep));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++buffer) {
+        *buffer = rasterUnpremultiply(*buffer);
+    }
+}
+
+
+SSE41 static void _swapRB(uint32_t* buffer, uint32_t len)
+{
+    const auto swap = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    for (; len >= 4; len -= 4, buffer += 4) {
+        auto c = _mm_loadu_si128((const __m128i*)buffer);
+        _mm_storeu_si128((__m128i*)buffer, _mm_shuffle_epi8(c, swap));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++buffer) {
+        auto c = *buffer;
+        *buffer = (c & 0xff00ff00) + ((c & 0x00ff0000) >> 16) + ((c & 0x000000ff) << 16);
+    }
+}
+
+
+//the color table indices of the gradient positions
+template<FillSpread SPREAD>
+SSE41 static inline __m128i _clamp(__m128i pos)
+{
+    if (SPREAD == FillSpread::Pad) {
+        return _mm_min_epi32(_mm_max_epi32(pos, _mm_setzero_si128()), _mm_set1_epi32(GRADIENT_STOP_SIZE - 1));
+    } else if (SPREAD == FillSpread::Repeat) {
+        return _mm_and_si128(pos, _mm_set1_epi32(GRADIENT_STOP_SIZE - 1));
+    }
+    //reflect: the second half is mirrored, (limit - pos - 1) is identical to (pos ^ (limit - 1))
+    auto limit = _mm_set1_epi32(GRADIENT_STOP_SIZE * 2 - 1);
+    pos = _mm_and_si128(pos, limit);
+    auto mirror = _mm_cmpgt_epi32(pos, _mm_set1_epi32(GRADIENT_STOP_SIZE - 1));
+    return _mm_xor_si128(pos, _mm_and_si128(mirror, limit));
+}
+
+
+SSE41 static inline void _lookup(const uint32_t* ctable, __m128i idx, uint32_t* dst)
+{
+    dst[0] = ctable[_mm_cvtsi128_si32(idx)];
+    dst[1] = ctable[_mm_extract_epi32(idx, 1)];
+    dst[2] = ctable[_mm_extract_epi32(idx, 2)];
+    dst[3] = ctable[_mm_extract_epi32(idx, 3)];
+}
+
+
+template<FillSpread SPREAD>
+SSE41 static void _linear(const uint32_t* ctable, uint32_t* dst, int32_t t, int32_t inc, uint32_t len)
+{
+    if (len >= 4) {
+        auto pos = _mm_add_epi32(_mm_set1_epi32(t + FIXPT_SIZE / 2), _mm_mullo_epi32(_mm_set1_epi32(inc), _mm_setr_epi32(0, 1, 2, 3)));
+        auto step = _mm_set1_epi32(inc * 4);
+        for (; len >= 4; len -= 4, dst += 4, t += inc * 4) {
+            _lookup(ctable, _clamp<SPREAD>(_mm_srai_epi32(pos, FIXPT_BITS)), dst);
+            pos = _mm_add_epi32(pos, step);
+        }
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, t += inc) {
+        *dst = ctable[fillClamp<SPREAD>((t + (FIXPT_SIZE / 2)) >> FIXPT_BITS)];
+    }
+}
+
+
+template<FillSpread SPREAD>
+SSE41 static void _radial(const uint32_t* ctable, uint32_t* dst, float& b, float deltaB, float& det, float& deltaDet, float deltaDeltaDet, uint32_t len)
+{
+    //work on the local copies, the references would be reloaded at every step
+    auto d = det, dd = deltaDet, bb = b;
+
+    for (; len >= 4; len -= 4, dst += 4) {
+        //keep the forward differencing sequential, the roots are identical to the scalar ones
+        auto d0 = d; d += dd; dd += deltaDeltaDet;
+        auto d1 = d; d += dd; dd += deltaDeltaDet;
+        auto d2 = d; d += dd; dd += deltaDeltaDet;
+        auto d3 = d; d += dd; dd += deltaDeltaDet;
+        auto b0 = bb; bb += deltaB;
+        auto b1 = bb; bb += deltaB;
+        auto b2 = bb; bb += deltaB;
+        auto b3 = bb; bb += deltaB;
+        auto pos = _mm_sub_ps(_mm_sqrt_ps(_mm_setr_ps(d0, d1, d2, d3)), _mm_setr_ps(b0, b1, b2, b3));
+        pos = _mm_add_ps(_mm_mul_ps(pos, _mm_set1_ps(GRADIENT_STOP_SIZE - 1)), _mm_set1_ps(0.5f));
+        _lookup(ctable, _clamp<SPREAD>(_mm_cvttps_epi32(pos)), dst);
+    }
+
+    //leftovers
+    det = d;
+    deltaDet = dd;
+    b = bb;
+
+    for (; len > 0; --len, ++dst) {
+        *dst = ctable[fillClamp<SPREAD>(static_cast<int32_t>((sqrtf(det) - b) * (GRADIENT_STOP_SIZE - 1) + 0.5f))];
+        det += deltaDet;
+        deltaDet += deltaDeltaDet;
+        b += deltaB;
+    }
+}
+
+
+SSE41 static void _boxBlur(uint32_t* dst, const uint32_t* in, const uint32_t* out, uint32_t len, int32_t* acc, float iarr)
+{
+    //the four channel sums in one register
+    auto sum = _mm_loadu_si128((const __m128i*)acc);
+    auto scale = _mm_set1_ps(iarr);
+
+    for (uint32_t i = 0; i < len; ++i) {
+        auto s = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(in[i]));
+        auto e = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(out[i]));
+        sum = _mm_add_epi32(sum, _mm_sub_epi32(s, e));
+        auto v = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sum), scale));
+        v = _mm_packus_epi32(v, v);
+        dst[i] = _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+    }
+
+    _mm_storeu_si128((__m128i*)acc, sum);
+}
+
+
+SSE41 static void _shadowBlur(uint32_t* dst, const uint32_t* in, const uint32_t* out, uint32_t len, int32_t& acc, uint32_t color, float iarr)
+{
+    auto c = _mm_set1_epi32(color);
+    auto scale = _mm_set1_ps(iarr);
+
+    for (; len >= 4; len -= 4, dst += 4, in += 4, out += 4) {
+        //the running sums of four pixels by the prefix sum of the alpha differences
+        auto d = _mm_sub_epi32(_mm_srli_epi32(_mm_loadu_si128((const __m128i*)in), 24), _mm_srli_epi32(_mm_loadu_si128((const __m128i*)out), 24));
+        d = _mm_add_epi32(d, _mm_slli_si128(d, 4));
+        d = _mm_add_epi32(d, _mm_slli_si128(d, 8));
+        auto sum = _mm_add_epi32(d, _mm_set1_epi32(acc));
+        acc = _mm_extract_epi32(sum, 3);
+        auto a = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sum), scale));
+        _mm_storeu_si128((__m128i*)dst, _blend(c, a));
+    }
+
+    //leftovers
+    for (; len > 0; --len, ++dst, ++in, ++out) {
+        acc += A(*in) - A(*out);
+        *dst = ALPHA_BLEND(color, static_cast<uint8_t>(acc * iarr));
+    }
+}
+
+
+SSE41 static void _transpose(uint32_t* dst, int32_t dstride, const uint32_t* src, int32_t sstride, int32_t w, int32_t h)
+{
+    int32_t x = 0;
+
+    //4x4 tiles
+    for (; x + 4 <= w; x += 4) {
+        int32_t y = 0;
+        for (; y + 4 <= h; y += 4) {
+            auto p = src + y * sstride + x;
+            auto r0 = _mm_loadu_si128((const __m128i*)p);
+            auto r1 = _mm_loadu_si128((const __m128i*)(p + sstride));
+            auto r2 = _mm_loadu_si128((const __m128i*)(p + sstride * 2));
+            auto r3 = _mm_loadu_si128((const __m128i*)(p + sstride * 3));
+            auto t0 = _mm_unpacklo_epi32(r0, r1);
+            auto t1 = _mm_unpacklo_epi32(r2, r3);
+            auto t2 = _mm_unpackhi_epi32(r0, r1);
+            auto t3 = _mm_unpackhi_epi32(r2, r3);
+            auto q = dst + x * dstride + y;
+            _mm_storeu_si128((__m128i*)q, _mm_unpacklo_epi64(t0, t1));
+            _mm_storeu_si128((__m128i*)(q + dstride), _mm_unpackhi_epi64(t0, t1));
+            _mm_storeu_si128((__m128i*)(q + dstride * 2), _mm_unpacklo_epi64(t2, t3));
+            _mm_storeu_si128((__m128i*)(q + dstride * 3), _mm_unpackhi_epi64(t2, t3));
+        }
+        //leftover rows
+        for (; y < h; ++y) {
+            for (int32_t i = 0; i < 4; ++i) dst[(x + i) * dstride + y] = src[y * sstride + x + i];
+        }
+    }
+
+    //leftover columns
+    for (; x < w; ++x) {
+        for (int32_t y = 0; y < h; ++y) dst[x * dstride + y] = src[y * sstride + x];
+    }
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+void kernelSse41(SwKernels& kernels)
+{
+    kernels.fill32 = _fill32;
+    kernels.fill8 = _fill8;
+    kernels.translucentColor = _translucentColor;
+    kernels.translucentPixels = _translucentPixels;
+    kernels.mattedColor = _mattedColor;
+    kernels.mattedPixels = _mattedPixels;
+    kernels.luma = _luma;
+    kernels.premultiply = _premultiply;
+    kernels.unpremultiply = _unpremultiply;
+    kernels.swapRB = _swapRB;
+    kernels.linear[static_cast<int>(FillSpread::Pad)] = _linear<FillSpread::Pad>;
+    kernels.linear[static_cast<int>(FillSpread::Reflect)] = _linear<FillSpread::Reflect>;
+    kernels.linear[static_cast<int>(FillSpread::Repeat)] = _linear<FillSpread::Repeat>;
+    kernels.radial[static_cast<int>(FillSpread::Pad)] = _radial<FillSpread::Pad>;
+    kernels.radial[static_cast<int>(FillSpread::Reflect)] = _radial<FillSpread::Reflect>;
+    kernels.radial[static_cast<int>(FillSpread::Repeat)] = _radial<FillSpread::Repeat>;
+    kernels.boxBlur = _boxBlur;
+    kernels.shadowBlur = _shadowBlur;
+    kernels.transpose = _transpose;
+    kernels.name = "SSE4.1";
+}
+
+#endif
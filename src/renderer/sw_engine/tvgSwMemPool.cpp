@@ -27,6 +27,32 @@
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+static constexpr uint32_t ARENA_ALIGN = 16;       //enough for the simd loads/stores
+static constexpr uint32_t ARENA_MIN_SIZE = 4096;
+static constexpr uint32_t RESETTING = 0x80000000;  //the users flag, the arenas are being reset
+
+
+static inline uint32_t _align(uint32_t size)
+{
+    return (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+
+static void _resetArena(SwArena& arena, bool release)
+{
+    if (release) {
+        tvg::free(arena.data);
+        arena.data = nullptr;
+        arena.size = 0;
+    //grow up to the high-water mark if nobody is using it
+    } else if (arena.peak > arena.size && arena.live == 0 && arena.spilled == 0) {
+        tvg::free(arena.data);
+        arena.size = std::max(_align(arena.peak), ARENA_MIN_SIZE);
+        arena.data = tvg::malloc<uint8_t*>(arena.size);
+    }
+    arena.peak = 0;
+}
+
 
 /************************************************************************/
 /* External Class Implementation                                        */
@@ -77,6 +103,88 @@ void mpoolRetDashOutline(SwMpool* mpool, unsigned idx)
 }
 
 
+RenderPath* mpoolReqPath(SwMpool* mpool, unsigned idx)
+{
+    return &mpool->path[idx];
+}
+
+
+void mpoolRetPath(SwMpool* mpool, unsigned idx)
+{
+    mpool->path[idx].clear();
+}
+
+
+void* mpoolAlloc(SwMpool* mpool, unsigned idx, uint32_t size)
+{
+    auto& arena = mpool->arena[idx];
+    size = _align(size);
+
+    arena.peak = std::max(arena.peak, arena.used + arena.spilled + size);
+
+    if (arena.used + size <= arena.size) {
+        auto ptr = arena.data + arena.used;
+        arena.used += size;
+        ++arena.live;
+        return ptr;
+    }
+
+    //out of the main block, until it grows at the next reset
+    arena.spilled += size;
+    return tvg::malloc<void*>(size);
+}
+
+
+void mpoolFree(SwMpool* mpool, unsigned idx, void* ptr, uint32_t size)
+{
+    auto& arena = mpool->arena[idx];
+    auto p = static_cast<uint8_t*>(ptr);
+    size = _align(size);
+
+    if (p >= arena.data && p < arena.data + arena.size) {
+        //rewind the last one, the others are recycled once all of them are returned
+        if (p + size == arena.data + arena.used) arena.used -= size;
+        if (--arena.live == 0) arena.used = 0;
+    } else {
+        tvg::free(ptr);
+        arena.spilled -= size;
+    }
+}
+
+
+/* The canvases of the dominant thread share the pool, and a canvas syncs its own tasks only.
+   The arenas are reset only if no task of any of them is running, otherwise it's put off to the next frame. */
+void mpoolReset(SwMpool* mpool)
+{
+    uint32_t users = 0;
+    if (!mpool->users.compare_exchange_strong(users, RESETTING)) return;
+
+    for (unsigned i = 0; i < mpool->allocSize; ++i) {
+        _resetArena(mpool->arena[i], false);
+    }
+
+    mpool->users.store(0);
+}
+
+
+//A user of the arenas, it must be released once it has returned all of its allocations
+void mpoolRetain(SwMpool* mpool)
+{
+    auto users = mpool->users.load();
+    while (true) {
+        //wait for the reset in progress, it's just a few reallocations
+        if (users & RESETTING) users = mpool->users.load();
+        else if (mpool->users.compare_exchange_weak(users, users + 1)) return;
+    }
+}
+
+
+void mpoolRelease(SwMpool* mpool)
+{
+    --mpool->users;
+}
+
+
 SwMpool* mpoolInit(uint32_t threads)
 {
     auto allocSize = threads + 1;
@@ -85,6 +193,8 @@ SwMpool* mpoolInit(uint32_t threads)
     mpool->outline = tvg::calloc<SwOutline*>(1, sizeof(SwOutline) * allocSize);
     mpool->strokeOutline = tvg::calloc<SwOutline*>(1, sizeof(SwOutline) * allocSize);
     mpool->dashOutline = tvg::calloc<SwOutline*>(1, sizeof(SwOutline) * allocSize);
+    mpool->path = tvg::calloc<RenderPath*>(1, sizeof(RenderPath) * allocSize);
+    mpool->arena = tvg::calloc<SwArena*>(1, sizeof(SwArena) * allocSize);
     mpool->allocSize = allocSize;
 
     return mpool;
@@ -108,6 +218,11 @@ bool mpoolClear(SwMpool* mpool)
         mpool->dashOutline[i].cntrs.reset();
         mpool->dashOutline[i].types.reset();
         mpool->dashOutline[i].closed.reset();
+
+        mpool->path[i].cmds.reset();
+        mpool->path[i].pts.reset();
+
+        _resetArena(mpool->arena[i], true);
     }
 
     return true;
@@ -123,6 +238,8 @@ bool mpoolTerm(SwMpool* mpool)
     tvg::free(mpool->outline);
     tvg::free(mpool->strokeOutline);
     tvg::free(mpool->dashOutline);
+    tvg::free(mpool->path);
+    tvg::free(mpool->arena);
     tvg::free(mpool);
 
     return true;
@@ -59,52 +59,62 @@ static inline int _gaussianRemap(int end, int idx)
 }
 
 
-//TODO: SIMD OPTIMIZATION?
+template<int border>
+static void _gaussianRow(uint32_t* dst, const uint32_t* src, int32_t w, int32_t dimension, float iarr)
+{
+    auto end = w - 1;
+    int32_t acc[4] = {0, 0, 0, 0};      //sliding accumulator
+
+    auto pixel = [&](int32_t x) {
+        return reinterpret_cast<const uint8_t*>(src + _gaussianRemap<border>(end, x));
+    };
+
+    auto slide = [&](int32_t x) {
+        auto r = pixel(x + dimension);
+        auto l = pixel(x - dimension - 1);
+        auto d = reinterpret_cast<uint8_t*>(dst + x);
+        for (int c = 0; c < 4; ++c) {
+            acc[c] += r[c] - l[c];
+            //ignored rounding for the performance. It should be originally: acc[c] * iarr + 0.5f
+            d[c] = static_cast<uint8_t>(acc[c] * iarr);
+        }
+    };
+
+    //initial accumulation
+    for (int32_t x = -(dimension + 1); x < dimension; ++x) {
+        auto p = pixel(x);
+        for (int c = 0; c < 4; ++c) acc[c] += p[c];
+    }
+
+    //the window stays inside of the row in the middle, no remapping is necessary there
+    auto begin = std::min(dimension + 1, w);
+    auto mid = std::max(begin, w - dimension);
+
+    int32_t x = 0;
+    for (; x < begin; ++x) slide(x);
+    if (mid > begin) swKernels.boxBlur(dst + begin, src + begin + dimension, src + begin - dimension - 1, mid - begin, acc, iarr);
+    for (x = mid; x < w; ++x) slide(x);
+}
+
+
 template<int border = 0>
-static void _gaussianFilter(uint8_t* dst, uint8_t* src, int32_t stride, int32_t w, int32_t h, const RenderRegion& bbox, int32_t dimension, bool flipped)
+static void _gaussianFilter(const SwSurface* surface, uint32_t* dst, uint32_t* src, int32_t stride, int32_t w, int32_t h, const RenderRegion& bbox, int32_t dimension, bool flipped)
 {
     if (flipped) {
-        src += (bbox.min.x * stride + bbox.min.y) << 2;
-        dst += (bbox.min.x * stride + bbox.min.y) << 2;
+        src += (bbox.min.x * stride + bbox.min.y);
+        dst += (bbox.min.x * stride + bbox.min.y);
     } else {
-        src += (bbox.min.y * stride + bbox.min.x) << 2;
-        dst += (bbox.min.y * stride + bbox.min.x) << 2;
+        src += (bbox.min.y * stride + bbox.min.x);
+        dst += (bbox.min.y * stride + bbox.min.x);
     }
 
     auto iarr = 1.0f / (dimension + dimension + 1);
-    auto end = w - 1;
 
-    #pragma omp parallel for
-    for (int y = 0; y < h; ++y) {
-        auto p = y * stride;
-        auto i = p * 4;                 //current index
-        auto l = -(dimension + 1);      //left index
-        auto r = dimension;             //right index
-        int acc[4] = {0, 0, 0, 0};      //sliding accumulator
-
-        //initial accumulation
-        for (int x = l; x < r; ++x) {
-            auto id = (_gaussianRemap<border>(end, x) + p) * 4;
-            acc[0] += src[id++];
-            acc[1] += src[id++];
-            acc[2] += src[id++];
-            acc[3] += src[id];
+    rasterBands(surface, {{0, 0}, {w, h}}, [&](const RenderRegion& band) {
+        for (int y = band.min.y; y < band.max.y; ++y) {
+            _gaussianRow<border>(dst + y * stride, src + y * stride, w, dimension, iarr);
         }
-        //perform filtering
-        for (int x = 0; x < w; ++x, ++r, ++l) {
-            auto rid = (_gaussianRemap<border>(end, r) + p) * 4;
-            auto lid = (_gaussianRemap<border>(end, l) + p) * 4;
-            acc[0] += src[rid++] - src[lid++];
-            acc[1] += src[rid++] - src[lid++];
-            acc[2] += src[rid++] - src[lid++];
-            acc[3] += src[rid] - src[lid];
-            //ignored rounding for the performance. It should be originally: acc[idx] * iarr + 0.5f
-            dst[i++] = static_cast<uint8_t>(acc[0] * iarr);
-            dst[i++] = static_cast<uint8_t>(acc[1] * iarr);
-            dst[i++] = static_cast<uint8_t>(acc[2] * iarr);
-            dst[i++] = static_cast<uint8_t>(acc[3] * iarr);
-        }
-    }
+    });
 }
 
 
@@ -193,7 +203,7 @@ bool effectGaussianBlur(SwCompositor* cmp, SwSurface* surface, const RenderEffec
     //horizontal
     if (params->direction != 2) {
         for (int i = 0; i < data->level; ++i) {
-            _gaussianFilter(reinterpret_cast<uint8_t*>(back), reinterpret_cast<uint8_t*>(front), stride, w, h, bbox, data->kernel[i], false);
+            _gaussianFilter(surface, back, front, stride, w, h, bbox, data->kernel[i], false);
             std::swap(front, back);
             swapped = !swapped;
         }
@@ -201,16 +211,16 @@ bool effectGaussianBlur(SwCompositor* cmp, SwSurface* surface, const RenderEffec
 
     //vertical. x/y flipping and horionztal access is pretty compatible with the memory architecture.
     if (params->direction != 1) {
-        rasterXYFlip(front, back, stride, w, h, bbox, false);
+        rasterXYFlip(surface, front, back, stride, w, h, bbox, false);
         std::swap(front, back);
 
         for (int i = 0; i < data->level; ++i) {
-            _gaussianFilter(reinterpret_cast<uint8_t*>(back), reinterpret_cast<uint8_t*>(front), stride, h, w, bbox, data->kernel[i], true);
+            _gaussianFilter(surface, back, front, stride, h, w, bbox, data->kernel[i], true);
             std::swap(front, back);
             swapped = !swapped;
         }
 
-        rasterXYFlip(front, back, stride, h, w, bbox, true);
+        rasterXYFlip(surface, front, back, stride, h, w, bbox, true);
         std::swap(front, back);
     }
 
@@ -229,8 +239,34 @@ struct SwDropShadow : SwGaussianBlur
 };
 
 
-//TODO: SIMD OPTIMIZATION?
-static void _dropShadowFilter(uint32_t* dst, uint32_t* src, int stride, int w, int h, const RenderRegion& bbox, int32_t dimension, uint32_t color, bool flipped)
+static void _dropShadowRow(uint32_t* dst, const uint32_t* src, int32_t w, int32_t dimension, uint32_t color, float iarr)
+{
+    auto end = w - 1;
+    int32_t acc = 0;                    //sliding accumulator
+
+    auto slide = [&](int32_t x) {
+        acc += A(src[_gaussianEdgeExtend(end, x + dimension)]) - A(src[_gaussianEdgeExtend(end, x - dimension - 1)]);
+        //ignored rounding for the performance. It should be originally: acc * iarr
+        dst[x] = ALPHA_BLEND(color, static_cast<uint8_t>(acc * iarr));
+    };
+
+    //initial accumulation
+    for (int32_t x = -(dimension + 1); x < dimension; ++x) {
+        acc += A(src[_gaussianEdgeExtend(end, x)]);
+    }
+
+    //the window stays inside of the row in the middle, no clamping is necessary there
+    auto begin = std::min(dimension + 1, w);
+    auto mid = std::max(begin, w - dimension);
+
+    int32_t x = 0;
+    for (; x < begin; ++x) slide(x);
+    if (mid > begin) swKernels.shadowBlur(dst + begin, src + begin + dimension, src + begin - dimension - 1, mid - begin, acc, color, iarr);
+    for (x = mid; x < w; ++x) slide(x);
+}
+
+
+static void _dropShadowFilter(const SwSurface* surface, uint32_t* dst, uint32_t* src, int stride, int w, int h, const RenderRegion& bbox, int32_t dimension, uint32_t color, bool flipped)
 {
     if (flipped) {
         src += (bbox.min.x * stride + bbox.min.y);
@@ -240,34 +276,16 @@ static void _dropShadowFilter(uint32_t* dst, uint32_t* src, int stride, int w, i
         dst += (bbox.min.y * stride + bbox.min.x);
     }
     auto iarr = 1.0f / (dimension + dimension + 1);
-    auto end = w - 1;
 
-    #pragma omp parallel for
-    for (int y = 0; y < h; ++y) {
-        auto p = y * stride;
-        auto i = p;                     //current index
-        auto l = -(dimension + 1);      //left index
-        auto r = dimension;             //right index
-        int acc = 0;                    //sliding accumulator
-
-        //initial accumulation
-        for (int x = l; x < r; ++x) {
-            auto id = _gaussianEdgeExtend(end, x) + p;
-            acc += A(src[id]);
-        }
-        //perform filtering
-        for (int x = 0; x < w; ++x, ++r, ++l) {
-            auto rid = _gaussianEdgeExtend(end, r) + p;
-            auto lid = _gaussianEdgeExtend(end, l) + p;
-            acc += A(src[rid]) - A(src[lid]);
-            //ignored rounding for the performance. It should be originally: acc * iarr
-            dst[i++] = ALPHA_BLEND(color, static_cast<uint8_t>(acc * iarr));
+    rasterBands(surface, {{0, 0}, {w, h}}, [&](const RenderRegion& band) {
+        for (int y = band.min.y; y < band.max.y; ++y) {
+            _dropShadowRow(dst + y * stride, src + y * stride, w, dimension, color, iarr);
         }
-    }
+    });
 }
 
 
-static void _dropShadowShift(uint32_t* dst, uint32_t* src, int dstride, int sstride, RenderRegion& bbox, SwPoint& offset, uint8_t opacity)
+static void _dropShadowShift(const SwSurface* surface, uint32_t* dst, uint32_t* src, int dstride, int sstride, RenderRegion& bbox, SwPoint& offset, uint8_t opacity)
 {
     src += (bbox.min.y * sstride + bbox.min.x);
     dst += (bbox.min.y * dstride + bbox.min.x);
@@ -276,19 +294,26 @@ static void _dropShadowShift(uint32_t* dst, uint32_t* src, int dstride, int sstr
     auto h = bbox.max.y - bbox.min.y;
     auto translucent = (opacity < 255);
 
-    //shift offset
-    if (bbox.min.x + offset.x < 0) src -= offset.x;
+    //shift offset, the shifted out pixels are clipped not to overrun the region
+    if (offset.x < 0) src -= offset.x;
     else dst += offset.x;
 
-    if (bbox.min.y + offset.y < 0) src -= (offset.y * sstride);
+    if (offset.y < 0) src -= (offset.y * sstride);
     else dst += (offset.y * dstride);
 
-    for (auto y = 0; y < h; ++y) {
-        if (translucent) rasterTranslucentPixel32(dst, src, w, opacity);
-        else rasterPixel32(dst, src, w, opacity);
-        src += sstride;
-        dst += dstride;
-    }
+    w -= abs(offset.x);
+    h -= abs(offset.y);
+
+    rasterBands(surface, {{0, 0}, {w, h}}, [&](const RenderRegion& band) {
+        auto s = src + band.min.y * sstride;
+        auto d = dst + band.min.y * dstride;
+        for (auto y = band.min.y; y < band.max.y; ++y) {
+            if (translucent) rasterTranslucentPixel32(d, s, w, opacity);
+            else rasterPixel32(d, s, w, opacity);
+            s += sstride;
+            d += dstride;
+        }
+    });
 }
 
 
@@ -363,42 +388,44 @@ bool effectDropShadow(SwCompositor* cmp, SwSurface* surface[2], const RenderEffe
     TVGLOG("SW_ENGINE", "DropShadow region(%d, %d, %d, %d) params(%f %f %f), level(%d)", bbox.min.x, bbox.min.y, bbox.max.x, bbox.max.y, params->angle, params->distance, params->sigma, data->level);
 
     //saving the original image in order to overlay it into the filtered image.
-    _dropShadowFilter(back, front, stride, w, h, bbox, data->kernel[0], color, false);
+    _dropShadowFilter(surface[1], back, front, stride, w, h, bbox, data->kernel[0], color, false);
     std::swap(front, buffer[0]->buf32);
     std::swap(front, back);
 
     //horizontal
     for (int i = 1; i < data->level; ++i) {
-        _dropShadowFilter(back, front, stride, w, h, bbox, data->kernel[i], color, false);
+        _dropShadowFilter(surface[1], back, front, stride, w, h, bbox, data->kernel[i], color, false);
         std::swap(front, back);
     }
 
     //vertical
-    rasterXYFlip(front, back, stride, w, h, bbox, false);
+    rasterXYFlip(surface[1], front, back, stride, w, h, bbox, false);
     std::swap(front, back);
 
     for (int i = 0; i < data->level; ++i) {
-        _dropShadowFilter(back, front, stride, h, w, bbox, data->kernel[i], color, true);
+        _dropShadowFilter(surface[1], back, front, stride, h, w, bbox, data->kernel[i], color, true);
         std::swap(front, back);
     }
 
-    rasterXYFlip(front, back, stride, h, w, bbox, true);
+    rasterXYFlip(surface[1], front, back, stride, h, w, bbox, true);
     std::swap(cmp->image.buf32, back);
 
     //draw to the intermediate surface
     rasterClear(surface[1], bbox.min.x, bbox.min.y, w, h);
-    _dropShadowShift(buffer[1]->buf32, cmp->image.buf32, stride, stride, bbox, data->offset, params->color[3]);
+    _dropShadowShift(surface[1], buffer[1]->buf32, cmp->image.buf32, stride, stride, bbox, data->offset, params->color[3]);
     std::swap(cmp->image.buf32, buffer[1]->buf32);
 
     //compositing shadow and body
-    auto s = buffer[0]->buf32 + (bbox.min.y * buffer[0]->stride + bbox.min.x);
-    auto d = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
-
-    for (auto y = 0; y < h; ++y) {
-        rasterTranslucentPixel32(d, s, w, 255);
-        s += buffer[0]->stride;
-        d += cmp->image.stride;
-    }
+    rasterBands(surface[1], bbox, [&](const RenderRegion& band) {
+        auto s = buffer[0]->buf32 + (band.min.y * buffer[0]->stride + band.min.x);
+        auto d = cmp->image.buf32 + (band.min.y * cmp->image.stride + band.min.x);
+
+        for (auto y = band.min.y; y < band.max.y; ++y) {
+            rasterTranslucentPixel32(d, s, w, 255);
+            s += buffer[0]->stride;
+            d += cmp->image.stride;
+        }
+    });
 
     return true;
 }
@@ -420,35 +447,38 @@ bool effectFill(SwCompositor* cmp, const RenderEffectFill* params, bool direct)
 
     auto& bbox = cmp->bbox;
     auto w = size_t(bbox.max.x - bbox.min.x);
-    auto h = size_t(bbox.max.y - bbox.min.y);
     auto color = cmp->recoverSfc->join(params->color[0], params->color[1], params->color[2], 255);
 
     TVGLOG("SW_ENGINE", "Fill region(%d, %d, %d, %d), param(%d %d %d %d)", bbox.min.x, bbox.min.y, bbox.max.x, bbox.max.y, params->color[0], params->color[1], params->color[2], params->color[3]);
 
     if (direct) {
-        auto dbuffer = cmp->recoverSfc->buf32 + (bbox.min.y * cmp->recoverSfc->stride + bbox.min.x);
-        auto sbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
-        for (size_t y = 0; y < h; ++y) {
-            auto dst = dbuffer;
-            auto src = sbuffer;
-            for (size_t x = 0; x < w; ++x, ++dst, ++src) {
-                auto a = MULTIPLY(opacity, A(*src));
-                auto tmp = ALPHA_BLEND(color, a);
-                *dst = tmp + ALPHA_BLEND(*dst, 255 - a);
+        rasterBands(cmp->recoverSfc, bbox, [&](const RenderRegion& band) {
+            auto dbuffer = cmp->recoverSfc->buf32 + (band.min.y * cmp->recoverSfc->stride + bbox.min.x);
+            auto sbuffer = cmp->image.buf32 + (band.min.y * cmp->image.stride + bbox.min.x);
+            for (auto y = band.min.y; y < band.max.y; ++y) {
+                auto dst = dbuffer;
+                auto src = sbuffer;
+                for (size_t x = 0; x < w; ++x, ++dst, ++src) {
+                    auto a = MULTIPLY(opacity, A(*src));
+                    auto tmp = ALPHA_BLEND(color, a);
+                    *dst = tmp + ALPHA_BLEND(*dst, 255 - a);
+                }
+                dbuffer += cmp->image.stride;
+                sbuffer += cmp->recoverSfc->stride;
             }
-            dbuffer += cmp->image.stride;
-            sbuffer += cmp->recoverSfc->stride;
-        }
+        });
         cmp->valid = true;  //no need the subsequent composition
     } else {
-        auto dbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
-        for (size_t y = 0; y < h; ++y) {
-            auto dst = dbuffer;
-            for (size_t x = 0; x < w; ++x, ++dst) {
-                *dst = ALPHA_BLEND(color, MULTIPLY(opacity, A(*dst)));
+        rasterBands(cmp->recoverSfc, bbox, [&](const RenderRegion& band) {
+            auto dbuffer = cmp->image.buf32 + (band.min.y * cmp->image.stride + bbox.min.x);
+            for (auto y = band.min.y; y < band.max.y; ++y) {
+                auto dst = dbuffer;
+                for (size_t x = 0; x < w; ++x, ++dst) {
+                    *dst = ALPHA_BLEND(color, MULTIPLY(opacity, A(*dst)));
+                }
+                dbuffer += cmp->image.stride;
             }
-            dbuffer += cmp->image.stride;
-        }
+        });
     }
     return true;
 }
@@ -468,7 +498,6 @@ bool effectTint(SwCompositor* cmp, const RenderEffectTint* params, bool direct)
 {
     auto& bbox = cmp->bbox;
     auto w = size_t(bbox.max.x - bbox.min.x);
-    auto h = size_t(bbox.max.y - bbox.min.y);
     auto black = cmp->recoverSfc->join(params->black[0], params->black[1], params->black[2], 255);
     auto white = cmp->recoverSfc->join(params->white[0], params->white[1], params->white[2], 255);
     auto opacity = cmp->opacity;
@@ -479,29 +508,33 @@ bool effectTint(SwCompositor* cmp, const RenderEffectTint* params, bool direct)
     /* Tint Formula: (1 - L) * Black + L * White, where the L is Luminance. */
 
     if (direct) {
-        auto dbuffer = cmp->recoverSfc->buf32 + (bbox.min.y * cmp->recoverSfc->stride + bbox.min.x);
-        auto sbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
-        for (size_t y = 0; y < h; ++y) {
-            auto dst = dbuffer;
-            auto src = sbuffer;
-            for (size_t x = 0; x < w; ++x, ++dst, ++src) {
-                auto val = INTERPOLATE(INTERPOLATE(white, black, luma((uint8_t*)src)), *src, params->intensity);
-                *dst = INTERPOLATE(val, *dst, MULTIPLY(opacity, A(*src)));
+        rasterBands(cmp->recoverSfc, bbox, [&](const RenderRegion& band) {
+            auto dbuffer = cmp->recoverSfc->buf32 + (band.min.y * cmp->recoverSfc->stride + bbox.min.x);
+            auto sbuffer = cmp->image.buf32 + (band.min.y * cmp->image.stride + bbox.min.x);
+            for (auto y = band.min.y; y < band.max.y; ++y) {
+                auto dst = dbuffer;
+                auto src = sbuffer;
+                for (size_t x = 0; x < w; ++x, ++dst, ++src) {
+                    auto val = INTERPOLATE(INTERPOLATE(white, black, luma((uint8_t*)src)), *src, params->intensity);
+                    *dst = INTERPOLATE(val, *dst, MULTIPLY(opacity, A(*src)));
+                }
+                dbuffer += cmp->image.stride;
+                sbuffer += cmp->recoverSfc->stride;
             }
-            dbuffer += cmp->image.stride;
-            sbuffer += cmp->recoverSfc->stride;
-        }
+        });
         cmp->valid = true;  //no need the subsequent composition
     } else {
-        auto dbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
-        for (size_t y = 0; y < h; ++y) {
-            auto dst = dbuffer;
-            for (size_t x = 0; x < w; ++x, ++dst) {
-                auto val = INTERPOLATE(INTERPOLATE(white, black, luma((uint8_t*)&dst)), *dst, params->intensity);
-                *dst = ALPHA_BLEND(val, MULTIPLY(opacity, A(*dst)));
+        rasterBands(cmp->recoverSfc, bbox, [&](const RenderRegion& band) {
+            auto dbuffer = cmp->image.buf32 + (band.min.y * cmp->image.stride + bbox.min.x);
+            for (auto y = band.min.y; y < band.max.y; ++y) {
+                auto dst = dbuffer;
+                for (size_t x = 0; x < w; ++x, ++dst) {
+                    auto val = INTERPOLATE(INTERPOLATE(white, black, luma((uint8_t*)&dst)), *dst, params->intensity);
+                    *dst = ALPHA_BLEND(val, MULTIPLY(opacity, A(*dst)));
+                }
+                dbuffer += cmp->image.stride;
             }
-            dbuffer += cmp->image.stride;
-        }
+        });
     }
 
     return true;
@@ -539,7 +572,6 @@ bool effectTritone(SwCompositor* cmp, const RenderEffectTritone* params, bool di
 {
     auto& bbox = cmp->bbox;
     auto w = size_t(bbox.max.x - bbox.min.x);
-    auto h = size_t(bbox.max.y - bbox.min.y);
     auto shadow = cmp->recoverSfc->join(params->shadow[0], params->shadow[1], params->shadow[2], 255);
     auto midtone = cmp->recoverSfc->join(params->midtone[0], params->midtone[1], params->midtone[2], 255);
     auto highlight = cmp->recoverSfc->join(params->highlight[0], params->highlight[1], params->highlight[2], 255);
@@ -549,39 +581,43 @@ bool effectTritone(SwCompositor* cmp, const RenderEffectTritone* params, bool di
     TVGLOG("SW_ENGINE", "Tritone region(%d, %d, %d, %d), param(%d %d %d, %d %d %d, %d %d %d, %d)", bbox.min.x, bbox.min.y, bbox.max.x, bbox.max.y, params->shadow[0], params->shadow[1], params->shadow[2], params->midtone[0], params->midtone[1], params->midtone[2], params->highlight[0], params->highlight[1], params->highlight[2], params->blender);
 
     if (direct) {
-        auto dbuffer = cmp->recoverSfc->buf32 + (bbox.min.y * cmp->recoverSfc->stride + bbox.min.x);
-        auto sbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
-        for (size_t y = 0; y < h; ++y) {
-            auto dst = dbuffer;
-            auto src = sbuffer;
-            if (params->blender == 0) {
-                for (size_t x = 0; x < w; ++x, ++dst, ++src) {
-                    *dst = INTERPOLATE(_trintone(shadow, midtone, highlight, luma((uint8_t*)src)), *dst, MULTIPLY(opacity, A(*src)));
-                }
-            } else {
-                for (size_t x = 0; x < w; ++x, ++dst, ++src) {
-                    *dst = INTERPOLATE(INTERPOLATE(*src, _trintone(shadow, midtone, highlight, luma((uint8_t*)src)), params->blender), *dst, MULTIPLY(opacity, A(*src)));
+        rasterBands(cmp->recoverSfc, bbox, [&](const RenderRegion& band) {
+            auto dbuffer = cmp->recoverSfc->buf32 + (band.min.y * cmp->recoverSfc->stride + bbox.min.x);
+            auto sbuffer = cmp->image.buf32 + (band.min.y * cmp->image.stride + bbox.min.x);
+            for (auto y = band.min.y; y < band.max.y; ++y) {
+                auto dst = dbuffer;
+                auto src = sbuffer;
+                if (params->blender == 0) {
+                    for (size_t x = 0; x < w; ++x, ++dst, ++src) {
+                        *dst = INTERPOLATE(_trintone(shadow, midtone, highlight, luma((uint8_t*)src)), *dst, MULTIPLY(opacity, A(*src)));
+                    }
+                } else {
+                    for (size_t x = 0; x < w; ++x, ++dst, ++src) {
+                        *dst = INTERPOLATE(INTERPOLATE(*src, _trintone(shadow, midtone, highlight, luma((uint8_t*)src)), params->blender), *dst, MULTIPLY(opacity, A(*src)));
+                    }
                 }
+                dbuffer += cmp->image.stride;
+                sbuffer += cmp->recoverSfc->stride;
             }
-            dbuffer += cmp->image.stride;
-            sbuffer += cmp->recoverSfc->stride;
-        }
+        });
         cmp->valid = true;  //no need the subsequent composition
     } else {
-        auto dbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
-        for (size_t y = 0; y < h; ++y) {
-            auto dst = dbuffer;
-            if (params->blender == 0) {
-                for (size_t x = 0; x < w; ++x, ++dst) {
-                    *dst = ALPHA_BLEND(_trintone(shadow, midtone, highlight, luma((uint8_t*)dst)), MULTIPLY(A(*dst), opacity));
-                }
-            } else {
-                for (size_t x = 0; x < w; ++x, ++dst) {
-                    *dst = ALPHA_BLEND(INTERPOLATE(*dst, _trintone(shadow, midtone, highlight, luma((uint8_t*)dst)), params->blender), MULTIPLY(A(*dst), opacity));
+        rasterBands(cmp->recoverSfc, bbox, [&](const RenderRegion& band) {
+            auto dbuffer = cmp->image.buf32 + (band.min.y * cmp->image.stride + bbox.min.x);
+            for (auto y = band.min.y; y < band.max.y; ++y) {
+                auto dst = dbuffer;
+                if (params->blender == 0) {
+                    for (size_t x = 0; x < w; ++x, ++dst) {
+                        *dst = ALPHA_BLEND(_trintone(shadow, midtone, highlight, luma((uint8_t*)dst)), MULTIPLY(A(*dst), opacity));
+                    }
+                } else {
+                    for (size_t x = 0; x < w; ++x, ++dst) {
+                        *dst = ALPHA_BLEND(INTERPOLATE(*dst, _trintone(shadow, midtone, highlight, luma((uint8_t*)dst)), params->blender), MULTIPLY(A(*dst), opacity));
+                    }
                 }
+                dbuffer += cmp->image.stride;
             }
-            dbuffer += cmp->image.stride;
-        }
+        });
     }
 
     return true;
@@ -22,6 +22,7 @@
 
 #include "tvgMath.h"
 #include "tvgRender.h"
+#include "tvgTaskScheduler.h"
 #include "tvgSwCommon.h"
 
 /************************************************************************/
@@ -29,6 +30,8 @@
 /************************************************************************/
 
 constexpr auto DOWN_SCALE_TOLERANCE = 0.5f;
+constexpr auto BAND_MIN_HEIGHT = 16;        //experimental decision
+constexpr auto BAND_MIN_PIXELS = 16384;     //experimental decision, small jobs don't pay off the dispatching cost
 
 struct FillLinear
 {
@@ -42,6 +45,16 @@ struct FillLinear
         fillLinear(fill, dst, y, x, len, cmp, op, a);
     }
 
+    void operator()(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len)
+    {
+        fillLinear(fill, dst, y, x, len);
+    }
+
+    void operator()(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t a)
+    {
+        fillLinear(fill, dst, y, x, len, a);
+    }
+
     void operator()(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, SwBlender op, uint8_t a)
     {
         fillLinear(fill, dst, y, x, len, op, a);
@@ -71,6 +84,16 @@ struct FillRadial
         fillRadial(fill, dst, y, x, len, cmp, op, a);
     }
 
+    void operator()(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len)
+    {
+        fillRadial(fill, dst, y, x, len);
+    }
+
+    void operator()(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t a)
+    {
+        fillRadial(fill, dst, y, x, len, a);
+    }
+
     void operator()(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, SwBlender op, uint8_t a)
     {
         fillRadial(fill, dst, y, x, len, op, a);
@@ -199,6 +222,62 @@ static inline uint8_t _opMaskDarken(uint8_t s, uint8_t d, uint8_t a)
 }
 
 
+#define SW_LUMA_CHUNK 256    //the compositor pixels converted to the luma masks at once
+
+static inline bool _alphaMatting(MaskMethod method)
+{
+    return method == MaskMethod::Alpha || method == MaskMethod::InvAlpha;
+}
+
+
+//the mattings are taken over by the pixel kernels, the luma ones are converted to the 8bits masks by chunks in advance.
+static void _matting(SwSurface* surface, uint32_t* dst, uint32_t color, const uint8_t* cmp, uint32_t len)
+{
+    auto method = surface->compositor->method;
+    auto csize = surface->compositor->image.channelSize;
+
+    if (_alphaMatting(method)) {
+        swKernels.mattedColor(dst, color, cmp, len, csize, method == MaskMethod::InvAlpha);
+        return;
+    }
+
+    auto abgr = (surface->cs == ColorSpace::ABGR8888 || surface->cs == ColorSpace::ABGR8888S);
+    uint8_t luma[SW_LUMA_CHUNK];
+    while (len > 0) {
+        auto cnt = std::min(len, (uint32_t) SW_LUMA_CHUNK);
+        swKernels.luma(luma, (const uint32_t*) cmp, cnt, abgr, method == MaskMethod::InvLuma);
+        swKernels.mattedColor(dst, color, luma, cnt, sizeof(uint8_t), false);
+        dst += cnt;
+        cmp += cnt * csize;
+        len -= cnt;
+    }
+}
+
+
+static void _matting(SwSurface* surface, uint32_t* dst, const uint32_t* src, const uint8_t* cmp, uint32_t len, uint8_t opacity)
+{
+    auto method = surface->compositor->method;
+    auto csize = surface->compositor->image.channelSize;
+
+    if (_alphaMatting(method)) {
+        swKernels.mattedPixels(dst, src, cmp, len, csize, opacity, method == MaskMethod::InvAlpha);
+        return;
+    }
+
+    auto abgr = (surface->cs == ColorSpace::ABGR8888 || surface->cs == ColorSpace::ABGR8888S);
+    uint8_t luma[SW_LUMA_CHUNK];
+    while (len > 0) {
+        auto cnt = std::min(len, (uint32_t) SW_LUMA_CHUNK);
+        swKernels.luma(luma, (const uint32_t*) cmp, cnt, abgr, method == MaskMethod::InvLuma);
+        swKernels.mattedPixels(dst, src, luma, cnt, sizeof(uint8_t), opacity, false);
+        dst += cnt;
+        src += cnt;
+        cmp += cnt * csize;
+        len -= cnt;
+    }
+}
+
+
 static inline bool _direct(MaskMethod method)
 {
     if (method == MaskMethod::Subtract || method == MaskMethod::Intersect || method == MaskMethod::Darken) return true;
@@ -239,9 +318,6 @@ static bool _compositeMaskImage(SwSurface* surface, const SwImage& image, const
 
 
 #include "tvgSwRasterTexmap.h"
-#include "tvgSwRasterC.h"
-#include "tvgSwRasterAvx.h"
-#include "tvgSwRasterNeon.h"
 
 
 static inline uint32_t _sampleSize(float scale)
@@ -380,12 +456,7 @@ static bool _rasterMattedRect(SwSurface* surface, const RenderRegion& bbox, cons
         auto color = surface->join(c.r, c.g, c.b, c.a);
         auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
         for (uint32_t y = 0; y < bbox.h(); ++y) {
-            auto dst = &buffer[y * surface->stride];
-            auto cmp = &cbuffer[y * surface->compositor->image.stride * csize];
-            for (uint32_t x = 0; x < bbox.w(); ++x, ++dst, cmp += csize) {
-                auto tmp = ALPHA_BLEND(color, alpha(cmp));
-                *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
-            }
+            _matting(surface, &buffer[y * surface->stride], color, &cbuffer[y * surface->compositor->image.stride * csize], bbox.w());
         }
     //8bits grayscale
     } else if (surface->channelSize == sizeof(uint8_t)) {
@@ -421,13 +492,25 @@ static bool _rasterBlendingRect(SwSurface* surface, const RenderRegion& bbox, co
 
 static bool _rasterTranslucentRect(SwSurface* surface, const RenderRegion& bbox, const RenderColor& c)
 {
-#if defined(THORVG_AVX_VECTOR_SUPPORT)
-    return avxRasterTranslucentRect(surface, bbox, c);
-#elif defined(THORVG_NEON_VECTOR_SUPPORT)
-    return neonRasterTranslucentRect(surface, bbox, c);
-#else
-    return cRasterTranslucentRect(surface, bbox, c);
-#endif
+    //32bits channels
+    if (surface->channelSize == sizeof(uint32_t)) {
+        auto color = surface->join(c.r, c.g, c.b, c.a);
+        auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+        for (uint32_t y = 0; y < bbox.h(); ++y, buffer += surface->stride) {
+            swKernels.translucentColor(buffer, color, bbox.w());
+        }
+    //8bit grayscale
+    } else if (surface->channelSize == sizeof(uint8_t)) {
+        auto buffer = surface->buf8 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto ialpha = ~c.a;
+        for (uint32_t y = 0; y < bbox.h(); ++y) {
+            auto dst = &buffer[y * surface->stride];
+            for (uint32_t x = 0; x < bbox.w(); ++x, ++dst) {
+                *dst = c.a + MULTIPLY(*dst, ialpha);
+            }
+        }
+    }
+    return true;
 }
 
 
@@ -537,7 +620,8 @@ static bool _rasterMattedRle(SwSurface* surface, SwRle* rle, const RenderRegion&
 
     auto cbuffer = surface->compositor->image.buf8;
     auto csize = surface->compositor->image.channelSize;
-    auto alpha = surface->alpha(surface->compositor->method);
+    auto method = surface->compositor->method;
+    auto alpha = surface->alpha(method);
     const SwSpan* end;
     int32_t x, len;
 
@@ -551,10 +635,7 @@ static bool _rasterMattedRle(SwSurface* surface, SwRle* rle, const RenderRegion&
             auto cmp = &cbuffer[(span->y * surface->compositor->image.stride + x) * csize];
             if (span->coverage == 255) src = color;
             else src = ALPHA_BLEND(color, span->coverage);
-            for (auto x = 0; x < len; ++x, ++dst, cmp += csize) {
-                auto tmp = ALPHA_BLEND(src, alpha(cmp));
-                *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
-            }
+            _matting(surface, dst, src, cmp, len);
         }
     //8bit grayscale
     } else if (surface->channelSize == sizeof(uint8_t)) {
@@ -602,13 +683,32 @@ static bool _rasterBlendingRle(SwSurface* surface, const SwRle* rle, const Rende
 
 static bool _rasterTranslucentRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const RenderColor& c)
 {
-#if defined(THORVG_AVX_VECTOR_SUPPORT)
-    return avxRasterTranslucentRle(surface, rle, bbox, c);
-#elif defined(THORVG_NEON_VECTOR_SUPPORT)
-    return neonRasterTranslucentRle(surface, rle, bbox, c);
-#else
-    return cRasterTranslucentRle(surface, rle, bbox, c);
-#endif
+    const SwSpan* end;
+    int32_t x, len;
+
+    //32bit channels
+    if (surface->channelSize == sizeof(uint32_t)) {
+        auto color = surface->join(c.r, c.g, c.b, c.a);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto src = (span->coverage < 255) ? ALPHA_BLEND(color, span->coverage) : color;
+            swKernels.translucentColor(&surface->buf32[span->y * surface->stride + x], src, len);
+        }
+    //8bit grayscale
+    } else if (surface->channelSize == sizeof(uint8_t)) {
+        uint8_t src;
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf8[span->y * surface->stride + x];
+            if (span->coverage < 255) src = MULTIPLY(span->coverage, c.a);
+            else src = c.a;
+            auto ialpha = ~c.a;
+            for (auto x = 0; x < len; ++x, ++dst) {
+                *dst = src + MULTIPLY(*dst, ialpha);
+            }
+        }
+    }
+    return true;
 }
 
 
@@ -622,15 +722,10 @@ static bool _rasterSolidRle(SwSurface* surface, const SwRle* rle, const RenderRe
         auto color = surface->join(c.r, c.g, c.b, 255);
         for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
             if (!span->fetch(bbox, x, len)) continue;
-            if (span->coverage == 255) rasterPixel32(surface->buf32 + span->y * surface->stride, color, x, len);
-            else {
-                auto dst = &surface->buf32[span->y * surface->stride + x];
-                auto src = ALPHA_BLEND(color, span->coverage);
-                auto ialpha = 255 - span->coverage;
-                for (auto x = 0; x < len; ++x, ++dst) {
-                    *dst = src + ALPHA_BLEND(*dst, ialpha);
-                }
-            }
+            auto dst = &surface->buf32[span->y * surface->stride + x];
+            //the blended color alpha is the coverage, see ALPHA_BLEND()
+            if (span->coverage == 255) swKernels.fill32(dst, color, len);
+            else swKernels.translucentColor(dst, ALPHA_BLEND(color, span->coverage), len);
         }
     //8bit grayscale
     } else if (surface->channelSize == sizeof(uint8_t)) {
@@ -703,12 +798,16 @@ static bool _rasterScaledMattedRleImage(SwSurface* surface, const SwImage& image
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
 
-    ARRAY_FOREACH(span, image.rle->spans) {
+    const SwSpan* end;
+    int32_t x0, len;
+
+    for (auto span = image.rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x0, len)) continue;
         SCALED_IMAGE_RANGE_Y(span->y)
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
-        auto cmp = &surface->compositor->image.buf8[(span->y * surface->compositor->image.stride + span->x) * csize];
+        auto dst = &surface->buf32[span->y * surface->stride + x0];
+        auto cmp = &surface->compositor->image.buf8[(span->y * surface->compositor->image.stride + x0) * csize];
         auto a = MULTIPLY(span->coverage, opacity);
-        for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst, cmp += csize) {
+        for (auto x = x0; x < x0 + len; ++x, ++dst, cmp += csize) {
             SCALED_IMAGE_RANGE_X
             auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
             src = ALPHA_BLEND(src, (a == 255) ? alpha(cmp) : MULTIPLY(alpha(cmp), a));
@@ -725,19 +824,23 @@ static bool _rasterScaledBlendingRleImage(SwSurface* surface, const SwImage& ima
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
 
-    ARRAY_FOREACH(span, image.rle->spans) {
+    const SwSpan* end;
+    int32_t x0, len;
+
+    for (auto span = image.rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x0, len)) continue;
         SCALED_IMAGE_RANGE_Y(span->y)
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
+        auto dst = &surface->buf32[span->y * surface->stride + x0];
         auto alpha = MULTIPLY(span->coverage, opacity);
         if (alpha == 255) {
-            for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst) {
+            for (auto x = x0; x < x0 + len; ++x, ++dst) {
                 SCALED_IMAGE_RANGE_X
                 auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
                 auto tmp = surface->blender(src, *dst, 255);
                 *dst = INTERPOLATE(tmp, *dst, A(src));
             }
         } else {
-            for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst) {
+            for (auto x = x0; x < x0 + len; ++x, ++dst) {
                 SCALED_IMAGE_RANGE_X
                 auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
                 auto tmp = surface->blender(src, *dst, 255);
@@ -755,11 +858,15 @@ static bool _rasterScaledRleImage(SwSurface* surface, const SwImage& image, cons
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
 
-    ARRAY_FOREACH(span, image.rle->spans) {
+    const SwSpan* end;
+    int32_t x0, len;
+
+    for (auto span = image.rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x0, len)) continue;
         SCALED_IMAGE_RANGE_Y(span->y)
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
+        auto dst = &surface->buf32[span->y * surface->stride + x0];
         auto alpha = MULTIPLY(span->coverage, opacity);
-        for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst) {
+        for (auto x = x0; x < x0 + len; ++x, ++dst) {
             SCALED_IMAGE_RANGE_X
             auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
             if (alpha < 255) src = ALPHA_BLEND(src, alpha);
@@ -780,7 +887,6 @@ static bool _rasterDirectMattedRleImage(SwSurface* surface, const SwImage& image
 
     auto csize = surface->compositor->image.channelSize;
     auto cbuffer = surface->compositor->image.buf8;
-    auto alpha = surface->alpha(surface->compositor->method);
     const SwSpan* end;
     int32_t x, len;
 
@@ -789,18 +895,7 @@ static bool _rasterDirectMattedRleImage(SwSurface* surface, const SwImage& image
         auto dst = &surface->buf32[span->y * surface->stride + x];
         auto cmp = &cbuffer[(span->y * surface->compositor->image.stride + x) * csize];
         auto img = image.buf32 + (span->y + image.oy) * image.stride + (x + image.ox);
-        auto a = MULTIPLY(span->coverage, opacity);
-        if (a == 255) {
-            for (auto x = 0; x < len; ++x, ++dst, ++img, cmp += csize) {
-                auto tmp = ALPHA_BLEND(*img, alpha(cmp));
-                *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
-            }
-        } else {
-            for (auto x = 0; x < len; ++x, ++dst, ++img, cmp += csize) {
-                auto tmp = ALPHA_BLEND(*img, MULTIPLY(a, alpha(cmp)));
-                *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
-            }
-        }
+        _matting(surface, dst, img, cmp, len, MULTIPLY(span->coverage, opacity));
     }
     return true;
 }
@@ -975,7 +1070,8 @@ static bool _rasterDirectMaskedImage(SwSurface* surface, const SwImage& image, c
 static bool _rasterDirectMattedImage(SwSurface* surface, const SwImage& image, const RenderRegion& bbox, int32_t w, int32_t h, uint8_t opacity)
 {
     auto csize = surface->compositor->image.channelSize;
-    auto alpha = surface->alpha(surface->compositor->method);
+    auto method = surface->compositor->method;
+    auto alpha = surface->alpha(method);
     auto sbuffer = image.buf32 + (bbox.min.y + image.oy) * image.stride + (bbox.min.x + image.ox);
     auto cbuffer = surface->compositor->image.buf8 + (bbox.min.y * surface->compositor->image.stride + bbox.min.x) * csize; //compositor buffer
 
@@ -985,19 +1081,7 @@ static bool _rasterDirectMattedImage(SwSurface* surface, const SwImage& image, c
     if (surface->channelSize == sizeof(uint32_t)) {
         auto dbuffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
         for (auto y = 0; y < h; ++y, dbuffer += surface->stride, sbuffer += image.stride) {
-            auto cmp = cbuffer;
-            auto src = sbuffer;
-            if (opacity == 255) {
-                for (auto dst = dbuffer; dst < dbuffer + w; ++dst, ++src, cmp += csize) {
-                    auto tmp = ALPHA_BLEND(*src, alpha(cmp));
-                    *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
-                }
-            } else {
-                for (auto dst = dbuffer; dst < dbuffer + w; ++dst, ++src, cmp += csize) {
-                    auto tmp = ALPHA_BLEND(*src, MULTIPLY(opacity, alpha(cmp)));
-                    *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
-                }
-            }
+            _matting(surface, dbuffer, sbuffer, cbuffer, w, opacity);
             cbuffer += surface->compositor->image.stride * csize;
         }
     //8 bits
@@ -1206,7 +1290,7 @@ static bool _rasterTranslucentGradientRect(SwSurface* surface, const RenderRegio
     if (surface->channelSize == sizeof(uint32_t)) {
         auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
         for (uint32_t y = 0; y < bbox.h(); ++y) {
-            fillMethod()(fill, buffer, bbox.min.y + y, bbox.min.x, bbox.w(), opBlendPreNormal, 255);
+            fillMethod()(fill, buffer, bbox.min.y + y, bbox.min.x, bbox.w(), 255);
             buffer += surface->stride;
         }
     //8 bits
@@ -1228,7 +1312,7 @@ static bool _rasterSolidGradientRect(SwSurface* surface, const RenderRegion& bbo
     if (surface->channelSize == sizeof(uint32_t)) {
         auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
         for (uint32_t y = 0; y < bbox.h(); ++y) {
-            fillMethod()(fill, buffer, bbox.min.y + y, bbox.min.x, bbox.w(), opBlendSrcOver, 255);
+            fillMethod()(fill, buffer, bbox.min.y + y, bbox.min.x, bbox.w());
             buffer += surface->stride;
         }
     //8 bits
@@ -1278,39 +1362,43 @@ static bool _rasterRadialGradientRect(SwSurface* surface, const RenderRegion& bb
 /************************************************************************/
 
 template<typename fillMethod>
-static bool _rasterCompositeGradientMaskedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill, SwMask maskOp)
+static bool _rasterCompositeGradientMaskedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill, SwMask maskOp)
 {
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
     auto cstride = surface->compositor->image.stride;
     auto cbuffer = surface->compositor->image.buf8;
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto cmp = &cbuffer[span->y * cstride + span->x];
-        fillMethod()(fill, cmp, span->y, span->x, span->len, maskOp, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto cmp = &cbuffer[span->y * cstride + x];
+        fillMethod()(fill, cmp, span->y, x, len, maskOp, span->coverage);
     }
     return _compositeMaskImage(surface, surface->compositor->image, surface->compositor->bbox);
 }
 
 
 template<typename fillMethod>
-static bool _rasterDirectGradientMaskedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill, SwMask maskOp)
+static bool _rasterDirectGradientMaskedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill, SwMask maskOp)
 {
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
     auto cstride = surface->compositor->image.stride;
     auto cbuffer = surface->compositor->image.buf8;
     auto dbuffer = surface->buf8;
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto cmp = &cbuffer[span->y * cstride + span->x];
-        auto dst = &dbuffer[span->y * surface->stride + span->x];
-        fillMethod()(fill, dst, span->y, span->x, span->len, cmp, maskOp, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto cmp = &cbuffer[span->y * cstride + x];
+        auto dst = &dbuffer[span->y * surface->stride + x];
+        fillMethod()(fill, dst, span->y, x, len, cmp, maskOp, span->coverage);
     }
     return true;
 }
 
 
 template<typename fillMethod>
-static bool _rasterGradientMaskedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterGradientMaskedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     auto method = surface->compositor->method;
 
@@ -1318,61 +1406,67 @@ static bool _rasterGradientMaskedRle(SwSurface* surface, const SwRle* rle, const
 
     auto maskOp = _getMaskOp(method);
 
-    if (_direct(method)) return _rasterDirectGradientMaskedRle<fillMethod>(surface, rle, fill, maskOp);
-    else return _rasterCompositeGradientMaskedRle<fillMethod>(surface, rle, fill, maskOp);
+    if (_direct(method)) return _rasterDirectGradientMaskedRle<fillMethod>(surface, rle, bbox, fill, maskOp);
+    else return _rasterCompositeGradientMaskedRle<fillMethod>(surface, rle, bbox, fill, maskOp);
     return false;
 }
 
 
 template<typename fillMethod>
-static bool _rasterGradientMattedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterGradientMattedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     TVGLOG("SW_ENGINE", "Matted(%d) Rle Linear Gradient", (int)surface->compositor->method);
 
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
     auto csize = surface->compositor->image.channelSize;
     auto cbuffer = surface->compositor->image.buf8;
     auto alpha = surface->alpha(surface->compositor->method);
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
-        auto cmp = &cbuffer[(span->y * surface->compositor->image.stride + span->x) * csize];
-        fillMethod()(fill, dst, span->y, span->x, span->len, cmp, alpha, csize, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto dst = &surface->buf32[span->y * surface->stride + x];
+        auto cmp = &cbuffer[(span->y * surface->compositor->image.stride + x) * csize];
+        fillMethod()(fill, dst, span->y, x, len, cmp, alpha, csize, span->coverage);
     }
     return true;
 }
 
 
 template<typename fillMethod>
-static bool _rasterBlendingGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterBlendingGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
-        fillMethod()(fill, dst, span->y, span->x, span->len, opBlendPreNormal, surface->blender, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto dst = &surface->buf32[span->y * surface->stride + x];
+        fillMethod()(fill, dst, span->y, x, len, opBlendPreNormal, surface->blender, span->coverage);
     }
     return true;
 }
 
 
 template<typename fillMethod>
-static bool _rasterTranslucentGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterTranslucentGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
 
     //32 bits
     if (surface->channelSize == sizeof(uint32_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf32[span->y * surface->stride + span->x];
-            if (span->coverage == 255) fillMethod()(fill, dst, span->y, span->x, span->len, opBlendPreNormal, 255);
-            else fillMethod()(fill, dst, span->y, span->x, span->len, opBlendNormal, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf32[span->y * surface->stride + x];
+            fillMethod()(fill, dst, span->y, x, len, span->coverage);
         }
     //8 bits
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf8[span->y * surface->stride + span->x];
-            fillMethod()(fill, dst, span->y, span->x, span->len, _opMaskAdd, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf8[span->y * surface->stride + x];
+            fillMethod()(fill, dst, span->y, x, len, _opMaskAdd, span->coverage);
         }
     }
     return true;
@@ -1380,23 +1474,26 @@ static bool _rasterTranslucentGradientRle(SwSurface* surface, const SwRle* rle,
 
 
 template<typename fillMethod>
-static bool _rasterSolidGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterSolidGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
 
     //32 bits
     if (surface->channelSize == sizeof(uint32_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf32[span->y * surface->stride + span->x];
-            if (span->coverage == 255) fillMethod()(fill, dst, span->y, span->x, span->len, opBlendSrcOver, 255);
-            else fillMethod()(fill, dst, span->y, span->x, span->len, opBlendInterp, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf32[span->y * surface->stride + x];
+            if (span->coverage == 255) fillMethod()(fill, dst, span->y, x, len);
+            else fillMethod()(fill, dst, span->y, x, len, opBlendInterp, span->coverage);
         }
     //8 bits
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf8[span->y * surface->stride + span->x];
-            if (span->coverage == 255) fillMethod()(fill, dst, span->y, span->x, span->len, _opMaskNone, 255);
-            else fillMethod()(fill, dst, span->y, span->x, span->len, _opMaskAdd, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf8[span->y * surface->stride + x];
+            if (span->coverage == 255) fillMethod()(fill, dst, span->y, x, len, _opMaskNone, 255);
+            else fillMethod()(fill, dst, span->y, x, len, _opMaskAdd, span->coverage);
         }
     }
 
@@ -1404,75 +1501,112 @@ static bool _rasterSolidGradientRle(SwSurface* surface, const SwRle* rle, const
 }
 
 
-static bool _rasterLinearGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterLinearGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     if (_compositing(surface)) {
-        if (_matting(surface)) return _rasterGradientMattedRle<FillLinear>(surface, rle, fill);
-        else return _rasterGradientMaskedRle<FillLinear>(surface, rle, fill);
+        if (_matting(surface)) return _rasterGradientMattedRle<FillLinear>(surface, rle, bbox, fill);
+        else return _rasterGradientMaskedRle<FillLinear>(surface, rle, bbox, fill);
     } else if (_blending(surface)) {
-        return _rasterBlendingGradientRle<FillLinear>(surface, rle, fill);
+        return _rasterBlendingGradientRle<FillLinear>(surface, rle, bbox, fill);
     } else {
-        if (fill->translucent) return _rasterTranslucentGradientRle<FillLinear>(surface, rle, fill);
-        else return _rasterSolidGradientRle<FillLinear>(surface, rle, fill);
+        if (fill->translucent) return _rasterTranslucentGradientRle<FillLinear>(surface, rle, bbox, fill);
+        else return _rasterSolidGradientRle<FillLinear>(surface, rle, bbox, fill);
     }
     return false;
 }
 
 
-static bool _rasterRadialGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterRadialGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     if (_compositing(surface)) {
-        if (_matting(surface)) return _rasterGradientMattedRle<FillRadial>(surface, rle, fill);
-        else return _rasterGradientMaskedRle<FillRadial>(surface, rle, fill);
+        if (_matting(surface)) return _rasterGradientMattedRle<FillRadial>(surface, rle, bbox, fill);
+        else return _rasterGradientMaskedRle<FillRadial>(surface, rle, bbox, fill);
     } else if (_blending(surface)) {
-        return _rasterBlendingGradientRle<FillRadial>(surface, rle, fill);
+        return _rasterBlendingGradientRle<FillRadial>(surface, rle, bbox, fill);
     } else {
-        if (fill->translucent) return _rasterTranslucentGradientRle<FillRadial>(surface, rle, fill);
-        else return _rasterSolidGradientRle<FillRadial>(surface, rle, fill);
+        if (fill->translucent) return _rasterTranslucentGradientRle<FillRadial>(surface, rle, bbox, fill);
+        else return _rasterSolidGradientRle<FillRadial>(surface, rle, bbox, fill);
     }
     return false;
 }
 
 
+/************************************************************************/
+/* Clear                                                                */
+/************************************************************************/
+
+static bool _rasterClear(SwSurface* surface, uint32_t x, uint32_t y, uint32_t w, uint32_t h, pixel_t val)
+{
+    //32 bits
+    if (surface->channelSize == sizeof(uint32_t)) {
+        //full clear
+        if (w == surface->stride) {
+            rasterPixel32(surface->buf32, val, surface->stride * y, w * h);
+        //partial clear
+        } else {
+            for (uint32_t i = 0; i < h; i++) {
+                rasterPixel32(surface->buf32, val, (surface->stride * y + x) + (surface->stride * i), w);
+            }
+        }
+    //8 bits
+    } else if (surface->channelSize == sizeof(uint8_t)) {
+        //full clear
+        if (w == surface->stride) {
+            rasterGrayscale8(surface->buf8, 0x00, surface->stride * y, w * h);
+        //partial clear
+        } else {
+            for (uint32_t i = 0; i < h; i++) {
+                rasterGrayscale8(surface->buf8, 0x00, (surface->stride * y + x) + (surface->stride * i), w);
+            }
+        }
+    }
+    return true;
+}
+
+
+/************************************************************************/
+/* Raster Bands                                                         */
+/************************************************************************/
+
+struct SwBandTask : Task
+{
+    SwBandFunc func;
+    void* data;
+    RenderRegion band;
+
+    void run(TVG_UNUSED unsigned tid) override
+    {
+        func(data, band);
+    }
+};
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
 
 void rasterTranslucentPixel32(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity)
 {
-    //TODO: Support SIMD accelerations
-    cRasterTranslucentPixels(dst, src, len, opacity);
+    swKernels.translucentPixels(dst, src, len, opacity);
 }
 
 
 void rasterPixel32(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity)
 {
-    //TODO: Support SIMD accelerations
-    cRasterPixels(dst, src, len, opacity);
+    if (opacity == 255) memcpy(dst, src, len * sizeof(uint32_t));
+    else swKernels.translucentPixels(dst, src, len, opacity);
 }
 
 
 void rasterGrayscale8(uint8_t *dst, uint8_t val, uint32_t offset, int32_t len)
 {
-#if defined(THORVG_AVX_VECTOR_SUPPORT)
-    avxRasterGrayscale8(dst, val, offset, len);
-#elif defined(THORVG_NEON_VECTOR_SUPPORT)
-    neonRasterGrayscale8(dst, val, offset, len);
-#else
-    cRasterPixels(dst, val, offset, len);
-#endif
+    swKernels.fill8(dst + offset, val, len);
 }
 
 
 void rasterPixel32(uint32_t *dst, uint32_t val, uint32_t offset, int32_t len)
 {
-#if defined(THORVG_AVX_VECTOR_SUPPORT)
-    avxRasterPixel32(dst, val, offset, len);
-#elif defined(THORVG_NEON_VECTOR_SUPPORT)
-    neonRasterPixel32(dst, val, offset, len);
-#else
-    cRasterPixels(dst, val, offset, len);
-#endif
+    swKernels.fill32(dst + offset, val, len);
 }
 
 
@@ -1498,33 +1632,49 @@ bool rasterCompositor(SwSurface* surface)
 }
 
 
+void rasterBands(const SwSurface* surface, const RenderRegion& bbox, SwBandFunc func, void* data)
+{
+    if (bbox.invalid()) return;
+
+    auto cnt = std::min(std::min((int32_t)surface->bands, bbox.sh() / BAND_MIN_HEIGHT), (int32_t)(((int64_t)bbox.sw() * bbox.sh()) / BAND_MIN_PIXELS));
+
+    //nested requests from the worker threads may starve the task scheduler
+    if (cnt < 2 || TaskScheduler::onthread()) {
+        func(data, bbox);
+        return;
+    }
+
+    SwBandTask tasks[SW_MAX_BANDS];
+    TaskGroup group;
+    cnt = std::min(cnt, SW_MAX_BANDS);
+
+    //split the region into the horizontal bands, they don't share any pixel rows
+    auto height = bbox.sh() / cnt;
+    auto rest = bbox.sh() % cnt;
+    auto y = bbox.min.y;
+
+    for (int32_t i = 0; i < cnt; ++i) {
+        auto& task = tasks[i];
+        task.func = func;
+        task.data = data;
+        task.band = {{bbox.min.x, y}, {bbox.max.x, y + height + (i < rest ? 1 : 0)}};
+        y = task.band.max.y;
+    }
+
+    //the current thread takes the first band
+    for (int32_t i = 1; i < cnt; ++i) TaskScheduler::request(&tasks[i], &group);
+    func(data, tasks[0].band);
+    group.wait();
+}
+
+
 bool rasterClear(SwSurface* surface, uint32_t x, uint32_t y, uint32_t w, uint32_t h, pixel_t val)
 {
     if (!surface || !surface->buf32 || surface->stride == 0 || surface->w == 0 || surface->h == 0) return false;
 
-    //32 bits
-    if (surface->channelSize == sizeof(uint32_t)) {
-        //full clear
-        if (w == surface->stride) {
-            rasterPixel32(surface->buf32, val, surface->stride * y, w * h);
-        //partial clear
-        } else {
-            for (uint32_t i = 0; i < h; i++) {
-                rasterPixel32(surface->buf32, val, (surface->stride * y + x) + (surface->stride * i), w);
-            }
-        }
-    //8 bits
-    } else if (surface->channelSize == sizeof(uint8_t)) {
-        //full clear
-        if (w == surface->stride) {
-            rasterGrayscale8(surface->buf8, 0x00, surface->stride * y, w * h);
-        //partial clear
-        } else {
-            for (uint32_t i = 0; i < h; i++) {
-                rasterGrayscale8(surface->buf8, 0x00, (surface->stride * y + x) + (surface->stride * i), w);
-            }
-        }
-    }
+    rasterBands(surface, {{int32_t(x), int32_t(y)}, {int32_t(x + w), int32_t(y + h)}}, [&](const RenderRegion& band) {
+        _rasterClear(surface, band.x(), band.y(), band.w(), band.h(), val);
+    });
     return true;
 }
 
@@ -1546,12 +1696,9 @@ void rasterUnpremultiply(RenderSurface* surface)
 
     TVGLOG("SW_ENGINE", "Unpremultiply [Size: %d x %d]", surface->w, surface->h);
 
-    //OPTIMIZE_ME: +SIMD
-    for (uint32_t y = 0; y < surface->h; y++) {
-        auto buffer = surface->buf32 + surface->stride * y;
-        for (uint32_t x = 0; x < surface->w; ++x) {
-            buffer[x] = rasterUnpremultiply(buffer[x]);
-        }
+    auto buffer = surface->buf32;
+    for (uint32_t y = 0; y < surface->h; ++y, buffer += surface->stride) {
+        swKernels.unpremultiply(buffer, surface->w);
     }
     surface->premultiplied = false;
 }
@@ -1565,16 +1712,9 @@ void rasterPremultiply(RenderSurface* surface)
 
     TVGLOG("SW_ENGINE", "Premultiply [Size: %d x %d]", surface->w, surface->h);
 
-    //OPTIMIZE_ME: +SIMD
     auto buffer = surface->buf32;
     for (uint32_t y = 0; y < surface->h; ++y, buffer += surface->stride) {
-        auto dst = buffer;
-        for (uint32_t x = 0; x < surface->w; ++x, ++dst) {
-            auto c = *dst;
-            auto a = (c >> 24);
-            if (a == 255) continue;
-            *dst = (c & 0xff000000) + ((((c >> 8) & 0xff) * a) & 0xff00) + ((((c & 0x00ff00ff) * a) >> 8) & 0x00ff00ff);
-        }
+        swKernels.premultiply(buffer, surface->w);
     }
 }
 
@@ -1674,8 +1814,8 @@ bool rasterGradientShape(SwSurface* surface, SwShape* shape, const RenderRegion&
         if (type == Type::LinearGradient) return _rasterLinearGradientRect(surface, bbox, shape->fill);
         else if (type == Type::RadialGradient)return _rasterRadialGradientRect(surface, bbox, shape->fill);
     } else if (shape->rle && shape->rle->valid()) {
-        if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->rle, shape->fill);
-        else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->rle, shape->fill);
+        if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->rle, bbox, shape->fill);
+        else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->rle, bbox, shape->fill);
     } return false;
 }
 
@@ -1691,8 +1831,8 @@ bool rasterGradientStroke(SwSurface* surface, SwShape* shape, const RenderRegion
     }
 
     auto type = fdata->type();
-    if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->strokeRle, shape->stroke->fill);
-    else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->strokeRle, shape->stroke->fill);
+    if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->strokeRle, bbox, shape->stroke->fill);
+    else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->strokeRle, bbox, shape->stroke->fill);
     return false;
 }
 
@@ -1726,23 +1866,26 @@ bool rasterConvertCS(RenderSurface* surface, ColorSpace to)
     ScopedLock lock(surface->key);
     if (surface->cs == to) return true;
 
-    //TODO: Support SIMD accelerations
     auto from = surface->cs;
+    auto abgr = [](ColorSpace cs) { return cs == ColorSpace::ABGR8888 || cs == ColorSpace::ABGR8888S; };
+    auto argb = [](ColorSpace cs) { return cs == ColorSpace::ARGB8888 || cs == ColorSpace::ARGB8888S; };
 
-    if (((from == ColorSpace::ABGR8888) || (from == ColorSpace::ABGR8888S)) && ((to == ColorSpace::ARGB8888) || (to == ColorSpace::ARGB8888S))) {
+    //flip Blue, Red channels
+    if ((abgr(from) && argb(to)) || (argb(from) && abgr(to))) {
+        TVGLOG("SW_ENGINE", "Convert ColorSpace %s [Size: %d x %d]", abgr(from) ? "ABGR - ARGB" : "ARGB - ABGR", surface->w, surface->h);
         surface->cs = to;
-        return cRasterABGRtoARGB(surface);
-    }
-    if (((from == ColorSpace::ARGB8888) || (from == ColorSpace::ARGB8888S)) && ((to == ColorSpace::ABGR8888) || (to == ColorSpace::ABGR8888S))) {
-        surface->cs = to;
-        return cRasterARGBtoABGR(surface);
+        auto buffer = surface->buf32;
+        for (uint32_t y = 0; y < surface->h; ++y, buffer += surface->stride) {
+            swKernels.swapRB(buffer, surface->w);
+        }
+        return true;
     }
     return false;
 }
 
 
 //TODO: SIMD OPTIMIZATION?
-void rasterXYFlip(uint32_t* src, uint32_t* dst, int32_t stride, int32_t w, int32_t h, const RenderRegion& bbox, bool flipped)
+void rasterXYFlip(const SwSurface* surface, uint32_t* src, uint32_t* dst, int32_t stride, int32_t w, int32_t h, const RenderRegion& bbox, bool flipped)
 {
     constexpr int32_t BLOCK = 8;  //experimental decision
 
@@ -1754,24 +1897,15 @@ void rasterXYFlip(uint32_t* src, uint32_t* dst, int32_t stride, int32_t w, int32
         dst += ((bbox.min.x * stride) + bbox.min.y);
     }
 
-    #pragma omp parallel for
-    for (int32_t x = 0; x < w; x += BLOCK) {
-        auto bx = std::min(w, x + BLOCK) - x;
-        auto in = &src[x];
-        auto out = &dst[x * stride];
-        for (int32_t y = 0; y < h; y += BLOCK) {
-            auto p = &in[y * stride];
-            auto q = &out[y];
-            auto by = std::min(h, y + BLOCK) - y;
-            for (int32_t xx = 0; xx < bx; ++xx) {
-                for (int32_t yy = 0; yy < by; ++yy) {
-                    *q = *p;
-                    p += stride;
-                    ++q;
-                }
-                p += 1 - by * stride;
-                q += stride - by;
+    //the source columns turn to the destination rows, so the bands are distributed along the x axis
+    rasterBands(surface, {{0, 0}, {h, w}}, [&](const RenderRegion& band) {
+        //transpose tile by tile, both of the source and destination tiles stay in the cache
+        for (int32_t x = band.min.y; x < band.max.y; x += BLOCK) {
+            auto bx = std::min(band.max.y, x + BLOCK) - x;
+            for (int32_t y = 0; y < h; y += BLOCK) {
+                auto by = std::min(h, y + BLOCK) - y;
+                swKernels.transpose(&dst[x * stride + y], stride, &src[y * stride + x], stride, bx, by);
             }
         }
-    }
-}
\ No newline at end of file
+    });
+}
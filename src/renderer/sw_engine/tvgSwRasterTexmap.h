@@ -452,16 +452,24 @@ static void _rasterPolygonImage(SwSurface* surface, const SwImage& image, const
 }
 
 
-static AASpans* _AASpans(int yStart, int yEnd)
+static uint32_t _AASpansSize(int yStart, int yEnd)
 {
-    auto aaSpans = tvg::malloc<AASpans*>(sizeof(AASpans));
+    return sizeof(AASpans) + std::max(yEnd - yStart, 0) * sizeof(AALine);
+}
+
+
+//the spans and the lines in one transient memory of the render thread
+static AASpans* _AASpans(int yStart, int yEnd, SwMpool* mpool, unsigned tid)
+{
+    auto aaSpans = static_cast<AASpans*>(mpoolAlloc(mpool, tid, _AASpansSize(yStart, yEnd)));
+    if (!aaSpans) return nullptr;
     aaSpans->yStart = yStart;
     aaSpans->yEnd = yEnd;
 
     //Initialize X range
     auto height = yEnd - yStart;
 
-    aaSpans->lines = tvg::malloc<AALine*>(height * sizeof(AALine));
+    aaSpans->lines = reinterpret_cast<AALine*>(aaSpans + 1);
 
     for (int32_t i = 0; i < height; i++) {
         aaSpans->lines[i].x[0] = INT32_MAX;
@@ -706,8 +714,6 @@ static void _apply(SwSurface* surface, AASpans* aaSpans)
         ++line;
         ++y;
     }
-    tvg::free(aaSpans->lines);
-    tvg::free(aaSpans);
 }
 
 
@@ -721,7 +727,7 @@ static void _apply(SwSurface* surface, AASpans* aaSpans)
     | /  |
     3 -- 2
 */
-bool rasterTexmapPolygon(SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity)
+bool rasterTexmapPolygon(SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity, SwMpool* mpool, unsigned tid)
 {
     if (surface->channelSize == sizeof(uint8_t)) {
         TVGERR("SW_ENGINE", "Not supported grayscale Textmap polygon!");
@@ -744,7 +750,7 @@ bool rasterTexmapPolygon(SwSurface* surface, const SwImage& image, const Matrix&
 
     auto yStart = std::max(static_cast<int>(ys), bbox.min.y);
     auto yEnd = std::min(static_cast<int>(ye), bbox.max.y);
-    auto aaSpans = rightAngle(transform) ?  nullptr : _AASpans(yStart, yEnd);
+    auto aaSpans = rightAngle(transform) ?  nullptr : _AASpans(yStart, yEnd, mpool, tid);
 
     Polygon polygon;
 
@@ -767,6 +773,9 @@ bool rasterTexmapPolygon(SwSurface* surface, const SwImage& image, const Matrix&
         _compositeMaskImage(surface, &surface->compositor->image, surface->compositor->bbox);
     }
 #endif
-    if (aaSpans) _apply(surface, aaSpans);
+    if (aaSpans) {
+        _apply(surface, aaSpans);
+        mpoolFree(mpool, tid, aaSpans, _AASpansSize(yStart, yEnd));
+    }
     return true;
 }
\ No newline at end of file
@@ -36,6 +36,24 @@ static atomic<int32_t> rendererCnt{-1};
 static SwMpool* globalMpool = nullptr;
 static uint32_t threadsCnt = 0;
 
+
+/* The composite masking blends the whole compositor region in a row,
+   it can't be split into the raster bands. */
+static inline bool _bandable(const SwSurface* surface)
+{
+    auto cmp = surface->compositor;
+    if (!cmp || (int)cmp->method < (int)MaskMethod::Add) return true;
+    return (cmp->method == MaskMethod::Subtract || cmp->method == MaskMethod::Intersect || cmp->method == MaskMethod::Darken);
+}
+
+
+template<typename Func>
+static inline void _rasterBands(const SwSurface* surface, const RenderRegion& bbox, const Func& func)
+{
+    if (_bandable(surface)) rasterBands(surface, bbox, func);
+    else func(bbox);
+}
+
 struct SwTask : Task
 {
     SwSurface* surface = nullptr;
@@ -65,6 +83,14 @@ struct SwTask : Task
         if (!nodirty) dirtyRegion->add(prvBox, curBox);
     }
 
+    void run(unsigned tid) override
+    {
+        work(tid);
+        //it's retained on the request, see SwRenderer::prepareCommon()
+        mpoolRelease(mpool);
+    }
+
+    virtual void work(unsigned tid) = 0;
     virtual void dispose() = 0;
     virtual bool clip(SwRle* target) = 0;
     virtual ~SwTask() {}
@@ -75,6 +101,7 @@ struct SwShapeTask : SwTask
 {
     SwShape shape;
     const RenderShape* rshape = nullptr;
+    SwGlyphCache* glyphs = nullptr;
     bool clipper = false;
 
     /* We assume that if the stroke width is greater than 2,
@@ -107,7 +134,7 @@ struct SwShapeTask : SwTask
         return false;
     }
 
-    void run(unsigned tid) override
+    void work(unsigned tid) override
     {
         //invisible
         if (opacity == 0 && !clipper) {
@@ -125,7 +152,9 @@ struct SwShapeTask : SwTask
             updateFill = (MULTIPLY(rshape->color.a, opacity) || rshape->fill);
             if (updateShape) shapeReset(&shape);
             if (updateFill || clipper) {
-                if (shapePrepare(&shape, rshape, transform, curBox, renderBox, mpool, tid, clips.count > 0 ? true : false)) {
+                if (glyphGenRle(&shape, rshape, transform, curBox, renderBox, glyphs, mpool, tid)) {
+                    //composed with the cached glyph images
+                } else if (shapePrepare(&shape, rshape, transform, curBox, renderBox, mpool, tid, clips.count > 0 ? true : false)) {
                     if (!shapeGenRle(&shape, rshape, antialiasing(strokeWidth))) goto err;
                 } else {
                     updateFill = false;
@@ -196,7 +225,7 @@ struct SwImageTask : SwTask
         return true;
     }
 
-    void run(unsigned tid) override
+    void work(unsigned tid) override
     {
         //invisible
         if (opacity == 0) {
@@ -272,12 +301,17 @@ SwRenderer::SwRenderer()
 
 SwRenderer::~SwRenderer()
 {
+    //the tasks could be still referring the group, even if they are done
+    group.wait();
+
     clearCompositors();
 
     delete(surface);
 
     if (!sharedMpool) mpoolTerm(mpool);
 
+    glyphCacheTerm(glyphs);
+
     --rendererCnt;
 }
 
@@ -294,6 +328,9 @@ bool SwRenderer::clear()
 
 bool SwRenderer::sync()
 {
+    //wait for all the requested tasks at once
+    group.wait();
+
     //clear if the rendering was not triggered.
     ARRAY_FOREACH(p, tasks) {
         if ((*p)->disposed) delete(*p);
@@ -304,6 +341,9 @@ bool SwRenderer::sync()
     }
     tasks.clear();
 
+    //the frame is over, recycle the transient memory
+    mpoolReset(mpool);
+
     return true;
 }
 
@@ -323,6 +363,7 @@ bool SwRenderer::target(pixel_t* data, uint32_t stride, uint32_t w, uint32_t h,
     surface->cs = cs;
     surface->channelSize = CHANNEL_SIZE(cs);
     surface->premultiplied = true;
+    surface->bands = bands;
 
     dirtyRegion.init(w, h);
 
@@ -411,31 +452,45 @@ bool SwRenderer::renderImage(RenderData data)
 
     if (task->opacity == 0) return true;
 
+    //the rendering runs on the requester thread, it could be a worker as well
+    auto tid = TaskScheduler::slot();
+
     auto raster = [&](SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity) {
         if (bbox.invalid() || bbox.x() >= surface->w || bbox.y() >= surface->h) return true;
 
         //RLE Image
         if (image.rle) {
-            if (image.direct) return rasterDirectRleImage(surface, image, bbox, opacity);
-            else if (image.scaled) return rasterScaledRleImage(surface, image, transform, bbox, opacity);
-            else {
+            if (image.direct) {
+                _rasterBands(surface, bbox, [&](const RenderRegion& band) { rasterDirectRleImage(surface, image, band, opacity); });
+            } else if (image.scaled) {
+                _rasterBands(surface, bbox, [&](const RenderRegion& band) { rasterScaledRleImage(surface, image, transform, band, opacity); });
+            } else {
                 //create a intermediate buffer for rle clipping
                 auto cmp = request(sizeof(pixel_t), false);
                 cmp->compositor->method = MaskMethod::None;
                 cmp->compositor->valid = true;
                 cmp->compositor->image.rle = image.rle;
                 rasterClear(cmp, bbox.x(), bbox.y(), bbox.w(), bbox.h(), 0);
-                rasterTexmapPolygon(cmp, image, transform, bbox, 255);
-                return rasterDirectRleImage(surface, cmp->compositor->image, bbox, opacity);
+                rasterTexmapPolygon(cmp, image, transform, bbox, 255, mpool, tid);
+                _rasterBands(surface, bbox, [&](const RenderRegion& band) { rasterDirectRleImage(surface, cmp->compositor->image, band, opacity); });
             }
         //Whole Image
         } else {
-            if (image.direct) return rasterDirectImage(surface, image, bbox, opacity);
-            else if (image.scaled) return rasterScaledImage(surface, image, transform, bbox, opacity);
-            else return rasterTexmapPolygon(surface, image, transform, bbox, opacity);
+            if (image.direct) {
+                _rasterBands(surface, bbox, [&](const RenderRegion& band) { rasterDirectImage(surface, image, band, opacity); });
+            } else if (image.scaled) {
+                _rasterBands(surface, bbox, [&](const RenderRegion& band) { rasterScaledImage(surface, image, transform, band, opacity); });
+            } else {
+                //the texture mapper is stateful, no banding
+                return rasterTexmapPolygon(surface, image, transform, bbox, opacity, mpool, tid);
+            }
         }
+        return true;
     };
 
+    //the texture mapper allocates the spans out of the arena
+    mpoolRetain(mpool);
+
     //full scene or partial rendering
     if (fulldraw || task->nodirty || task->pushed || dirtyRegion.deactivated()) {
         raster(surface, task->image, task->transform, task->curBox, task->opacity);
@@ -452,6 +507,8 @@ bool SwRenderer::renderImage(RenderData data)
         }
     }
 
+    mpoolRelease(mpool);
+
     task->prvBox = task->curBox;
 
     return true;
@@ -490,27 +547,33 @@ bool SwRenderer::renderShape(RenderData data)
         }
     };
 
+    //draw the fill and the stroke in order band by band, so that each band is composed independently
+    auto draw = [&](const RenderRegion& region) {
+        _rasterBands(surface, region, [&](const RenderRegion& band) {
+            auto fillBox = RenderRegion::intersect(task->shape.bbox, band);
+            auto strokeBox = RenderRegion::intersect(task->curBox, band);
+            if (task->rshape->strokeFirst()) {
+                if (strokeBox.valid()) stroke(task, surface, strokeBox);
+                if (fillBox.valid()) fill(task, surface, fillBox);
+            } else {
+                if (fillBox.valid()) fill(task, surface, fillBox);
+                if (strokeBox.valid()) stroke(task, surface, strokeBox);
+            }
+        });
+    };
+
+    auto bbox = task->curBox;
+    if (task->shape.bbox.valid()) bbox.add(task->shape.bbox);
+
     //full scene or partial rendering
     if (fulldraw || task->nodirty || task->pushed || dirtyRegion.deactivated()) {
-        if (task->rshape->strokeFirst()) {
-            stroke(task, surface, task->curBox);
-            fill(task, surface, task->shape.bbox);
-        } else {
-            fill(task, surface, task->shape.bbox);
-            stroke(task, surface, task->curBox);
-        }
+        draw(bbox);
     } else {
         for (int idx = 0; idx < RenderDirtyRegion::PARTITIONING; ++idx) {
             if (!dirtyRegion.partition(idx).intersected(task->curBox)) continue;
             ARRAY_FOREACH(p, dirtyRegion.get(idx)) {
                 if (task->curBox.min.x >= p->max.x) break;   //dirtyRegion is sorted in x order
-                if (task->rshape->strokeFirst()) {
-                    if (task->rshape->stroke && task->curBox.intersected(*p)) stroke(task, surface, RenderRegion::intersect(task->curBox, *p));
-                    if (task->shape.bbox.intersected(*p)) fill(task, surface, RenderRegion::intersect(task->shape.bbox, *p));
-                } else {
-                    if (task->shape.bbox.intersected(*p)) fill(task, surface, RenderRegion::intersect(task->shape.bbox, *p));
-                    if (task->rshape->stroke && task->curBox.intersected(*p)) stroke(task, surface, RenderRegion::intersect(task->curBox, *p));
-                }
+                if (bbox.intersected(*p)) draw(RenderRegion::intersect(bbox, *p));
             }
         }
     }
@@ -582,6 +645,12 @@ RenderRegion SwRenderer::region(RenderData data)
 }
 
 
+void SwRenderer::done(RenderData data)
+{
+    if (data) static_cast<SwTask*>(data)->done();
+}
+
+
 bool SwRenderer::beginComposite(RenderCompositor* cmp, MaskMethod method, uint8_t opacity)
 {
     if (!cmp) return false;
@@ -692,13 +761,35 @@ bool SwRenderer::endComposite(RenderCompositor* cmp)
 
     //Default is alpha blending
     if (p->method == MaskMethod::None) {
-        return rasterDirectImage(surface, p->image, p->bbox, p->opacity);
+        _rasterBands(surface, p->bbox, [&](const RenderRegion& band) {
+            rasterDirectImage(surface, p->image, band, p->opacity);
+        });
     }
 
     return true;
 }
 
 
+bool SwRenderer::capture(RenderCompositor* cmp, RenderSurface* surface, RenderRegion& region)
+{
+    if (!cmp) return false;
+
+    auto p = static_cast<SwCompositor*>(cmp);
+    if (p->image.channelSize != sizeof(uint32_t)) return false;
+
+    surface->data = p->image.data;
+    surface->stride = p->image.stride;
+    surface->w = p->image.w;
+    surface->h = p->image.h;
+    surface->cs = colorSpace();
+    surface->channelSize = p->image.channelSize;
+    surface->premultiplied = true;
+    region = p->bbox;
+
+    return true;
+}
+
+
 void SwRenderer::prepare(RenderEffect* effect, const Matrix& transform)
 {
     switch (effect->type) {
@@ -811,7 +902,10 @@ void* SwRenderer::prepareCommon(SwTask* task, const Matrix& transform, const Arr
         }
     }
 
-    if (flags) TaskScheduler::request(task);
+    if (flags) {
+        mpoolRetain(mpool);
+        TaskScheduler::request(task, &group);
+    }
 
     return task;
 }
@@ -837,6 +931,7 @@ RenderData SwRenderer::prepare(const RenderShape& rshape, RenderData data, const
     else {
         task = new SwShapeTask;
         task->rshape = &rshape;
+        task->glyphs = glyphs;
     }
 
     task->clipper = clipper;
@@ -845,6 +940,14 @@ RenderData SwRenderer::prepare(const RenderShape& rshape, RenderData data, const
 }
 
 
+bool SwRenderer::init()
+{
+    //select the pixel kernels for this cpu
+    kernelInit();
+    return true;
+}
+
+
 bool SwRenderer::term()
 {
     if (rendererCnt > 0) return false;
@@ -857,7 +960,7 @@ bool SwRenderer::term()
 }
 
 
-SwRenderer* SwRenderer::gen(uint32_t threads)
+SwRenderer* SwRenderer::gen(uint32_t threads, EngineOption op)
 {
     //initialize engine
     if (rendererCnt == -1) {
@@ -870,5 +973,12 @@ SwRenderer* SwRenderer::gen(uint32_t threads)
         rendererCnt = 0;
     }
 
-    return new SwRenderer;
+    auto renderer = new SwRenderer;
+    if ((op & EngineOption::ParallelRaster) != EngineOption::None) {
+        renderer->bands = std::min(threads + 1, uint32_t(SW_MAX_BANDS));
+    }
+    if ((op & EngineOption::GlyphCache) != EngineOption::None) {
+        renderer->glyphs = glyphCacheInit(threadsCnt);
+    }
+    return renderer;
 }
@@ -24,11 +24,13 @@
 #define _TVG_SW_RENDERER_H_
 
 #include "tvgRender.h"
+#include "tvgTaskScheduler.h"
 
 struct SwSurface;
 struct SwTask;
 struct SwCompositor;
 struct SwMpool;
+struct SwGlyphCache;
 
 namespace tvg
 {
@@ -47,6 +49,7 @@ public:
     bool postRender() override;
     void dispose(RenderData data) override;
     RenderRegion region(RenderData data) override;
+    void done(RenderData data) override;
     bool blend(BlendMethod method) override;
     ColorSpace colorSpace() override;
     const RenderSurface* mainSurface() override;
@@ -59,6 +62,7 @@ public:
     RenderCompositor* target(const RenderRegion& region, ColorSpace cs, CompositionFlag flags) override;
     bool beginComposite(RenderCompositor* cmp, MaskMethod method, uint8_t opacity) override;
     bool endComposite(RenderCompositor* cmp) override;
+    bool capture(RenderCompositor* cmp, RenderSurface* surface, RenderRegion& region) override;
     void clearCompositors();
 
     //post effects
@@ -71,17 +75,21 @@ public:
     void damage(RenderData rd, const RenderRegion& region) override;
     bool partial(bool disable) override;
 
-    static SwRenderer* gen(uint32_t threads);
+    static SwRenderer* gen(uint32_t threads, EngineOption op = EngineOption::Default);
+    static bool init();
     static bool term();
 
 private:
     SwSurface*           surface = nullptr;           //active surface
     Array<SwTask*>       tasks;                       //async task list
+    TaskGroup            group;                       //the requested tasks to be synced
     Array<SwSurface*>    compositors;                 //render targets cache list
     RenderDirtyRegion    dirtyRegion;                 //partial rendering support
     SwMpool*             mpool;                       //private memory pool
+    SwGlyphCache*        glyphs = nullptr;            //glyph images of the text, if enabled
     bool                 sharedMpool;                 //memory-pool behavior policy
     bool                 fulldraw = true;             //buffer is cleared (need to redraw full screen)
+    uint8_t              bands = 1;                   //max raster bands of the target surface
 
     SwRenderer();
     ~SwRenderer();
@@ -248,20 +248,20 @@ static void _dashMoveTo(SwDashStroke& dash, uint32_t offIdx, float offset, const
 
 static SwOutline* _genDashOutline(const RenderShape* rshape, const Matrix& transform, SwMpool* mpool, unsigned tid, bool trimmed)
 {
-    PathCommand *cmds, *trimmedCmds = nullptr;
-    Point *pts, *trimmedPts = nullptr;
+    PathCommand* cmds;
+    Point* pts;
     uint32_t cmdCnt, ptsCnt;
 
     if (trimmed) {
-        RenderPath trimmedPath;
-        if (!rshape->stroke->trim.trim(rshape->path, trimmedPath)) return nullptr;
-        cmds = trimmedCmds = trimmedPath.cmds.data;
-        cmdCnt = trimmedPath.cmds.count;
-        pts = trimmedPts = trimmedPath.pts.data;
-        ptsCnt = trimmedPath.pts.count;
-
-        trimmedPath.cmds.data = nullptr;
-        trimmedPath.pts.data = nullptr;
+        auto trimmedPath = mpoolReqPath(mpool, tid);
+        if (!rshape->stroke->trim.trim(rshape->path, *trimmedPath)) {
+            mpoolRetPath(mpool, tid);
+            return nullptr;
+        }
+        cmds = trimmedPath->cmds.data;
+        cmdCnt = trimmedPath->cmds.count;
+        pts = trimmedPath->pts.data;
+        ptsCnt = trimmedPath->pts.count;
     } else {
         cmds = rshape->path.cmds.data;
         cmdCnt = rshape->path.cmds.count;
@@ -270,7 +270,10 @@ static SwOutline* _genDashOutline(const RenderShape* rshape, const Matrix& trans
     }
 
     //No actual shape data
-    if (cmdCnt == 0 || ptsCnt == 0) return nullptr;
+    if (cmdCnt == 0 || ptsCnt == 0) {
+        if (trimmed) mpoolRetPath(mpool, tid);
+        return nullptr;
+    }
 
     SwDashStroke dash;
     dash.pattern = rshape->stroke->dash.pattern;
@@ -330,8 +333,7 @@ static SwOutline* _genDashOutline(const RenderShape* rshape, const Matrix& trans
         ++cmds;
     }
 
-    tvg::free(trimmedCmds);
-    tvg::free(trimmedPts);
+    if (trimmed) mpoolRetPath(mpool, tid);
 
     _outlineEnd(*dash.outline);
 
@@ -361,21 +363,20 @@ static bool _axisAlignedRect(const SwOutline* outline)
 
 static SwOutline* _genOutline(SwShape* shape, const RenderShape* rshape, const Matrix& transform, SwMpool* mpool, unsigned tid, bool hasComposite, bool trimmed = false)
 {
-    PathCommand *cmds, *trimmedCmds = nullptr;
-    Point *pts, *trimmedPts = nullptr;
+    PathCommand* cmds;
+    Point* pts;
     uint32_t cmdCnt, ptsCnt;
 
     if (trimmed) {
-        RenderPath trimmedPath;
-        if (!rshape->stroke->trim.trim(rshape->path, trimmedPath)) return nullptr;
-
-        cmds = trimmedCmds = trimmedPath.cmds.data;
-        cmdCnt = trimmedPath.cmds.count;
-        pts = trimmedPts = trimmedPath.pts.data;
-        ptsCnt = trimmedPath.pts.count;
-
-        trimmedPath.cmds.data = nullptr;
-        trimmedPath.pts.data = nullptr;
+        auto trimmedPath = mpoolReqPath(mpool, tid);
+        if (!rshape->stroke->trim.trim(rshape->path, *trimmedPath)) {
+            mpoolRetPath(mpool, tid);
+            return nullptr;
+        }
+        cmds = trimmedPath->cmds.data;
+        cmdCnt = trimmedPath->cmds.count;
+        pts = trimmedPath->pts.data;
+        ptsCnt = trimmedPath->pts.count;
     } else {
         cmds = rshape->path.cmds.data;
         cmdCnt = rshape->path.cmds.count;
@@ -384,32 +385,50 @@ static SwOutline* _genOutline(SwShape* shape, const RenderShape* rshape, const M
     }
 
     //No actual shape data
-    if (cmdCnt == 0 || ptsCnt == 0) return nullptr;
+    if (cmdCnt == 0 || ptsCnt == 0) {
+        if (trimmed) mpoolRetPath(mpool, tid);
+        return nullptr;
+    }
 
     auto outline = mpoolReqOutline(mpool, tid);
+    shapeGenOutline(*outline, cmds, cmdCnt, pts, transform);
+    outline->fillRule = rshape->rule;
+
+    if (trimmed) mpoolRetPath(mpool, tid);
+
+    shape->fastTrack = (!hasComposite && _axisAlignedRect(outline));
+    return outline;
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+void shapeGenOutline(SwOutline& outline, const PathCommand* cmds, uint32_t cmdCnt, const Point* pts, const Matrix& transform)
+{
     auto closed = false;
 
-    //Generate Outlines
     while (cmdCnt-- > 0) {
         switch (*cmds) {
             case PathCommand::Close: {
-                if (!closed) closed = _outlineClose(*outline);
+                if (!closed) closed = _outlineClose(outline);
                 break;
             }
             case PathCommand::MoveTo: {
-                closed = _outlineMoveTo(*outline, pts, transform, closed);
+                closed = _outlineMoveTo(outline, pts, transform, closed);
                 ++pts;
                 break;
             }
             case PathCommand::LineTo: {
-                if (closed) closed = _outlineBegin(*outline);
-                _outlineLineTo(*outline, pts, transform);
+                if (closed) closed = _outlineBegin(outline);
+                _outlineLineTo(outline, pts, transform);
                 ++pts;
                 break;
             }
             case PathCommand::CubicTo: {
-                if (closed) closed = _outlineBegin(*outline);
-                _outlineCubicTo(*outline, pts, pts + 1, pts + 2, transform);
+                if (closed) closed = _outlineBegin(outline);
+                _outlineCubicTo(outline, pts, pts + 1, pts + 2, transform);
                 pts += 3;
                 break;
             }
@@ -417,22 +436,10 @@ static SwOutline* _genOutline(SwShape* shape, const RenderShape* rshape, const M
         ++cmds;
     }
 
-    if (!closed) _outlineEnd(*outline);
-
-    outline->fillRule = rshape->rule;
-
-    tvg::free(trimmedCmds);
-    tvg::free(trimmedPts);
-
-    shape->fastTrack = (!hasComposite && _axisAlignedRect(outline));
-    return outline;
+    if (!closed) _outlineEnd(outline);
 }
 
 
-/************************************************************************/
-/* External Class Implementation                                        */
-/************************************************************************/
-
 bool shapePrepare(SwShape* shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool hasComposite)
 {
     if (auto out = _genOutline(shape, rshape, transform, mpool, tid, hasComposite, rshape->trimpath())) shape->outline = out;
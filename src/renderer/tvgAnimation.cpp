@@ -21,8 +21,138 @@
  */
 
 #include "tvgFrameModule.h"
+#include "tvgTaskScheduler.h"
 #include "tvgAnimation.h"
 
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+//renders a part of the frames with a replica of the animation on its own canvas
+struct AnimationLane : Task
+{
+    Animation* animation = nullptr;
+    Paint* bg = nullptr;             //a copy of the background for this lane
+    const float* frames;
+    uint32_t** buffers;
+    uint32_t begin, end, step;       //the frame indices of this lane
+    uint32_t stride, w, h;
+    ColorSpace cs;
+    Result result = Result::Success;  //the first failure of this lane, its frames are left unrendered
+
+    ~AnimationLane()
+    {
+        if (bg) bg->unref();
+        delete(animation);
+    }
+
+    void run(TVG_UNUSED unsigned tid) override
+    {
+        //the canvas must be created by the rendering thread to have the proper memory pool
+        auto canvas = SwCanvas::gen();
+        if (!canvas) {
+            result = Result::FailedAllocation;
+            return;
+        }
+        if (bg) canvas->push(bg);
+        canvas->push(animation->picture());
+
+        for (auto i = begin; i < end; i += step) {
+            animation->frame(frames[i]);
+            if ((result = canvas->target(buffers[i], stride, w, h, cs)) != Result::Success) break;
+            canvas->update();
+            if ((result = canvas->draw(true)) != Result::Success) break;
+            if ((result = canvas->sync()) != Result::Success) break;
+        }
+        delete(canvas);
+    }
+};
+
+
+static Animation* _replicate(Picture* origin)
+{
+    auto picture = PICTURE(origin);
+    auto loader = static_cast<FrameModule*>(picture->loader)->replicate();
+    if (!loader) return nullptr;
+
+    auto animation = Animation::gen();
+    auto dup = PICTURE(animation->picture());
+    if (dup->load(loader) != Result::Success) {
+        delete(animation);
+        return nullptr;
+    }
+    dup->size(picture->w, picture->h);
+    dup->transform(picture->transform());
+    dup->opacity(picture->opacity());
+
+    return animation;
+}
+
+
+Result Animation::Impl::render(const float* frames, uint32_t** buffers, uint32_t cnt, uint32_t stride, uint32_t w, uint32_t h, ColorSpace cs, const Paint* bg)
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    if (!frames || !buffers || cnt == 0 || w == 0 || h == 0 || stride < w || cs == ColorSpace::Unknown) return Result::InvalidArguments;
+
+    auto picture = PICTURE(this->picture);
+    if (!picture->loader) return Result::InsufficientCondition;
+    if (!picture->loader->animatable()) return Result::NonSupport;
+
+    picture->load();
+
+    auto lanes = new AnimationLane[std::min(cnt, TaskScheduler::threads() + 1)];
+    uint32_t lanesCnt = 0;
+
+    for (; lanesCnt < std::min(cnt, TaskScheduler::threads() + 1); ++lanesCnt) {
+        auto animation = _replicate(this->picture);
+        if (!animation) break;
+        lanes[lanesCnt].animation = animation;
+    }
+
+    //not replicable, such as the animations modified by the slots or the expressions
+    if (lanesCnt == 0) {
+        delete[](lanes);
+        return Result::NonSupport;
+    }
+
+    //the lanes take the frames in turn, the current thread takes the first lane
+    TaskGroup group;
+    for (uint32_t i = 0; i < lanesCnt; ++i) {
+        auto& lane = lanes[i];
+        if (bg) {
+            lane.bg = bg->duplicate();
+            lane.bg->ref();
+        }
+        lane.frames = frames;
+        lane.buffers = buffers;
+        lane.begin = i;
+        lane.end = cnt;
+        lane.step = lanesCnt;
+        lane.stride = stride;
+        lane.w = w;
+        lane.h = h;
+        lane.cs = cs;
+        if (i > 0) TaskScheduler::request(&lane, &group);
+    }
+    lanes[0].run(0);
+    group.wait();
+
+    auto result = Result::Success;
+    for (uint32_t i = 0; i < lanesCnt && result == Result::Success; ++i) {
+        result = lanes[i].result;
+    }
+
+    delete[](lanes);
+
+    return result;
+#endif
+    return Result::NonSupport;
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
 
 Animation::~Animation()
 {
@@ -42,7 +172,23 @@ Result Animation::frame(float no) noexcept
     if (!loader) return Result::InsufficientCondition;
     if (!loader->animatable()) return Result::NonSupport;
 
-    if (static_cast<FrameModule*>(loader)->frame(no)) {
+    auto pending = false;
+
+    if (auto cache = PICTURE(pImpl->picture)->cache) {
+        auto key = FrameCache::quantize(no + static_cast<FrameModule*>(loader)->segmentBegin);
+        if (cache->pending && cache->keyed && cache->key == key) return Result::InsufficientCondition;
+        cache->request(no, key);
+        //defer building the frame, it could be replayed from the cache
+        if (cache->find(key, false)) {
+            cache->pending = true;
+            PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
+            return Result::Success;
+        }
+        pending = cache->pending;
+        cache->pending = false;
+    }
+
+    if (static_cast<FrameModule*>(loader)->frame(no) || pending) {
         PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
         return Result::Success;
     }
@@ -63,6 +209,9 @@ float Animation::curFrame() const noexcept
     if (!loader) return 0;
     if (!loader->animatable()) return 0;
 
+    auto cache = PICTURE(pImpl->picture)->cache;
+    if (cache && cache->pending) return cache->no;
+
     return static_cast<FrameModule*>(loader)->curFrame();
 }
 
@@ -112,6 +261,36 @@ Result Animation::segment(float *begin, float *end) noexcept
 }
 
 
+Result Animation::cache(uint32_t budget) noexcept
+{
+    auto picture = PICTURE(pImpl->picture);
+    if (!picture->loader) return Result::InsufficientCondition;
+    if (!picture->loader->animatable()) return Result::NonSupport;
+
+    if (picture->cache) {
+        if (budget > 0) {
+            picture->cache->resize(budget);
+            return Result::Success;
+        }
+        picture->uncache(true);
+        if (picture->impl.rd) picture->impl.renderer->dispose(picture->impl.rd);
+        picture->impl.rd = nullptr;
+        delete(picture->cache);
+        picture->cache = nullptr;
+        picture->impl.mark(RenderUpdateFlag::All);
+    } else if (budget > 0) {
+        picture->cache = new FrameCache(budget);
+    }
+    return Result::Success;
+}
+
+
+Result Animation::render(const float* frames, uint32_t** buffers, uint32_t cnt, uint32_t stride, uint32_t w, uint32_t h, ColorSpace cs) noexcept
+{
+    return pImpl->render(frames, buffers, cnt, stride, w, h, cs, nullptr);
+}
+
+
 Animation* Animation::gen() noexcept
 {
     return new Animation;
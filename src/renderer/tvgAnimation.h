@@ -40,6 +40,9 @@ struct Animation::Impl
     {
         picture->unref();
     }
+
+    //the background is drawn under each frame, see Animation::render()
+    Result render(const float* frames, uint32_t** buffers, uint32_t cnt, uint32_t stride, uint32_t w, uint32_t h, ColorSpace cs, const Paint* bg);
 };
 
 #endif //_TVG_ANIMATION_H_
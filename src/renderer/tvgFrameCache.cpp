@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgMath.h"
+#include "tvgFrameCache.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#define RUN_FLAG 0x80000000
+#define RUN_MIN 3   //shorter runs are stored as the literals
+
+
+/* The pixels are encoded in a sequence of tokens. A token header with RUN_FLAG
+   is followed by a pixel repeated by the count, otherwise the count of literal pixels follow. */
+static uint32_t _encode(const RenderSurface* surface, const RenderRegion& region, uint32_t* dst)
+{
+    auto w = region.w();
+    auto out = dst;
+    uint32_t* literal = nullptr;   //header of the current literal token
+
+    for (auto y = region.min.y; y < region.max.y; ++y) {
+        auto row = surface->buf32 + y * surface->stride + region.min.x;
+        uint32_t x = 0;
+        while (x < w) {
+            auto c = row[x];
+            uint32_t n = 1;
+            while (x + n < w && row[x + n] == c) ++n;
+            if (n >= RUN_MIN) {
+                *out++ = RUN_FLAG | n;
+                *out++ = c;
+                literal = nullptr;
+            } else {
+                if (!literal) {
+                    literal = out++;
+                    *literal = 0;
+                }
+                for (uint32_t i = 0; i < n; ++i) *out++ = c;
+                *literal += n;
+            }
+            x += n;
+        }
+    }
+    return static_cast<uint32_t>(out - dst) * sizeof(uint32_t);
+}
+
+
+static void _decode(const uint32_t* src, uint32_t size, uint32_t* dst)
+{
+    auto end = src + size / sizeof(uint32_t);
+
+    while (src < end) {
+        auto n = *src++;
+        if (n & RUN_FLAG) {
+            n &= ~RUN_FLAG;
+            auto c = *src++;
+            for (uint32_t i = 0; i < n; ++i) dst[i] = c;
+        } else {
+            memcpy(dst, src, n * sizeof(uint32_t));
+            src += n;
+        }
+        dst += n;
+    }
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+//The blending results depend on the render target, the composition can't replicate them.
+bool FrameCache::blending(const Paint* paint)
+{
+    if (PAINT(paint)->blendMethod != BlendMethod::Normal) return true;
+
+    auto it = PAINT(paint)->iterator();
+    if (!it) return false;
+
+    auto ret = false;
+    while (auto child = it->next()) {
+        if ((ret = blending(child))) break;
+    }
+    delete(it);
+    return ret;
+}
+
+
+FrameCache::~FrameCache()
+{
+    tvg::free(surface.buf32);
+    tvg::free(scratch);
+}
+
+
+void FrameCache::validate(RenderMethod* renderer, const Matrix& transform, uint8_t opacity, float w, float h)
+{
+    auto viewport = renderer->viewport();
+    auto cs = renderer->colorSpace();
+
+    if (context.renderer == renderer && context.transform == transform && context.viewport == viewport && context.cs == cs && context.opacity == opacity && tvg::equal(context.w, w) && tvg::equal(context.h, h)) return;
+
+    //the frames were rasterized in a different way, no more valid.
+    flush();
+
+    context.renderer = renderer;
+    context.transform = transform;
+    context.viewport = viewport;
+    context.cs = cs;
+    context.opacity = opacity;
+    context.w = w;
+    context.h = h;
+}
+
+
+FrameCache::Frame* FrameCache::find(int32_t key, bool touch)
+{
+    INLIST_FOREACH(frames, frame) {
+        if (frame->key != key) continue;
+        if (touch) {
+            frames.remove(frame);
+            frames.back(frame);
+        }
+        return frame;
+    }
+    return nullptr;
+}
+
+
+bool FrameCache::store(const RenderSurface* surface, const RenderRegion& region)
+{
+    if (!keyed || surface->channelSize != sizeof(uint32_t) || region.invalid()) return false;
+
+    //the worst case: every run is led by a literal pixel
+    auto cnt = region.w() * region.h();
+    auto size = (cnt + cnt / RUN_MIN + 1) * sizeof(uint32_t);
+    if (scratchSize < size) {
+        scratch = tvg::realloc<uint32_t*>(scratch, size);
+        scratchSize = size;
+    }
+
+    size = _encode(surface, region, scratch);
+    if (size > budget) return false;
+
+    //evict the least recently used ones
+    while (used + size > budget) {
+        auto frame = frames.head;
+        frames.remove(frame);
+        used -= frame->size;
+        delete(frame);
+    }
+
+    auto frame = new Frame;
+    frame->data = tvg::malloc<uint32_t*>(size);
+    memcpy(frame->data, scratch, size);
+    frame->size = size;
+    frame->region = region;
+    frame->key = key;
+    frames.back(frame);
+    used += size;
+
+    return true;
+}
+
+
+RenderSurface* FrameCache::decode(Frame* frame)
+{
+    auto w = frame->region.w();
+    auto h = frame->region.h();
+
+    if (surface.w * surface.h < w * h) surface.buf32 = tvg::realloc<uint32_t*>(surface.buf32, w * h * sizeof(uint32_t));
+
+    surface.w = surface.stride = w;
+    surface.h = h;
+    surface.cs = context.cs;
+    surface.channelSize = sizeof(uint32_t);
+    surface.premultiplied = true;
+
+    _decode(frame->data, frame->size, surface.buf32);
+
+    return &surface;
+}
+
+
+void FrameCache::resize(uint32_t budget)
+{
+    this->budget = budget;
+
+    while (used > budget) {
+        auto frame = frames.head;
+        frames.remove(frame);
+        used -= frame->size;
+        delete(frame);
+    }
+}
+
+
+void FrameCache::flush()
+{
+    frames.free();
+    used = 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_FRAME_CACHE_H_
+#define _TVG_FRAME_CACHE_H_
+
+#include "tvgCommon.h"
+#include "tvgInlist.h"
+#include "tvgRender.h"
+#include "tvgPaint.h"
+
+//Retains the rasterized animation frames in a run-length encoded form.
+struct FrameCache
+{
+    struct Frame
+    {
+        INLIST_ITEM(Frame);
+        uint32_t* data;         //encoded pixels
+        uint32_t size;          //encoded size in bytes
+        RenderRegion region;    //rasterized region on the target
+        int32_t key;
+
+        ~Frame()
+        {
+            tvg::free(data);
+        }
+    };
+
+    Inlist<Frame> frames;       //the least recently used one comes first
+    RenderSurface surface;      //decoded frame
+    uint32_t* scratch = nullptr;
+    uint32_t scratchSize = 0;
+    uint32_t budget;            //allowed memory in bytes
+    uint32_t used = 0;          //encoded memory in bytes
+
+    //render context which the frames were rasterized with
+    struct {
+        RenderMethod* renderer = nullptr;
+        Matrix transform;
+        RenderRegion viewport;
+        ColorSpace cs;
+        float w, h;
+        uint8_t opacity;
+    } context;
+
+    //requested frame
+    float no = 0.0f;
+    int32_t key = 0;
+    bool keyed = false;         //the requested frame is cacheable
+    bool pending = false;       //the requested frame is not built yet, it will be replayed from the cache
+    bool replaying = false;     //the current frame is drawn from the cache
+    bool capturing = false;     //the current frame is going to be stored to the cache
+
+    FrameCache(uint32_t budget) : budget(budget) {}
+    ~FrameCache();
+
+    static int32_t quantize(float no)
+    {
+        return static_cast<int32_t>(nearbyintf(no * 1000.0f));
+    }
+
+    void request(float no, int32_t key)
+    {
+        this->no = no;
+        this->key = key;
+        keyed = true;
+    }
+
+    static bool blending(const Paint* paint);
+
+    void validate(RenderMethod* renderer, const Matrix& transform, uint8_t opacity, float w, float h);
+    Frame* find(int32_t key, bool touch = true);
+    bool store(const RenderSurface* surface, const RenderRegion& region);
+    RenderSurface* decode(Frame* frame);
+    void resize(uint32_t budget);
+    void flush();
+};
+
+#endif //_TVG_FRAME_CACHE_H_
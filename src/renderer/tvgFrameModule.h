@@ -42,6 +42,7 @@ public:
     virtual float curFrame() = 0;           //return the current frame number
     virtual float duration() = 0;           //return the animation duration in seconds
     virtual Result segment(float begin, float end) = 0;
+    virtual FrameModule* replicate() { return nullptr; }  //an independent instance playing the same source, if possible
 
     void segment(float* begin, float* end)
     {
@@ -88,6 +88,10 @@ Result Initializer::init(uint32_t threads) noexcept
 
     if (!LoaderMgr::init()) return Result::Unknown;
 
+    #ifdef THORVG_SW_RASTER_SUPPORT
+        if (!SwRenderer::init()) return Result::Unknown;
+    #endif
+
     TaskScheduler::init(threads);
 
     return Result::Success;
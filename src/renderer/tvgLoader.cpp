@@ -166,7 +166,7 @@ static LoadModule* _findByPath(const char* filename)
     if (!ext) return nullptr;
 
     if (!strcmp(ext, "svg")) return _find(FileType::Svg);
-    if (!strcmp(ext, "lot") || !strcmp(ext, "json")) return _find(FileType::Lot);
+    if (!strcmp(ext, "lot") || !strcmp(ext, "lotb") || !strcmp(ext, "json")) return _find(FileType::Lot);
     if (!strcmp(ext, "png")) return _find(FileType::Png);
     if (!strcmp(ext, "jpg")) return _find(FileType::Jpg);
     if (!strcmp(ext, "webp")) return _find(FileType::Webp);
@@ -277,10 +277,10 @@ LoadModule* LoaderMgr::loader(const char* filename, bool* invalid)
 #ifdef THORVG_FILE_IO_SUPPORT
     *invalid = false;
 
-    //TODO: svg & lottie is not sharable.
+    //TODO: svg is not sharable. lottie shares the parsed composition by itself.
     auto allowCache = true;
     auto ext = fileext(filename);
-    if (ext && (!strcmp(ext, "svg") || !strcmp(ext, "json") || !strcmp(ext, "lot"))) allowCache = false;
+    if (ext && (!strcmp(ext, "svg") || !strcmp(ext, "json") || !strcmp(ext, "lot") || !strcmp(ext, "lotb"))) allowCache = false;
 
     if (allowCache) {
         if (auto loader = _findFromCache(filename)) return loader;
@@ -333,7 +333,7 @@ LoadModule* LoaderMgr::loader(const char* data, uint32_t size, const char* mimeT
     //Thus caching is only valid for shareable.
     auto allowCache = !copy;
 
-    //TODO: lottie is not sharable.
+    //lottie shares the parsed composition by itself. see LottieLoader
     if (allowCache) {
         auto type = _convert(mimeType);
         if (type == FileType::Lot) allowCache = false;
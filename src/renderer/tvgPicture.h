@@ -25,6 +25,8 @@
 
 #include "tvgPaint.h"
 #include "tvgLoader.h"
+#include "tvgFrameModule.h"
+#include "tvgFrameCache.h"
 
 #define PICTURE(A) static_cast<PictureImpl*>(A)
 #define CONST_PICTURE(A) static_cast<const PictureImpl*>(A)
@@ -62,6 +64,7 @@ struct PictureImpl : Picture
     ImageLoader* loader = nullptr;
     Paint* vector = nullptr;          //vector picture uses
     RenderSurface* bitmap = nullptr;  //bitmap picture uses
+    FrameCache* cache = nullptr;      //rasterized frames of the animation, see Animation::cache()
     float w = 0, h = 0;
     bool resizing = false;
 
@@ -73,6 +76,12 @@ struct PictureImpl : Picture
     {
         LoaderMgr::retrieve(loader);
         delete(vector);
+        if (cache) {
+            //the replaying render data refers to the cache
+            if (impl.rd) impl.renderer->dispose(impl.rd);
+            impl.rd = nullptr;
+            delete(cache);
+        }
     }
 
     bool skip(RenderUpdateFlag flag)
@@ -97,12 +106,64 @@ struct PictureImpl : Picture
                 loader->resize(vector, w, h);
                 resizing = false;
             }
+            if (cache && replay(renderer, transform, clips, opacity)) return true;
             needComposition(opacity);
-            return vector->pImpl->update(renderer, transform, clips, opacity, flag, false);
+            auto ret = vector->pImpl->update(renderer, transform, clips, opacity, flag, false);
+            //the whole frame must be rasterized for capturing
+            if (cache && cache->capturing) renderer->damage(nullptr, vector->pImpl->bounds(renderer));
+            return ret;
         }
         return true;
     }
 
+    //draw the requested frame from the cache if possible, otherwise build it up.
+    bool replay(RenderMethod* renderer, const Matrix& transform, Array<RenderData>& clips, uint8_t opacity)
+    {
+        cache->replaying = cache->capturing = false;
+
+        //the frames are not reusable with the clippings
+        auto cacheable = cache->keyed && clips.empty();
+        if (cacheable) cache->validate(renderer, transform, opacity, w, h);
+
+        if (cache->pending) {
+            if (cacheable) {
+                if (auto frame = cache->find(cache->key)) {
+                    auto m = Matrix{1, 0, float(frame->region.min.x), 0, 1, float(frame->region.min.y), 0, 0, 1};
+                    impl.rd = renderer->prepare(cache->decode(frame), impl.rd, m, clips, 255, RenderUpdateFlag::All);
+                    renderer->damage(impl.rd, frame->region);
+                    impl.cmpFlag = CompositionFlag::Invalid;
+                    cache->replaying = true;
+                    return true;
+                }
+            }
+            //the cached frame is not available, build the frame in place
+            cache->pending = false;
+            static_cast<FrameModule*>(loader)->frame(cache->no);
+            loader->sync();
+        }
+
+        cache->capturing = cacheable && cache->budget > 0 && !cache->find(cache->key, false);
+
+        if (cache->capturing && FrameCache::blending(vector)) {
+            TVGLOG("RENDERER", "Frame caching is not applicable to the blending contents.");
+            cache->resize(0);
+            cache->capturing = false;
+        }
+        return false;
+    }
+
+    //discard the requested frame from the cache, the contents will be changed
+    void uncache(bool flush)
+    {
+        if (!cache) return;
+        if (cache->pending) {
+            static_cast<FrameModule*>(loader)->frame(cache->no);
+            cache->pending = false;
+        }
+        cache->keyed = false;
+        if (flush) cache->flush();
+    }
+
     void size(float w, float h)
     {
         this->w = w;
@@ -250,21 +311,35 @@ struct PictureImpl : Picture
         auto ret = true;
         renderer->blend(impl.blendMethod);
 
-        if (bitmap) return renderer->renderImage(impl.rd);
+        if (bitmap || (cache && cache->replaying)) return renderer->renderImage(impl.rd);
         else if (vector) {
             RenderCompositor* cmp = nullptr;
-            if (impl.cmpFlag) {
-                cmp = renderer->target(bounds(renderer), renderer->colorSpace(), impl.cmpFlag);
+            auto capturing = cache && cache->capturing;
+            if (impl.cmpFlag || capturing) {
+                auto region = bounds(renderer);
+                //the anti-aliased edges may refer to the neighbor pixels, keep them clean
+                if (capturing) region = {{region.min.x - 1, region.min.y - 1}, {region.max.x + 1, region.max.y + 1}};
+                cmp = renderer->target(region, renderer->colorSpace(), impl.cmpFlag);
                 renderer->beginComposite(cmp, MaskMethod::None, 255);
             }
             ret = vector->pImpl->render(renderer);
-            if (cmp) renderer->endComposite(cmp);
+            if (cmp) {
+                if (capturing) {
+                    RenderSurface surface;
+                    RenderRegion region;
+                    if (renderer->capture(cmp, &surface, region)) cache->store(&surface, region);
+                    else cache->resize(0);  //not supported by the engine
+                    cache->capturing = false;
+                }
+                renderer->endComposite(cmp);
+            }
         }
         return ret;
     }
 
     RenderRegion bounds(RenderMethod* renderer)
     {
+        if (cache && cache->replaying) return renderer->region(impl.rd);
         if (vector) return vector->pImpl->bounds(renderer);
         return renderer->region(impl.rd);
     }
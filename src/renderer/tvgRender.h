@@ -301,18 +301,35 @@ struct RenderStroke
     }
 };
 
+//The glyph layout of a text path. The raster engine may cache the glyph images with it.
+struct RenderText
+{
+    struct Glyph
+    {
+        Point origin;          //the glyph position in the path space
+        uint32_t id;           //the glyph index in the font
+        uint32_t cmdCnt;       //the number of the path commands of the glyph outline
+        uint32_t ptsCnt;       //the number of the path points of the glyph outline
+    };
+
+    Array<Glyph> glyphs;
+    uint32_t font = 0;         //unique font id
+};
+
 struct RenderShape
 {
     RenderPath path;
     Fill *fill = nullptr;
     RenderColor color{};
     RenderStroke *stroke = nullptr;
+    RenderText *text = nullptr;
     FillRule rule = FillRule::NonZero;
 
     ~RenderShape()
     {
         delete(fill);
         delete(stroke);
+        delete(text);
     }
 
     void fillColor(uint8_t* r, uint8_t* g, uint8_t* b, uint8_t* a) const
@@ -528,6 +545,7 @@ public:
     virtual bool postRender() = 0;
     virtual void dispose(RenderData data) = 0;
     virtual RenderRegion region(RenderData data) = 0;
+    virtual void done(TVG_UNUSED RenderData data) {}   //waits for the in-flight preparation of the data, if any
     virtual bool blend(BlendMethod method) = 0;
     virtual ColorSpace colorSpace() = 0;
     virtual const RenderSurface* mainSurface() = 0;
@@ -538,6 +556,8 @@ public:
     virtual RenderCompositor* target(const RenderRegion& region, ColorSpace cs, CompositionFlag flags) = 0;
     virtual bool beginComposite(RenderCompositor* cmp, MaskMethod method, uint8_t opacity) = 0;
     virtual bool endComposite(RenderCompositor* cmp) = 0;
+    //reads back the composition target, the engines without the support draw the frames live
+    virtual bool capture(TVG_UNUSED RenderCompositor* cmp, TVG_UNUSED RenderSurface* surface, TVG_UNUSED RenderRegion& region) { return false; }
 
     //post effects
     virtual void prepare(RenderEffect* effect, const Matrix& transform) = 0;
@@ -28,6 +28,9 @@
 #ifdef THORVG_GIF_SAVER_SUPPORT
     #include "tvgGifSaver.h"
 #endif
+#ifdef THORVG_PNG_SAVER_SUPPORT
+    #include "tvgPngSaver.h"
+#endif
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
@@ -52,6 +55,12 @@ static SaveModule* _find(FileType type)
         case FileType::Gif: {
 #ifdef THORVG_GIF_SAVER_SUPPORT
             return new GifSaver;
+#endif
+            break;
+        }
+        case FileType::Png: {
+#ifdef THORVG_PNG_SAVER_SUPPORT
+            return new PngSaver;
 #endif
             break;
         }
@@ -67,6 +76,10 @@ static SaveModule* _find(FileType type)
             format = "GIF";
             break;
         }
+        case FileType::Png: {
+            format = "PNG";
+            break;
+        }
         default: {
             format = "???";
             break;
@@ -82,6 +95,7 @@ static SaveModule* _find(const char* filename)
 {
     auto ext = fileext(filename);
     if (ext && !strcmp(ext, "gif")) return _find(FileType::Gif);
+    if (ext && !strcmp(ext, "png")) return _find(FileType::Png);
     return nullptr;
 }
 
@@ -63,6 +63,7 @@ struct SceneImpl : Scene
 {
     Paint::Impl impl;
     list<Paint*> paints;     //children list
+    list<Paint*> recycled;   //retained children to be reclaimed, see recycle()
     RenderRegion vport = {};
     Array<RenderEffect*>* effects = nullptr;
     Point fsize;          //fixed scene size
@@ -299,6 +300,37 @@ struct SceneImpl : Scene
         return Result::Success;
     }
 
+    /* Retained-mode rebuild: detach the children, but keep the ones still owned by others
+       so that pushing them back in the same order reclaims them without relocation.
+       The leftovers are settled with commit() */
+    void recycle()
+    {
+        auto recover = (fixed && impl.renderer) ? impl.renderer->partial(true) : false;
+
+        for (auto paint : paints) {
+            if (PAINT(paint)->unref() > 0) recycled.push_back(paint);
+        }
+        paints.clear();
+
+        if (fixed && impl.renderer) impl.renderer->partial(recover);
+    }
+
+    void commit()
+    {
+        if (recycled.empty()) return;
+
+        auto recover = (fixed && impl.renderer) ? impl.renderer->partial(true) : false;
+        auto partialDmg = !(effects || fixed || recover);
+
+        //redraw the regions of the unclaimed ones
+        if (partialDmg) {
+            for (auto paint : recycled) PAINT(paint)->damage();
+        }
+        recycled.clear();
+
+        if (fixed && impl.renderer) impl.renderer->partial(recover);
+    }
+
     Result remove(Paint* paint)
     {
         if (PAINT(paint)->parent != this) return Result::InsufficientCondition;
@@ -317,8 +349,10 @@ struct SceneImpl : Scene
 
         target->ref();
 
+        //Reclaimed in order, it's still in the current scene space
+        if (!at && !recycled.empty() && recycled.front() == target && timpl->refCnt > 1) recycled.pop_front();
         //Relocated the paint to the current scene space
-        timpl->mark(RenderUpdateFlag::Transform);
+        else timpl->mark(RenderUpdateFlag::Transform);
 
         if (!at) {
             paints.push_back(target);
@@ -343,7 +377,7 @@ struct SceneImpl : Scene
     {
         if (effects) {
             ARRAY_FOREACH(p, *effects) {
-                impl.renderer->dispose(*p);
+                if (impl.renderer) impl.renderer->dispose(*p);
                 delete(*p);
             }
             delete(effects);
@@ -355,6 +355,7 @@ struct ShapeImpl : Shape
     {
         rs.path.cmds.clear();
         rs.path.pts.clear();
+        if (rs.text) rs.text->glyphs.clear();
         impl.mark(RenderUpdateFlag::Path);
     }
 
@@ -524,6 +525,9 @@ struct ShapeImpl : Shape
         delete(rs.stroke);
         rs.stroke = nullptr;
 
+        delete(rs.text);
+        rs.text = nullptr;
+
         delete(rs.fill);
         rs.fill = nullptr;
     }
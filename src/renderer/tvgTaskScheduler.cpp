@@ -25,6 +25,11 @@
 #include "tvgInlist.h"
 #include "tvgTaskScheduler.h"
 
+#ifdef THORVG_THREAD_SUPPORT
+    #include <mutex>
+    #include <condition_variable>
+#endif
+
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
@@ -33,61 +38,163 @@ namespace tvg {
 
 #ifdef THORVG_THREAD_SUPPORT
 
-struct TaskQueue {
-    Inlist<Task>             taskDeque;
+static constexpr auto SPIN_COUNT = 64;   //experimental decision, busy waiting before parking the thread
+
+//A waiting room for the threads which are blocked on the task completion
+struct Parking
+{
     mutex                    mtx;
-    condition_variable       ready;
-    bool                     done = false;
+    condition_variable       cv;
+    atomic<uint32_t>         waiters{0};
 
-    bool tryPop(Task** task)
+    void wait(atomic<uint32_t>& remains)
     {
-        unique_lock<mutex> lock{mtx, try_to_lock};
-        if (!lock || taskDeque.empty()) return false;
-        *task = taskDeque.front();
-        return true;
+        unique_lock<mutex> lock{mtx};
+        ++waiters;
+        while (remains.load() > 0) cv.wait(lock);
+        --waiters;
     }
 
-    bool tryPush(Task* task)
+    void wake()
     {
-        {
-            unique_lock<mutex> lock{mtx, try_to_lock};
-            if (!lock) return false;
-            taskDeque.back(task);
-        }
-        ready.notify_one();
+        if (waiters.load() == 0) return;
+        lock_guard<mutex> lock{mtx};
+        cv.notify_all();
+    }
+};
+
+
+/* The waiting rooms are shared by the hashed addresses of the counters,
+   a completion wakes up the waiters of its counter only, not all of the blocked threads. */
+static constexpr auto PARKING_SLOTS = 32;   //must be a power of 2
+static Parking _parkings[PARKING_SLOTS];
+
+static Parking& _parking(const atomic<uint32_t>& remains)
+{
+    auto addr = reinterpret_cast<uintptr_t>(&remains);
+    return _parkings[((addr ^ (addr >> 9)) >> 3) & (PARKING_SLOTS - 1)];
+}
+
+
+/* Chase-Lev work-stealing deque with a fixed capacity.
+   Only the owner thread pushes/pops at the bottom, the others steal from the top.
+   See: "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013 */
+struct TaskDeque
+{
+    static constexpr int64_t CAPACITY = 1024;   //must be a power of 2
+
+    atomic<int64_t>          top{0};
+    atomic<int64_t>          bottom{0};
+    atomic<Task*>            tasks[CAPACITY];
+
+    bool push(Task* task)
+    {
+        auto b = bottom.load(memory_order_relaxed);
+        auto t = top.load(memory_order_acquire);
+        if (b - t >= CAPACITY) return false;
+        tasks[b & (CAPACITY - 1)].store(task, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        bottom.store(b + 1, memory_order_relaxed);
         return true;
     }
 
-    void complete()
+    Task* pop()
     {
-        {
-            lock_guard<mutex> lock{mtx};
-            done = true;
+        auto b = bottom.load(memory_order_relaxed) - 1;
+        bottom.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        auto t = top.load(memory_order_relaxed);
+
+        //empty
+        if (t > b) {
+            bottom.store(b + 1, memory_order_relaxed);
+            return nullptr;
         }
-        ready.notify_all();
+
+        auto task = tasks[b & (CAPACITY - 1)].load(memory_order_relaxed);
+
+        //the last one, race against the thieves
+        if (t == b) {
+            if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) task = nullptr;
+            bottom.store(b + 1, memory_order_relaxed);
+        }
+        return task;
     }
 
-    bool pop(Task** task)
+    Task* steal()
     {
-        unique_lock<mutex> lock{mtx};
+        auto t = top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        auto b = bottom.load(memory_order_acquire);
+        if (t >= b) return nullptr;
+
+        auto task = tasks[t & (CAPACITY - 1)].load(memory_order_relaxed);
+        if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) return nullptr;
+        return task;
+    }
+};
 
-        while (taskDeque.empty() && !done) {
-            ready.wait(lock);
-        }
 
-        if (taskDeque.empty()) return false;
+/* Bounded lock-free MPMC queue for the tasks requested by the non-worker threads.
+   See: Dmitry Vyukov's bounded MPMC queue */
+struct TaskQueue
+{
+    static constexpr size_t CAPACITY = 4096;   //must be a power of 2
 
-        *task = taskDeque.front();
-        return true;
+    struct Cell
+    {
+        atomic<size_t> seq;
+        Task* task;
+    };
+
+    //the cells keep the head and the tail apart from sharing a cache line
+    atomic<size_t>           head{0};
+    Cell                     cells[CAPACITY];
+    atomic<size_t>           tail{0};
+
+    TaskQueue()
+    {
+        for (size_t i = 0; i < CAPACITY; ++i) cells[i].seq.store(i, memory_order_relaxed);
     }
 
-    void push(Task* task)
+    bool push(Task* task)
     {
-        {
-            lock_guard<mutex> lock{mtx};
-            taskDeque.back(task);
+        auto pos = tail.load(memory_order_relaxed);
+        while (true) {
+            auto& cell = cells[pos & (CAPACITY - 1)];
+            auto diff = (intptr_t)cell.seq.load(memory_order_acquire) - (intptr_t)pos;
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    cell.task = task;
+                    cell.seq.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  //full
+            } else {
+                pos = tail.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    Task* pop()
+    {
+        auto pos = head.load(memory_order_relaxed);
+        while (true) {
+            auto& cell = cells[pos & (CAPACITY - 1)];
+            auto diff = (intptr_t)cell.seq.load(memory_order_acquire) - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    auto task = cell.task;
+                    cell.seq.store(pos + CAPACITY, memory_order_release);
+                    return task;
+                }
+            } else if (diff < 0) {
+                return nullptr;  //empty
+            } else {
+                pos = head.load(memory_order_relaxed);
+            }
         }
-        ready.notify_one();
     }
 };
 
@@ -95,16 +202,22 @@ struct TaskQueue {
 struct TaskSchedulerImpl
 {
     Array<thread*>                 threads;
-    Array<TaskQueue*>              taskQueues;
-    atomic<uint32_t>               idx{0};
+    Array<TaskDeque*>              deques;               //per worker
+    TaskQueue*                     queue;                //requests from the outside of the workers
+    mutex                          mtx;                  //for the idle workers
+    condition_variable             ready;
+    atomic<int64_t>                queued{0};            //approximate count of the queued tasks
+    atomic<uint32_t>               sleepers{0};
+    bool                           terminated = false;
 
     TaskSchedulerImpl(uint32_t threadCnt)
     {
         threads.reserve(threadCnt);
-        taskQueues.reserve(threadCnt);
+        deques.reserve(threadCnt);
+        queue = new TaskQueue;
 
         for (uint32_t i = 0; i < threadCnt; ++i) {
-            taskQueues.push(new TaskQueue);
+            deques.push(new TaskDeque);
             threads.push(new thread);
         }
         for (uint32_t i = 0; i < threadCnt; ++i) {
@@ -114,57 +227,141 @@ struct TaskSchedulerImpl
 
     ~TaskSchedulerImpl()
     {
-        ARRAY_FOREACH(p, taskQueues) {
-            (*p)->complete();
+        {
+            lock_guard<mutex> lock{mtx};
+            terminated = true;
         }
+        ready.notify_all();
+
         ARRAY_FOREACH(p, threads) {
             (*p)->join();
             delete(*p);
         }
-        ARRAY_FOREACH(p, taskQueues) {
+        ARRAY_FOREACH(p, deques) {
             delete(*p);
         }
+        delete(queue);
     }
 
-    void run(unsigned i)
+    //worker index of the current thread, -1 if it's not a worker
+    int32_t worker()
     {
-        Task* task;
+        auto id = this_thread::get_id();
+        for (uint32_t i = 0; i < threads.count; ++i) {
+            if (threads[i]->get_id() == id) return i;
+        }
+        return -1;
+    }
+
+    Task* fetch(uint32_t i)
+    {
+        //own tasks first (LIFO), then the outer requests, then steal the others (FIFO)
+        auto task = deques[i]->pop();
+        if (!task) task = queue->pop();
+        for (uint32_t n = 1; !task && n < threads.count; ++n) {
+            task = deques[(i + n) % threads.count]->steal();
+        }
+        if (task) --queued;
+        return task;
+    }
+
+    void execute(Task* task, uint32_t i)
+    {
+        //the task could be released by the requester right after its completion
+        auto group = task->group;
+        auto& parking = _parking(task->remains);
+
+        task->run(i + 1);
+        task->remains.store(0);
+        parking.wake();
+
+        //the group is the last one to be touched, its waiter may release the tasks as well
+        if (group) {
+            auto& parking = _parking(group->remains);
+            if (group->remains.fetch_sub(1) == 1) parking.wake();
+        }
+    }
+
+    void run(uint32_t i)
+    {
+        auto spin = 0;
 
         //Thread Loop
         while (true) {
-            auto success = false;
-            for (uint32_t x = 0; x < threads.count * 2; ++x) {
-                if (taskQueues[(i + x) % threads.count]->tryPop(&task)) {
-                    success = true;
-                    break;
-                }
+            if (auto task = fetch(i)) {
+                execute(task, i);
+                spin = 0;
+                continue;
             }
-
-            if (!success && !taskQueues[i]->pop(&task)) break;
-            (*task)(i + 1);
+            if (++spin < SPIN_COUNT) {
+                this_thread::yield();
+                continue;
+            }
+            spin = 0;
+
+            //park until the new tasks arrive
+            unique_lock<mutex> lock{mtx};
+            ++sleepers;
+            while (queued.load() <= 0 && !terminated) ready.wait(lock);
+            --sleepers;
+            if (terminated && queued.load() <= 0) break;
         }
     }
 
-    void request(Task* task)
+    void request(Task* task, TaskGroup* group)
     {
         //Async
         if (threads.count > 0) {
-            task->prepare();
-            auto i = idx++;
-            for (uint32_t n = 0; n < threads.count; ++n) {
-                if (taskQueues[(i + n) % threads.count]->tryPush(task)) return;
+            task->pending = true;
+            task->remains.store(1);
+            task->group = group;
+            if (group) ++group->remains;
+
+            auto i = worker();
+            if (i < 0 || !deques[i]->push(task)) {
+                while (!queue->push(task)) this_thread::yield();
+            }
+            ++queued;
+
+            if (sleepers.load() > 0) {
+                lock_guard<mutex> lock{mtx};
+                ready.notify_one();
             }
-            taskQueues[i % threads.count]->push(task);
         //Sync
         } else {
             task->run(0);
         }
     }
 
+    void wait(atomic<uint32_t>& remains)
+    {
+        //help the others on a worker thread, it must not stall the queued tasks
+        auto i = worker();
+        for (auto spin = 0; remains.load() > 0; ++spin) {
+            if (i >= 0) {
+                if (auto task = fetch(i)) {
+                    execute(task, i);
+                    spin = 0;
+                    continue;
+                }
+            }
+            if (spin >= SPIN_COUNT) {
+                _parking(remains).wait(remains);
+                return;
+            }
+            this_thread::yield();
+        }
+    }
+
     uint32_t threadCnt()
     {
         return threads.count;
     }
+
+    uint32_t slot()
+    {
+        return worker() + 1;
+    }
 };
 
 #else //THORVG_THREAD_SUPPORT
@@ -172,8 +369,9 @@ struct TaskSchedulerImpl
 struct TaskSchedulerImpl
 {
     TaskSchedulerImpl(TVG_UNUSED uint32_t threadCnt) {}
-    void request(Task* task) { task->run(0); }
+    void request(Task* task, TVG_UNUSED TaskGroup* group) { task->run(0); }
     uint32_t threadCnt() { return 0; }
+    uint32_t slot() { return 0; }
 };
 
 #endif //THORVG_THREAD_SUPPORT
@@ -203,12 +401,22 @@ void TaskScheduler::term()
 }
 
 
-void TaskScheduler::request(Task* task)
+void TaskScheduler::request(Task* task, TaskGroup* group)
 {
-    if (_inst) _inst->request(task);
+    if (_inst) _inst->request(task, group);
 }
 
 
+#ifdef THORVG_THREAD_SUPPORT
+void TaskScheduler::wait(atomic<uint32_t>& remains)
+{
+    if (remains.load() == 0) return;
+    if (_inst) _inst->wait(remains);
+    else _parking(remains).wait(remains);
+}
+#endif
+
+
 uint32_t TaskScheduler::threads()
 {
     return _inst ? _inst->threadCnt() : 0;
@@ -221,6 +429,12 @@ bool TaskScheduler::onthread()
 }
 
 
+uint32_t TaskScheduler::slot()
+{
+    return _inst ? _inst->slot() : 0;
+}
+
+
 ThreadID TaskScheduler::tid()
 {
 #ifdef THORVG_THREAD_SUPPORT
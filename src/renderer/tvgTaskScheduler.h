@@ -29,23 +29,46 @@
 #ifdef THORVG_THREAD_SUPPORT
     #include <atomic>
     #include <thread>
-    #include <mutex>
-    #include <condition_variable>
 #endif
 
 namespace tvg {
 
+struct Task;
+struct TaskGroup;
 
 #ifdef THORVG_THREAD_SUPPORT
 
 using ThreadID = std::thread::id;
 
+#else
+
+using ThreadID = uint8_t;
+
+#endif
+
+
+struct TaskScheduler
+{
+    static uint32_t threads();
+    static void init(uint32_t threads);
+    static void term();
+    static void request(Task* task, TaskGroup* group = nullptr);
+    static bool onthread();  //figure out whether on worker thread or not
+    static ThreadID tid();
+    static uint32_t slot();  //the tid of Task::run() on the current thread, 0 if it's not a worker
+#ifdef THORVG_THREAD_SUPPORT
+    static void wait(atomic<uint32_t>& remains);  //block until the remains is zero
+#endif
+};
+
+
+#ifdef THORVG_THREAD_SUPPORT
+
 struct Task
 {
 private:
-    mutex                   mtx;
-    condition_variable      cv;
-    bool                    ready = true;
+    atomic<uint32_t>        remains{0};           //0: ready, 1: running or queued
+    TaskGroup*              group = nullptr;
     bool                    pending = false;
 
 public:
@@ -56,9 +79,7 @@ public:
     void done()
     {
         if (!pending) return;
-
-        unique_lock<mutex> lock(mtx);
-        while (!ready) cv.wait(lock);
+        TaskScheduler::wait(remains);
         pending = false;
     }
 
@@ -66,19 +87,20 @@ protected:
     virtual void run(unsigned tid) = 0;
 
 private:
-    void operator()(unsigned tid)
-    {
-        run(tid);
+    friend struct TaskSchedulerImpl;
+};
 
-        lock_guard<mutex> lock(mtx);
-        ready = true;
-        cv.notify_one();
-    }
 
-    void prepare()
+//Counts the unfinished tasks requested with it, to wait for all of them at once.
+struct TaskGroup
+{
+private:
+    atomic<uint32_t>        remains{0};
+
+public:
+    void wait()
     {
-        ready = false;
-        pending = true;
+        TaskScheduler::wait(remains);
     }
 
     friend struct TaskSchedulerImpl;
@@ -86,8 +108,6 @@ private:
 
 #else  //THORVG_THREAD_SUPPORT
 
-using ThreadID = uint8_t;
-
 struct Task
 {
 public:
@@ -103,19 +123,14 @@ private:
     friend struct TaskSchedulerImpl;
 };
 
-#endif  //THORVG_THREAD_SUPPORT
-
 
-struct TaskScheduler
+struct TaskGroup
 {
-    static uint32_t threads();
-    static void init(uint32_t threads);
-    static void term();
-    static void request(Task* task);
-    static bool onthread();  //figure out whether on worker thread or not
-    static ThreadID tid();
+    void wait() {}
 };
 
+#endif  //THORVG_THREAD_SUPPORT
+
 }  //namespace
 
 #endif //_TVG_TASK_SCHEDULER_H_
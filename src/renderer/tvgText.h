@@ -120,6 +120,9 @@ struct TextImpl : Text
 
     bool update(RenderMethod* renderer, const Matrix& transform, Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flag, TVG_UNUSED bool clipper)
     {
+        //the previous rendering task could still refer the text shape, wait for it before reloading
+        if (impl.marked(RenderUpdateFlag::Path)) renderer->done(SHAPE(shape)->impl.rd);
+
         auto scale = 1.0f / load();
         if (tvg::zero(scale)) return false;
 
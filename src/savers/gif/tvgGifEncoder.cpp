@@ -45,13 +45,18 @@
 // Finally, call GifEnd() to close the file handle and free memory.
 //
 
+#include <new>
 #include "tvgMath.h"
+#include "tvgTaskScheduler.h"
 #include "tvgGifEncoder.h"
 
 
 #define TRANSPARENT_IDX 0
 #define TRANSPARENT_THRESHOLD 127
 #define BIT_DEPTH 8
+#define CACHE_BITS 4              // bits per channel addressing the nearest color cache
+#define SPLIT_THRESHOLD 16384     // pixels worth building a palette subtree concurrently
+#define STRIP_MIN_ROWS 16
 
 
 // Simple structure to write out the LZW-compressed portion of the image
@@ -74,6 +79,56 @@ typedef struct
 } GifLzwNode;
 
 
+// Memoizes the nearest palette entries of the recent colors in a small 3-D table.
+// Each slot keeps the exact color it was searched for, so a hit is identical to the tree search.
+typedef struct
+{
+    uint32_t colors[1 << (CACHE_BITS * 3)];   // 0x1rrggbb, zero for an empty slot
+    uint8_t indices[1 << (CACHE_BITS * 3)];
+} GifColorCache;
+
+
+// a horizontal strip of the frame to palettize
+struct GifStrip : Task
+{
+    GifPalette* pal;
+    const uint8_t* lastFrame;
+    const uint8_t* nextFrame;
+    uint8_t* outFrame;
+    uint8_t* indices;
+    uint32_t numPixels;
+    bool transparent;
+    GifColorCache cache;
+
+    void run(unsigned tid) override;
+};
+
+
+// the LZW compressed image block of a palettized frame
+struct GifLzw : Task
+{
+    FILE* f;
+    uint8_t* indices;
+    GifLzwNode* codetree;
+    GifPalette pal;
+    uint32_t width, height, delay;
+    bool transparent;
+
+    void run(unsigned tid) override;
+};
+
+
+// a subtree of the palette k-d tree
+struct GifSplit : Task
+{
+    uint8_t* image;
+    int numPixels, firstElt, lastElt, splitElt, splitDist, treeNode;
+    GifPalette* pal;
+
+    void run(unsigned tid) override;
+};
+
+
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
@@ -254,11 +309,36 @@ static void _splitPalette(uint8_t* image, int numPixels, int firstElt, int lastE
     pal->treeSplitElt[treeNode] = (uint8_t)splitCom;
     pal->treeSplit[treeNode] = image[subPixelsA*4+splitCom];
 
+    // the subtrees cover the disjoint pixels and nodes, the large ones are built concurrently
+    if (TaskScheduler::threads() > 0 && subPixelsA > SPLIT_THRESHOLD && subPixelsB > SPLIT_THRESHOLD) {
+        GifSplit left;
+        left.image = image;
+        left.numPixels = subPixelsA;
+        left.firstElt = firstElt;
+        left.lastElt = splitElt;
+        left.splitElt = splitElt-splitDist;
+        left.splitDist = splitDist/2;
+        left.treeNode = treeNode*2;
+        left.pal = pal;
+
+        TaskGroup group;
+        TaskScheduler::request(&left, &group);
+        _splitPalette(image+subPixelsA*4, subPixelsB, splitElt, lastElt,  splitElt+splitDist, splitDist/2, treeNode*2+1, pal);
+        group.wait();
+        return;
+    }
+
     _splitPalette(image, subPixelsA, firstElt, splitElt, splitElt-splitDist, splitDist/2, treeNode*2, pal);
     _splitPalette(image+subPixelsA*4, subPixelsB, splitElt, lastElt,  splitElt+splitDist, splitDist/2, treeNode*2+1, pal);
 }
 
 
+void GifSplit::run(TVG_UNUSED unsigned tid)
+{
+    _splitPalette(image, numPixels, firstElt, lastElt, splitElt, splitDist, treeNode, pal);
+}
+
+
 // Finds all pixels that have changed from the previous image and
 // moves them to the from of the buffer.
 // This allows us to build a palette optimized for the colors of the
@@ -311,25 +391,38 @@ static void _makePalette(GifWriter* writer, const uint8_t* lastFrame, const uint
 }
 
 
-void _palettizePixel(const uint8_t* nextFrame, uint8_t* outFrame, GifPalette* pPal)
+static uint8_t _palettizePixel(const uint8_t* nextFrame, uint8_t* outFrame, GifPalette* pPal, GifColorCache* cache)
 {
-    int32_t bestDiff = 1000000;
+    uint32_t color = 0x1000000 | (nextFrame[0] << 16) | (nextFrame[1] << 8) | nextFrame[2];
+    uint32_t slot = ((nextFrame[0] >> (8 - CACHE_BITS)) << (CACHE_BITS * 2)) | ((nextFrame[1] >> (8 - CACHE_BITS)) << CACHE_BITS) | (nextFrame[2] >> (8 - CACHE_BITS));
+
     int32_t bestInd = 1;
-    _getClosestPaletteColor(pPal, nextFrame[0], nextFrame[1], nextFrame[2], &bestInd, &bestDiff, 1);
+    if (cache->colors[slot] == color) {
+        bestInd = cache->indices[slot];
+    } else {
+        int32_t bestDiff = 1000000;
+        _getClosestPaletteColor(pPal, nextFrame[0], nextFrame[1], nextFrame[2], &bestInd, &bestDiff, 1);
+        cache->colors[slot] = color;
+        cache->indices[slot] = (uint8_t)bestInd;
+    }
 
     // Write the resulting color to the output buffer
     outFrame[0] = pPal->r[bestInd];
     outFrame[1] = pPal->g[bestInd];
     outFrame[2] = pPal->b[bestInd];
-    outFrame[3] = (uint8_t)bestInd;
+    return (uint8_t)bestInd;
 }
 
 
-// Picks palette colors for the image using simple threshholding, no dithering
-static void _thresholdImage(GifWriter* writer, const uint8_t* lastFrame, const uint8_t* nextFrame,  uint32_t width, uint32_t height, bool transparent)
+// Picks palette colors for the strip using simple threshholding, no dithering
+void GifStrip::run(TVG_UNUSED unsigned tid)
 {
-    auto outFrame = writer->oldImage;
-    uint32_t numPixels = width*height;
+    // the palette has been changed
+    memset(cache.colors, 0, sizeof(cache.colors));
+
+    auto lastFrame = this->lastFrame;
+    auto nextFrame = this->nextFrame;
+    auto outFrame = this->outFrame;
 
     if (transparent) {
         for (uint32_t ii = 0; ii < numPixels; ++ii) {
@@ -337,9 +430,9 @@ static void _thresholdImage(GifWriter* writer, const uint8_t* lastFrame, const u
                 outFrame[0] = 0;
                 outFrame[1] = 0;
                 outFrame[2] = 0;
-                outFrame[3] = TRANSPARENT_IDX;
+                indices[ii] = TRANSPARENT_IDX;
             } else {
-                _palettizePixel(nextFrame, outFrame, &writer->pal);
+                indices[ii] = _palettizePixel(nextFrame, outFrame, pal, &cache);
             }
             if (lastFrame) lastFrame += 4;
             outFrame += 4;
@@ -353,9 +446,9 @@ static void _thresholdImage(GifWriter* writer, const uint8_t* lastFrame, const u
                 outFrame[0] = lastFrame[0];
                 outFrame[1] = lastFrame[1];
                 outFrame[2] = lastFrame[2];
-                outFrame[3] = TRANSPARENT_IDX;
+                indices[ii] = TRANSPARENT_IDX;
             } else {
-                _palettizePixel(nextFrame, outFrame, &writer->pal);
+                indices[ii] = _palettizePixel(nextFrame, outFrame, pal, &cache);
             }
             if (lastFrame) lastFrame += 4;
             outFrame += 4;
@@ -365,6 +458,30 @@ static void _thresholdImage(GifWriter* writer, const uint8_t* lastFrame, const u
 }
 
 
+// Palettizes the image strips concurrently, the pixels are independent of each other
+static void _thresholdImage(GifWriter* writer, const uint8_t* lastFrame, const uint8_t* nextFrame, uint8_t* indices, uint32_t width, uint32_t height, bool transparent)
+{
+    auto rows = height / writer->stripCnt;
+    TaskGroup group;
+
+    for (uint32_t i = 0; i < writer->stripCnt; ++i) {
+        auto& strip = writer->strips[i];
+        auto begin = i * rows * width;
+        auto end = (i + 1 == writer->stripCnt) ? height * width : (i + 1) * rows * width;
+        strip.pal = &writer->pal;
+        strip.lastFrame = lastFrame ? lastFrame + begin * 4 : nullptr;
+        strip.nextFrame = nextFrame + begin * 4;
+        strip.outFrame = writer->oldImage + begin * 4;
+        strip.indices = indices + begin;
+        strip.numPixels = end - begin;
+        strip.transparent = transparent;
+        if (i > 0) TaskScheduler::request(&strip, &group);
+    }
+    writer->strips[0].run(0);
+    group.wait();
+}
+
+
 // insert a single bit
 static void _writeBit(GifBitStatus* stat, uint32_t bit)
 {
@@ -425,10 +542,8 @@ static void _writePalette(const GifPalette* pPal, FILE* f)
 
 
 // write the image header, LZW-compress and write out the image
-static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, uint32_t delay, bool transparent)
+void GifLzw::run(TVG_UNUSED unsigned tid)
 {
-    auto f = writer->f;
-    auto image = writer->oldImage;
 
     // graphics control extension
     fputc(0x21, f);
@@ -457,15 +572,13 @@ static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, u
     //fputc(0x80, f); // no local color table, but transparency
 
     fputc(0x80 + BIT_DEPTH - 1, f); // local color table present, 2 ^ bitDepth entries
-    _writePalette(&writer->pal, f);
+    _writePalette(&pal, f);
 
     const int minCodeSize = BIT_DEPTH;
     const uint32_t clearCode = 1 << BIT_DEPTH;
 
     fputc(minCodeSize, f); // min code size 8 bits
 
-    GifLzwNode* codetree = tvg::malloc<GifLzwNode*>(sizeof(GifLzwNode)*4096);
-
     memset(codetree, 0, sizeof(GifLzwNode)*4096);
     int32_t curCode = -1;
     uint32_t codeSize = (uint32_t)minCodeSize + 1;
@@ -481,7 +594,7 @@ static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, u
     for (uint32_t yy = 0; yy < height; ++yy) {
         for (uint32_t xx=0; xx<width; ++xx) {
             // top-left origin
-            uint8_t nextValue = image[(yy*width+xx)*4+3];
+            uint8_t nextValue = indices[yy*width+xx];
 
             // "loser mode" - no compression, every single code is followed immediately by a clear
             //WriteCode( f, stat, nextValue, codeSize );
@@ -529,8 +642,30 @@ static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, u
     if (stat.chunkIndex) _writeChunk(f, &stat);
 
     fputc(0, f); // image block terminator
+}
+
+
+static void _release(GifWriter* writer)
+{
+    for (int i = 0; i < 2; ++i) {
+        auto lzw = writer->lzw[i];
+        if (!lzw) continue;
+        lzw->done();
+        tvg::free(lzw->indices);
+        tvg::free(lzw->codetree);
+        delete(lzw);
+        writer->lzw[i] = NULL;
+    }
+    delete[](writer->strips);
+    writer->strips = NULL;
 
-    tvg::free(codetree);
+    fclose(writer->f);
+    tvg::free(writer->oldImage);
+    tvg::free(writer->tmpImage);
+
+    writer->f = NULL;
+    writer->oldImage = NULL;
+    writer->tmpImage = NULL;
 }
 
 
@@ -555,6 +690,30 @@ bool gifBegin(GifWriter* writer, const char* filename, uint32_t width, uint32_t
     writer->oldImage = tvg::malloc<uint8_t*>(width*height*4);
     writer->tmpImage = tvg::malloc<uint8_t*>(width*height*4);
 
+    writer->stripCnt = std::max(1U, std::min(TaskScheduler::threads() + 1, height / STRIP_MIN_ROWS));
+    writer->strips = new (std::nothrow) GifStrip[writer->stripCnt];
+
+    auto valid = writer->oldImage && writer->tmpImage && writer->strips;
+
+    for (int i = 0; i < 2; ++i) {
+        auto lzw = new (std::nothrow) GifLzw;
+        writer->lzw[i] = lzw;
+        if (!lzw) {
+            valid = false;
+            continue;
+        }
+        lzw->f = writer->f;
+        lzw->indices = tvg::malloc<uint8_t*>(width*height);
+        lzw->codetree = tvg::malloc<GifLzwNode*>(sizeof(GifLzwNode)*4096);
+        if (!lzw->indices || !lzw->codetree) valid = false;
+    }
+    writer->frameCnt = 0;
+
+    if (!valid) {
+        _release(writer);
+        return false;
+    }
+
     fputs("GIF89a", writer->f);
 
     // screen descriptor
@@ -603,9 +762,23 @@ bool gifWriteFrame(GifWriter* writer, const uint8_t* image, uint32_t width, uint
     const uint8_t* oldImage = writer->firstFrame? NULL : writer->oldImage;
     writer->firstFrame = false;
 
+    // the frames alternate the encodings, the other one is still busy with the previous frame
+    auto lzw = writer->lzw[writer->frameCnt % 2];
+    auto prev = writer->lzw[(writer->frameCnt + 1) % 2];
+    ++writer->frameCnt;
+
     _makePalette(writer, oldImage, image, width, height, 8, transparent);
-    _thresholdImage(writer, oldImage, image, width, height, transparent);
-    _writeLzwImage(writer, width, height, delay, transparent);
+    _thresholdImage(writer, oldImage, image, lzw->indices, width, height, transparent);
+
+    // keep the frames in order, then compress this one while the next frame is palettized
+    prev->done();
+
+    lzw->pal = writer->pal;
+    lzw->width = width;
+    lzw->height = height;
+    lzw->delay = delay;
+    lzw->transparent = transparent;
+    TaskScheduler::request(lzw);
 
     return true;
 }
@@ -615,13 +788,12 @@ bool gifEnd(GifWriter* writer)
 {
     if (!writer->f) return false;
 
+    // the compressed frames are written out in the meantime
+    for (int i = 0; i < 2; ++i) writer->lzw[i]->done();
+
     fputc(0x3b, writer->f); // end of file
-    fclose(writer->f);
-    tvg::free(writer->oldImage);
-    tvg::free(writer->tmpImage);
 
-    writer->f = NULL;
-    writer->oldImage = NULL;
+    _release(writer);
 
     return true;
 }
@@ -40,6 +40,9 @@ typedef struct
 } GifPalette;
 
 
+struct GifStrip;
+struct GifLzw;
+
 typedef struct
 {
     FILE* f;
@@ -47,6 +50,11 @@ typedef struct
     uint8_t* tmpImage;
     GifPalette pal;
     bool firstFrame;
+
+    GifStrip* strips;      // image strips palettized concurrently
+    uint32_t stripCnt;
+    GifLzw* lzw[2];        // LZW encodings of the previous and the current frames, written out behind the palettizing
+    uint32_t frameCnt;
 } GifWriter;
 
 
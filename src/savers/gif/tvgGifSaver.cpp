@@ -23,6 +23,7 @@
 #include <cstring>
 #include <memory>
 #include "tvgStr.h"
+#include "tvgAnimation.h"
 #include "tvgGifEncoder.h"
 #include "tvgGifSaver.h"
 
@@ -30,6 +31,60 @@
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+//experimental decision: bounds the frames rendered at once, 64MB fits 8 frames of 1080p
+static constexpr size_t BATCH_BUDGET = 64 * 1024 * 1024;
+
+
+/* Renders the frames in batches, the replicas of the animation render each batch concurrently.
+   It returns false if it's stopped, the written frames are counted so that the rest can be rendered one by one. */
+static bool _batch(Animation* animation, const Paint* bg, GifWriter& writer, const Array<float>& frames, uint32_t w, uint32_t h, uint32_t delay, bool transparent, uint32_t& written)
+{
+    written = 0;
+
+    //experimental decision: a few frames per thread keep the threads busy with the bounded memory
+    auto frameSize = sizeof(uint32_t) * w * h;
+    auto size = std::min(frames.count, 4 * (TaskScheduler::threads() + 1));
+    size = std::max(std::min(size, uint32_t(BATCH_BUDGET / frameSize)), 1U);
+
+    auto pixels = tvg::malloc<uint32_t*>(frameSize * size);
+    auto buffers = tvg::malloc<uint32_t**>(sizeof(uint32_t*) * size);
+
+    if (!pixels || !buffers) {
+        tvg::free(buffers);
+        tvg::free(pixels);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < size; ++i) buffers[i] = pixels + w * h * i;
+
+    auto ret = true;
+
+    for (uint32_t i = 0; i < frames.count && ret; i += size) {
+        auto cnt = std::min(size, frames.count - i);
+        //the replicas draw the background as well, the same with the serial rendering
+        if (animation->pImpl->render(frames.data + i, buffers, cnt, w, w, h, ColorSpace::ABGR8888S, bg) != Result::Success) {
+            //not replicable or out of memory, the remaining frames are left to the caller
+            if (i > 0) TVGLOG("GIF_SAVER", "Failed gif batch rendering from the frame(%u)", i);
+            ret = false;
+            break;
+        }
+        for (uint32_t j = 0; j < cnt; ++j) {
+            if (!gifWriteFrame(&writer, reinterpret_cast<uint8_t*>(buffers[j]), w, h, delay, transparent)) {
+                TVGERR("GIF_SAVER", "Failed gif encoding");
+                ret = false;
+                break;
+            }
+            ++written;
+        }
+    }
+
+    tvg::free(buffers);
+    tvg::free(pixels);
+
+    return ret;
+}
+
+
 void GifSaver::run(unsigned tid)
 {
     auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
@@ -40,10 +95,7 @@ void GifSaver::run(unsigned tid)
 
     buffer = tvg::realloc<uint32_t*>(buffer, sizeof(uint32_t) * w * h);
     canvas->target(buffer, w, w, h, ColorSpace::ABGR8888S);
-    canvas->push(bg);
-    bg = nullptr;
-
-    canvas->push(animation->picture());
+    if (bg) canvas->push(bg);   //the canvas holds its own reference, released in close()
 
     //use the default fps
     if (fps > 60.0f) fps = 60.0f;   // just in case
@@ -62,16 +114,25 @@ void GifSaver::run(unsigned tid)
 
     auto duration = animation->duration();
 
+    Array<float> frames;
     for (auto p = 0.0f; p < duration; p += delay) {
-        auto frameNo = animation->totalFrame() * (p / duration);
-        animation->frame(frameNo);
-        canvas->update();
-        if (canvas->draw(true) == tvg::Result::Success) {
-            canvas->sync();
-        }
-        if (!gifWriteFrame(&writer, reinterpret_cast<uint8_t*>(buffer), w, h, uint32_t(delay * 100.0f), transparent)) {
-            TVGERR("GIF_SAVER", "Failed gif encoding");
-            break;
+        frames.push(animation->totalFrame() * (p / duration));
+    }
+
+    uint32_t written;
+    if (!_batch(animation, bg, writer, frames, w, h, uint32_t(delay * 100.0f), transparent, written)) {
+        canvas->push(animation->picture());
+
+        for (auto p = frames.begin() + written; p < frames.end(); ++p) {
+            animation->frame(*p);
+            canvas->update();
+            if (canvas->draw(true) == tvg::Result::Success) {
+                canvas->sync();
+            }
+            if (!gifWriteFrame(&writer, reinterpret_cast<uint8_t*>(buffer), w, h, uint32_t(delay * 100.0f), transparent)) {
+                TVGERR("GIF_SAVER", "Failed gif encoding");
+                break;
+            }
         }
     }
 
@@ -0,0 +1,658 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "tvgPngEncoder.h"
+
+
+#define WINDOW_SIZE 32768
+#define HASH_BITS 15
+#define MIN_MATCH 3
+#define MAX_MATCH 258
+#define MAX_CHAIN 64               // match candidates tried per position
+#define NICE_MATCH 128             // long enough to stop searching
+#define BLOCK_SYMBOLS 65536        // lz77 symbols per deflate block
+#define BPP 4                      // rgba8
+
+
+// growing byte stream, the deflate bits are packed from the least significant bit
+typedef struct
+{
+    uint8_t* data;
+    uint32_t size;
+    uint32_t reserved;
+    uint32_t bits;
+    uint32_t bitCnt;
+} PngStream;
+
+
+struct PngCrc
+{
+    uint32_t table[256];
+
+    PngCrc()
+    {
+        for (uint32_t n = 0; n < 256; ++n) {
+            auto c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? (0xedb88320u ^ (c >> 1)) : (c >> 1);
+            table[n] = c;
+        }
+    }
+};
+
+
+static const uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DIST_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t DIST_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+static const uint8_t CL_ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+static void _put32(uint8_t* p, uint32_t value)
+{
+    p[0] = (value >> 24) & 0xff;
+    p[1] = (value >> 16) & 0xff;
+    p[2] = (value >> 8) & 0xff;
+    p[3] = value & 0xff;
+}
+
+
+static uint32_t _crc(uint32_t crc, const uint8_t* data, uint32_t size)
+{
+    static const PngCrc crcs;
+    for (uint32_t i = 0; i < size; ++i) crc = crcs.table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+
+
+static uint32_t _adler32(const uint8_t* data, uint32_t size)
+{
+    uint32_t a = 1, b = 0;
+    while (size > 0) {
+        // the largest count not to overflow before the modulo
+        auto cnt = std::min(size, 5552U);
+        size -= cnt;
+        while (cnt--) {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+
+static void _grow(PngStream* stream, uint32_t size)
+{
+    if (stream->size + size <= stream->reserved) return;
+    stream->reserved = (stream->size + size) * 2;
+    stream->data = tvg::realloc<uint8_t*>(stream->data, stream->reserved);
+}
+
+
+static void _putByte(PngStream* stream, uint8_t byte)
+{
+    _grow(stream, 1);
+    stream->data[stream->size++] = byte;
+}
+
+
+static void _putBits(PngStream* stream, uint32_t value, uint32_t cnt)
+{
+    stream->bits |= value << stream->bitCnt;
+    stream->bitCnt += cnt;
+    while (stream->bitCnt >= 8) {
+        _putByte(stream, stream->bits & 0xff);
+        stream->bits >>= 8;
+        stream->bitCnt -= 8;
+    }
+}
+
+
+static void _flushBits(PngStream* stream)
+{
+    if (stream->bitCnt > 0) _putByte(stream, stream->bits & 0xff);
+    stream->bits = 0;
+    stream->bitCnt = 0;
+}
+
+
+static uint32_t _lengthCode(uint32_t length)
+{
+    uint32_t code = 28;
+    while (LENGTH_BASE[code] > length) --code;
+    return code;
+}
+
+
+static uint32_t _distCode(uint32_t dist)
+{
+    uint32_t code = 29;
+    while (DIST_BASE[code] > dist) --code;
+    return code;
+}
+
+
+// Computes the huffman code lengths limited to maxBits, by flattening the frequencies until it fits.
+// At least two codes are given for the decoders which reject an incomplete tree.
+static void _huffmanLengths(const uint32_t* freqs, uint32_t cnt, uint32_t maxBits, uint8_t* lengths)
+{
+    uint32_t scaled[288];
+    uint32_t symbols[288];
+    uint32_t weights[575];
+    uint32_t parents[575];
+    uint32_t depths[575];
+
+    memset(lengths, 0, cnt);
+
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < cnt; ++i) {
+        scaled[i] = freqs[i];
+        if (freqs[i]) symbols[n++] = i;
+    }
+
+    if (n < 2) {
+        auto first = (n == 1) ? symbols[0] : 0;
+        lengths[first] = 1;
+        lengths[(first == 0) ? 1 : 0] = 1;
+        return;
+    }
+
+    std::sort(symbols, symbols + n, [&](uint32_t a, uint32_t b) {
+        return (scaled[a] == scaled[b]) ? (a < b) : (scaled[a] < scaled[b]);
+    });
+
+    while (true) {
+        // two queues of the sorted leaves and the internal nodes which are made in the weight order
+        for (uint32_t k = 0; k < n; ++k) weights[k] = scaled[symbols[k]];
+        uint32_t leaf = 0, node = n, next = n;
+
+        auto pick = [&]() -> uint32_t {
+            if (leaf < n && (node == next || weights[leaf] <= weights[node])) return leaf++;
+            return node++;
+        };
+
+        while (next < 2 * n - 1) {
+            auto a = pick();
+            auto b = pick();
+            weights[next] = weights[a] + weights[b];
+            parents[a] = parents[b] = next;
+            ++next;
+        }
+
+        // the parents are always made after their children
+        uint32_t maxDepth = 0;
+        depths[2 * n - 2] = 0;
+        for (int32_t k = 2 * n - 3; k >= 0; --k) {
+            depths[k] = depths[parents[k]] + 1;
+            if (depths[k] > maxDepth) maxDepth = depths[k];
+        }
+
+        if (maxDepth <= maxBits) {
+            for (uint32_t k = 0; k < n; ++k) lengths[symbols[k]] = depths[k];
+            return;
+        }
+
+        // the leaves keep their order, the halved frequencies stay sorted
+        for (uint32_t k = 0; k < n; ++k) scaled[symbols[k]] = (scaled[symbols[k]] >> 1) | 1;
+    }
+}
+
+
+// canonical huffman codes, bit-reversed to be written from the least significant bit
+static void _huffmanCodes(const uint8_t* lengths, uint32_t cnt, uint16_t* codes)
+{
+    uint32_t lengthCnt[16] = {0};
+    uint32_t nextCode[16] = {0};
+
+    for (uint32_t i = 0; i < cnt; ++i) ++lengthCnt[lengths[i]];
+    lengthCnt[0] = 0;
+
+    uint32_t code = 0;
+    for (uint32_t bits = 1; bits < 16; ++bits) {
+        code = (code + lengthCnt[bits - 1]) << 1;
+        nextCode[bits] = code;
+    }
+
+    for (uint32_t i = 0; i < cnt; ++i) {
+        auto length = lengths[i];
+        if (length == 0) continue;
+        code = nextCode[length]++;
+        uint32_t reversed = 0;
+        for (uint32_t k = 0; k < length; ++k) {
+            reversed = (reversed << 1) | (code & 1);
+            code >>= 1;
+        }
+        codes[i] = (uint16_t)reversed;
+    }
+}
+
+
+// a deflate block with the dynamic huffman codes of the symbols, a literal or a (length << 16 | distance) match
+static void _writeBlock(PngStream* stream, const uint32_t* symbols, uint32_t cnt, bool last)
+{
+    uint32_t litFreqs[286] = {0};
+    uint32_t distFreqs[30] = {0};
+
+    for (uint32_t i = 0; i < cnt; ++i) {
+        auto symbol = symbols[i];
+        if (symbol >> 16) {
+            ++litFreqs[257 + _lengthCode(symbol >> 16)];
+            ++distFreqs[_distCode(symbol & 0xffff)];
+        } else ++litFreqs[symbol];
+    }
+    ++litFreqs[256];   // end of block
+
+    uint8_t litLengths[286], distLengths[30];
+    uint16_t litCodes[286], distCodes[30];
+    _huffmanLengths(litFreqs, 286, 15, litLengths);
+    _huffmanLengths(distFreqs, 30, 15, distLengths);
+    _huffmanCodes(litLengths, 286, litCodes);
+    _huffmanCodes(distLengths, 30, distCodes);
+
+    uint32_t hlit = 286;
+    while (hlit > 257 && litLengths[hlit - 1] == 0) --hlit;
+    uint32_t hdist = 30;
+    while (hdist > 1 && distLengths[hdist - 1] == 0) --hdist;
+
+    // run-length encode the code lengths of both trees in one sequence
+    uint8_t lengths[316];
+    memcpy(lengths, litLengths, hlit);
+    memcpy(lengths + hlit, distLengths, hdist);
+    auto total = hlit + hdist;
+
+    uint8_t runs[316], extras[316];
+    uint32_t runCnt = 0;
+    uint32_t clFreqs[19] = {0};
+
+    for (uint32_t i = 0; i < total;) {
+        auto value = lengths[i];
+        uint32_t repeat = 1;
+        while (i + repeat < total && lengths[i + repeat] == value) ++repeat;
+
+        if (value == 0 && repeat >= 3) {
+            repeat = std::min(repeat, 138U);
+            runs[runCnt] = (repeat >= 11) ? 18 : 17;
+            extras[runCnt] = (repeat >= 11) ? (repeat - 11) : (repeat - 3);
+            i += repeat;
+        } else if (value != 0 && repeat >= 4) {
+            runs[runCnt++] = value;
+            ++clFreqs[value];
+            repeat = std::min(repeat - 1, 6U);
+            runs[runCnt] = 16;
+            extras[runCnt] = repeat - 3;
+            i += repeat + 1;
+        } else {
+            runs[runCnt] = value;
+            ++i;
+        }
+        ++clFreqs[runs[runCnt++]];
+    }
+
+    uint8_t clLengths[19];
+    uint16_t clCodes[19];
+    _huffmanLengths(clFreqs, 19, 7, clLengths);
+    _huffmanCodes(clLengths, 19, clCodes);
+
+    uint32_t hclen = 19;
+    while (hclen > 4 && clLengths[CL_ORDER[hclen - 1]] == 0) --hclen;
+
+    // block header
+    _putBits(stream, last ? 1 : 0, 1);
+    _putBits(stream, 2, 2);  // dynamic huffman codes
+    _putBits(stream, hlit - 257, 5);
+    _putBits(stream, hdist - 1, 5);
+    _putBits(stream, hclen - 4, 4);
+    for (uint32_t i = 0; i < hclen; ++i) _putBits(stream, clLengths[CL_ORDER[i]], 3);
+
+    for (uint32_t i = 0; i < runCnt; ++i) {
+        auto run = runs[i];
+        _putBits(stream, clCodes[run], clLengths[run]);
+        if (run == 16) _putBits(stream, extras[i], 2);
+        else if (run == 17) _putBits(stream, extras[i], 3);
+        else if (run == 18) _putBits(stream, extras[i], 7);
+    }
+
+    // compressed data
+    for (uint32_t i = 0; i < cnt; ++i) {
+        auto symbol = symbols[i];
+        if (symbol >> 16) {
+            auto length = symbol >> 16;
+            auto dist = symbol & 0xffff;
+            auto code = _lengthCode(length);
+            _putBits(stream, litCodes[257 + code], litLengths[257 + code]);
+            _putBits(stream, length - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+            code = _distCode(dist);
+            _putBits(stream, distCodes[code], distLengths[code]);
+            _putBits(stream, dist - DIST_BASE[code], DIST_EXTRA[code]);
+        } else {
+            _putBits(stream, litCodes[symbol], litLengths[symbol]);
+        }
+    }
+    _putBits(stream, litCodes[256], litLengths[256]);
+}
+
+
+static uint32_t _hash(const uint8_t* p)
+{
+    return ((p[0] << 10) ^ (p[1] << 5) ^ p[2]) & ((1 << HASH_BITS) - 1);
+}
+
+
+// zlib stream of the greedy lz77 matches over the hash chains
+static void _compress(PngStream* stream, const uint8_t* in, uint32_t size)
+{
+    _putByte(stream, 0x78);  // deflate, 32K window
+    _putByte(stream, 0x01);  // no dictionary, fastest compression hint
+
+    auto head = tvg::malloc<int32_t*>(sizeof(int32_t) * (1 << HASH_BITS));
+    auto prev = tvg::malloc<int32_t*>(sizeof(int32_t) * WINDOW_SIZE);
+    auto symbols = tvg::malloc<uint32_t*>(sizeof(uint32_t) * BLOCK_SYMBOLS);
+    for (uint32_t i = 0; i < (1 << HASH_BITS); ++i) head[i] = -1;
+
+    uint32_t cnt = 0;
+    uint32_t i = 0;
+
+    while (i < size) {
+        uint32_t bestLength = 0, bestDist = 0;
+
+        if (i + MIN_MATCH <= size) {
+            auto limit = std::min((uint32_t)MAX_MATCH, size - i);
+            auto candidate = head[_hash(in + i)];
+            for (uint32_t chain = 0; candidate >= 0 && i - candidate <= WINDOW_SIZE && chain < MAX_CHAIN; ++chain) {
+                auto p = in + candidate;
+                // can't be longer than the best one
+                if (bestLength > 0 && p[bestLength] != in[i + bestLength]) {
+                    candidate = prev[candidate % WINDOW_SIZE];
+                    continue;
+                }
+                uint32_t length = 0;
+                while (length < limit && p[length] == in[i + length]) ++length;
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestDist = i - candidate;
+                    if (length >= std::min((uint32_t)NICE_MATCH, limit)) break;
+                }
+                candidate = prev[candidate % WINDOW_SIZE];
+            }
+        }
+
+        uint32_t advance = 1;
+        if (bestLength >= MIN_MATCH) {
+            symbols[cnt++] = (bestLength << 16) | bestDist;
+            advance = bestLength;
+        } else {
+            symbols[cnt++] = in[i];
+        }
+
+        for (uint32_t k = 0; k < advance; ++k, ++i) {
+            if (i + MIN_MATCH > size) continue;
+            auto h = _hash(in + i);
+            prev[i % WINDOW_SIZE] = head[h];
+            head[h] = i;
+        }
+
+        if (cnt == BLOCK_SYMBOLS) {
+            _writeBlock(stream, symbols, cnt, false);
+            cnt = 0;
+        }
+    }
+    _writeBlock(stream, symbols, cnt, true);
+    _flushBits(stream);
+
+    tvg::free(head);
+    tvg::free(prev);
+    tvg::free(symbols);
+
+    uint8_t adler[4];
+    _put32(adler, _adler32(in, size));
+    for (int k = 0; k < 4; ++k) _putByte(stream, adler[k]);
+}
+
+
+static uint8_t _paeth(int a, int b, int c)
+{
+    auto p = a + b - c;
+    auto pa = abs(p - a);
+    auto pb = abs(p - b);
+    auto pc = abs(p - c);
+    if (pa <= pb && pa <= pc) return (uint8_t)a;
+    if (pb <= pc) return (uint8_t)b;
+    return (uint8_t)c;
+}
+
+
+// filters a row by the given type, the prior row is null for the first row
+static uint32_t _filterRow(uint8_t* out, const uint8_t* row, const uint8_t* prior, uint32_t bytes, uint8_t type)
+{
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < bytes; ++i) {
+        int left = (i >= BPP) ? row[i - BPP] : 0;
+        int up = prior ? prior[i] : 0;
+        int upLeft = (prior && i >= BPP) ? prior[i - BPP] : 0;
+        uint8_t value = row[i];
+        switch (type) {
+            case 1: value -= left; break;
+            case 2: value -= up; break;
+            case 3: value -= (left + up) / 2; break;
+            case 4: value -= _paeth(left, up, upLeft); break;
+            default: break;
+        }
+        out[i] = value;
+        sum += (value < 128) ? value : (256 - value);
+    }
+    return sum;
+}
+
+
+// the scanlines of the region, each row takes the filter of the minimum sum of the absolute differences
+static uint32_t _filter(PngWriter* writer, const uint32_t* image, uint32_t x, uint32_t y, uint32_t w, uint32_t h)
+{
+    auto bytes = w * BPP;
+    auto out = writer->scanlines;
+    const uint8_t* prior = nullptr;
+
+    for (uint32_t yy = y; yy < y + h; ++yy) {
+        auto row = reinterpret_cast<const uint8_t*>(image + yy * writer->width + x);
+        uint32_t best = 0, bestSum = UINT32_MAX;
+        for (uint8_t type = 0; type < 5; ++type) {
+            auto sum = _filterRow(writer->filtered + type * bytes, row, prior, bytes, type);
+            if (sum < bestSum) {
+                bestSum = sum;
+                best = type;
+            }
+        }
+        *out++ = (uint8_t)best;
+        memcpy(out, writer->filtered + best * bytes, bytes);
+        out += bytes;
+        prior = row;
+    }
+    return h * (bytes + 1);
+}
+
+
+// the bounding box of the pixels changed from the previous frame, false if nothing is changed
+static bool _changed(const uint32_t* oldImage, const uint32_t* image, uint32_t width, uint32_t height, uint32_t& x, uint32_t& y, uint32_t& w, uint32_t& h)
+{
+    uint32_t x0 = width, x1 = 0, y0 = height, y1 = 0;
+
+    for (uint32_t yy = 0; yy < height; ++yy) {
+        auto prev = oldImage + yy * width;
+        auto cur = image + yy * width;
+        uint32_t left = 0;
+        while (left < width && prev[left] == cur[left]) ++left;
+        if (left == width) continue;
+        uint32_t right = width;
+        while (right > left && prev[right - 1] == cur[right - 1]) --right;
+        if (left < x0) x0 = left;
+        if (right > x1) x1 = right;
+        if (yy < y0) y0 = yy;
+        y1 = yy + 1;
+    }
+
+    if (y0 >= y1) return false;
+
+    x = x0;
+    y = y0;
+    w = x1 - x0;
+    h = y1 - y0;
+    return true;
+}
+
+
+static bool _writeChunk(FILE* f, const char* type, const uint8_t* data, uint32_t size)
+{
+    uint8_t buf[4];
+    _put32(buf, size);
+    if (fwrite(buf, 1, 4, f) != 4) return false;
+    if (fwrite(type, 1, 4, f) != 4) return false;
+    if (size > 0 && fwrite(data, 1, size, f) != size) return false;
+    auto crc = _crc(0xffffffff, reinterpret_cast<const uint8_t*>(type), 4);
+    _put32(buf, _crc(crc, data, size) ^ 0xffffffff);
+    return fwrite(buf, 1, 4, f) == 4;
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+bool pngBegin(PngWriter* writer, const char* filename, uint32_t width, uint32_t height, uint32_t frameCnt)
+{
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+    writer->f = 0;
+    fopen_s(&writer->f, filename, "wb");
+#else
+    writer->f = fopen(filename, "wb");
+#endif
+    if (!writer->f) return false;
+
+    writer->width = width;
+    writer->height = height;
+    writer->sequence = 0;
+    writer->animation = frameCnt > 0;
+    writer->frames = writer->animation ? frameCnt : 1;
+    writer->firstFrame = true;
+
+    // allocate
+    writer->oldImage = tvg::malloc<uint32_t*>(sizeof(uint32_t) * width * height);
+    writer->scanlines = tvg::malloc<uint8_t*>((width * BPP + 1) * height);
+    writer->filtered = tvg::malloc<uint8_t*>(width * BPP * 5);
+
+    static const uint8_t signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+    fwrite(signature, 1, 8, writer->f);
+
+    uint8_t header[13];
+    _put32(header, width);
+    _put32(header + 4, height);
+    header[8] = 8;   // bit depth
+    header[9] = 6;   // rgba
+    header[10] = 0;  // deflate
+    header[11] = 0;  // adaptive filtering
+    header[12] = 0;  // no interlace
+    _writeChunk(writer->f, "IHDR", header, 13);
+
+    if (writer->animation) {
+        uint8_t control[8];
+        _put32(control, frameCnt);
+        _put32(control + 4, 0);  // loop infinitely
+        _writeChunk(writer->f, "acTL", control, 8);
+    }
+
+    return true;
+}
+
+
+bool pngWriteFrame(PngWriter* writer, const uint32_t* image, uint16_t delayNum, uint16_t delayDen)
+{
+    if (!writer->f || writer->frames == 0) return false;
+
+    // the first frame is the default image, the others keep the unchanged pixels of the previous frame
+    uint32_t x = 0, y = 0, w = writer->width, h = writer->height;
+    if (!writer->firstFrame && !_changed(writer->oldImage, image, writer->width, writer->height, x, y, w, h)) {
+        // a frame needs at least one pixel, same with the previous one
+        w = h = 1;
+    }
+    memcpy(writer->oldImage, image, sizeof(uint32_t) * writer->width * writer->height);
+
+    if (writer->animation) {
+        uint8_t control[26];
+        _put32(control, writer->sequence++);
+        _put32(control + 4, w);
+        _put32(control + 8, h);
+        _put32(control + 12, x);
+        _put32(control + 16, y);
+        control[20] = (delayNum >> 8) & 0xff;
+        control[21] = delayNum & 0xff;
+        control[22] = (delayDen >> 8) & 0xff;
+        control[23] = delayDen & 0xff;
+        control[24] = 0;  // dispose: none
+        control[25] = 0;  // blend: source, the region replaces the pixels
+        _writeChunk(writer->f, "fcTL", control, 26);
+    }
+
+    auto size = _filter(writer, image, x, y, w, h);
+
+    PngStream stream = {nullptr, 0, 0, 0, 0};
+    _grow(&stream, size / 2 + 64);
+
+    // the frame data chunks lead with the sequence number
+    if (!writer->firstFrame) {
+        _grow(&stream, 4);
+        _put32(stream.data, writer->sequence++);
+        stream.size = 4;
+    }
+
+    _compress(&stream, writer->scanlines, size);
+
+    auto ret = _writeChunk(writer->f, writer->firstFrame ? "IDAT" : "fdAT", stream.data, stream.size);
+    tvg::free(stream.data);
+
+    writer->firstFrame = false;
+    if (ret) --writer->frames;
+
+    return ret;
+}
+
+
+bool pngEnd(PngWriter* writer)
+{
+    if (!writer->f) return false;
+
+    _writeChunk(writer->f, "IEND", nullptr, 0);
+    fclose(writer->f);
+    tvg::free(writer->oldImage);
+    tvg::free(writer->scanlines);
+    tvg::free(writer->filtered);
+
+    writer->f = NULL;
+    writer->oldImage = NULL;
+
+    // the image is broken if it has less frames than the acTL says
+    return writer->frames == 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_PNG_ENCODER_H_
+#define _TVG_PNG_ENCODER_H_
+
+#include "tvgCommon.h"
+
+typedef struct
+{
+    FILE* f;
+    uint32_t* oldImage;     // the previous frame to find the changed region
+    uint8_t* scanlines;     // the filtered rows of the region to compress
+    uint8_t* filtered;      // a row filtered by each filter type
+    uint32_t width;
+    uint32_t height;
+    uint32_t sequence;      // the sequence number of the animation chunks
+    uint32_t frames;        // the frames yet to be written
+    bool animation;
+    bool firstFrame;
+} PngWriter;
+
+
+// Creates a png file of the RGBA8 pixels.
+// With frameCnt > 0, it's an animated png (APNG) which must receive exactly frameCnt frames. Otherwise, a single image is expected.
+bool pngBegin(PngWriter* writer, const char* filename, uint32_t width, uint32_t height, uint32_t frameCnt);
+
+// Writes out a new frame. The image is RGBA8 in byte order, non-premultiplied, width x height pixels.
+// Only the changed region from the previous frame is stored.
+// The delay is delayNum / delayDen seconds, which is ignored for a single image.
+bool pngWriteFrame(PngWriter* writer, const uint32_t* image, uint16_t delayNum, uint16_t delayDen);
+
+// Writes the end chunk, closes the file handle, and frees temp memory used by a png.
+// Returns false if the png has received less frames than expected, the file is broken then.
+bool pngEnd(PngWriter* writer);
+
+#endif //_TVG_PNG_ENCODER_H_
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstring>
+#include <memory>
+#include "tvgStr.h"
+#include "tvgPngEncoder.h"
+#include "tvgPngSaver.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+void PngSaver::run(unsigned tid)
+{
+    auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+    if (!canvas) return;
+
+    auto w = static_cast<uint32_t>(vsize[0]);
+    auto h = static_cast<uint32_t>(vsize[1]);
+
+    //png keeps the straight alpha
+    buffer = tvg::realloc<uint32_t*>(buffer, sizeof(uint32_t) * w * h);
+    canvas->target(buffer, w, w, h, ColorSpace::ABGR8888S);
+    if (bg) canvas->push(bg);   //the canvas holds its own reference, released in close()
+
+    PngWriter writer;
+
+    //a still image
+    if (paint) {
+        canvas->push(paint);
+        if (!pngBegin(&writer, path, w, h, 0)) {
+            TVGERR("PNG_SAVER", "Failed png encoding");
+            return;
+        }
+        canvas->update();
+        if (canvas->draw(true) == tvg::Result::Success) {
+            canvas->sync();
+        }
+        pngWriteFrame(&writer, buffer, 0, 0);
+        if (!pngEnd(&writer)) {
+            TVGERR("PNG_SAVER", "Failed png encoding");
+            remove(path);
+        }
+        return;
+    }
+
+    canvas->push(animation->picture());
+
+    //use the default fps
+    if (fps > 60.0f) fps = 60.0f;   // just in case
+    else if (tvg::zero(fps) || fps < 0.0f) {
+        fps = (animation->totalFrame() / animation->duration());
+    }
+
+    auto delay = (1.0f / fps);
+    auto duration = animation->duration();
+
+    uint32_t frameCnt = 0;
+    for (auto p = 0.0f; p < duration; p += delay) ++frameCnt;
+
+    if (!pngBegin(&writer, path, w, h, frameCnt)) {
+        TVGERR("PNG_SAVER", "Failed png encoding");
+        return;
+    }
+
+    //in milliseconds
+    auto delayNum = static_cast<uint16_t>(delay * 1000.0f + 0.5f);
+
+    for (auto p = 0.0f; p < duration; p += delay) {
+        auto frameNo = animation->totalFrame() * (p / duration);
+        animation->frame(frameNo);
+        canvas->update();
+        if (canvas->draw(true) == tvg::Result::Success) {
+            canvas->sync();
+        }
+        if (!pngWriteFrame(&writer, buffer, delayNum, 1000)) break;
+    }
+
+    //the frames written must match the acTL, don't leave a broken file
+    if (!pngEnd(&writer)) {
+        TVGERR("PNG_SAVER", "Failed png encoding");
+        remove(path);
+    }
+}
+
+
+bool PngSaver::prepare(Paint* paint, Paint* bg, const char* filename)
+{
+    float x, y;
+    x = y = 0;
+    paint->bounds(&x, &y, &vsize[0], &vsize[1]);
+
+    //cut off the negative space
+    if (x < 0) vsize[0] += x;
+    if (y < 0) vsize[1] += y;
+
+    if (vsize[0] < FLOAT_EPSILON || vsize[1] < FLOAT_EPSILON) {
+        TVGLOG("PNG_SAVER", "Saving paint(%p) has zero view size.", paint);
+        return false;
+    }
+
+    if (!filename) return false;
+    this->path = duplicate(filename);
+
+    if (bg) {
+        bg->ref();
+        this->bg = bg;
+    }
+
+    return true;
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+PngSaver::~PngSaver()
+{
+    close();
+}
+
+
+bool PngSaver::close()
+{
+    this->done();
+
+    if (bg) bg->unref();
+    bg = nullptr;
+
+    if (paint) paint->unref();
+    paint = nullptr;
+
+    //animation holds the picture, it must be 1 at the bottom.
+    if (animation && animation->picture()->refCnt() <= 1) delete(animation);
+    animation = nullptr;
+
+    tvg::free(path);
+    path = nullptr;
+
+    tvg::free(buffer);
+    buffer = nullptr;
+
+    return true;
+}
+
+
+bool PngSaver::save(Paint* paint, Paint* bg, const char* filename, TVG_UNUSED uint32_t quality)
+{
+    close();
+
+    if (!prepare(paint, bg, filename)) return false;
+
+    paint->ref();
+    this->paint = paint;
+
+    TaskScheduler::request(this);
+
+    return true;
+}
+
+
+bool PngSaver::save(Animation* animation, Paint* bg, const char* filename, TVG_UNUSED uint32_t quality, uint32_t fps)
+{
+    close();
+
+    if (!prepare(animation->picture(), bg, filename)) return false;
+
+    this->animation = animation;
+    this->fps = static_cast<float>(fps);
+
+    TaskScheduler::request(this);
+
+    return true;
+}
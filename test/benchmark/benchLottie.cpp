@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <thorvg.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace tvg;
+using namespace std;
+
+static constexpr uint32_t GROUPS = 256;     //keyframed groups in the layer
+static constexpr uint32_t REPEATS = 8;      //plays of the whole frames, the best one is taken
+
+
+//a shape layer of the rectangles, every group moves and fades along its own keyframes
+static string _generate(uint32_t keys)
+{
+    char buf[256];
+    string json = "{\"v\":\"5.7.0\",\"fr\":60,\"ip\":0,\"op\":" + to_string(keys) + ",\"w\":512,\"h\":512,\"layers\":[{\"ty\":4,\"ind\":1,\"ip\":0,\"op\":" + to_string(keys) + ",\"st\":0,\"ks\":{},\"shapes\":[";
+
+    for (uint32_t g = 0; g < GROUPS; ++g) {
+        if (g > 0) json += ",";
+        json += "{\"ty\":\"gr\",\"it\":[{\"ty\":\"rc\",\"p\":{\"a\":0,\"k\":[0,0]},\"s\":{\"a\":0,\"k\":[8,8]},\"r\":{\"a\":0,\"k\":0}},";
+        json += "{\"ty\":\"fl\",\"c\":{\"a\":0,\"k\":[1,0,0,1]},\"o\":{\"a\":1,\"k\":[";
+        for (uint32_t k = 0; k < keys; ++k) {
+            snprintf(buf, sizeof(buf), "%s{\"t\":%u,\"s\":[%u],\"i\":{\"x\":[0.5],\"y\":[0.5]},\"o\":{\"x\":[0.5],\"y\":[0.5]}}", k > 0 ? "," : "", k, (g + k * 7) % 101);
+            json += buf;
+        }
+        json += "]}},{\"ty\":\"tr\",\"p\":{\"a\":1,\"k\":[";
+        for (uint32_t k = 0; k < keys; ++k) {
+            snprintf(buf, sizeof(buf), "%s{\"t\":%u,\"s\":[%u,%u],\"i\":{\"x\":0.5,\"y\":0.5},\"o\":{\"x\":0.5,\"y\":0.5}}", k > 0 ? "," : "", k, (g * 13 + k * 5) % 512, (g * 7 + k * 11) % 512);
+            json += buf;
+        }
+        json += "]},\"a\":{\"a\":0,\"k\":[0,0]},\"s\":{\"a\":0,\"k\":[100,100]},\"r\":{\"a\":0,\"k\":0},\"o\":{\"a\":0,\"k\":100}}]}";
+    }
+    json += "]}]}";
+    return json;
+}
+
+
+//microseconds per frame
+static double _play(Animation* animation, const float* frames, uint32_t cnt)
+{
+    auto best = 0.0;
+    for (uint32_t r = 0; r < REPEATS; ++r) {
+        auto begin = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < cnt; ++i) animation->frame(frames[i]);
+        auto elapsed = chrono::duration<double, micro>(chrono::steady_clock::now() - begin).count() / double(cnt);
+        if (r == 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+
+int main()
+{
+    //no worker threads, the frames are built on the calling thread
+    if (Initializer::init(0) != Result::Success) return 1;
+
+    printf("Lottie forward playback, %u keyframed groups (2 properties each), 0.25 frame steps\n", GROUPS);
+    printf("%8s %16s %16s\n", "keys", "forward(us/f)", "random(us/f)");
+
+    for (uint32_t keys : {4u, 16u, 64u, 256u}) {
+        auto json = _generate(keys);
+        auto animation = Animation::gen();
+        if (animation->picture()->load(json.c_str(), json.size(), "lot", nullptr, true) != Result::Success) {
+            printf("failed to load the generated animation\n");
+            delete(animation);
+            return 1;
+        }
+
+        //the same frames in the playback order and in a shuffled order to defeat the keyframe cursors
+        auto cnt = uint32_t(animation->totalFrame() * 4.0f);
+        auto forward = new float[cnt];
+        auto random = new float[cnt];
+        for (uint32_t i = 0; i < cnt; ++i) forward[i] = random[i] = float(i) * 0.25f;
+        uint32_t seed = 1;
+        for (uint32_t i = cnt - 1; i > 0; --i) {
+            seed = seed * 1103515245 + 12345;
+            auto j = (seed >> 8) % (i + 1);
+            auto t = random[i];
+            random[i] = random[j];
+            random[j] = t;
+        }
+
+        _play(animation, forward, cnt);   //warm up
+        auto f = _play(animation, forward, cnt);
+        auto r = _play(animation, random, cnt);
+        printf("%8u %16.2f %16.2f\n", keys, f, r);
+
+        delete[](forward);
+        delete[](random);
+        delete(animation);
+    }
+
+    Initializer::term();
+
+    return 0;
+}
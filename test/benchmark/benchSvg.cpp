@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <thorvg.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace tvg;
+using namespace std;
+
+static constexpr uint32_t USES = 10000;     //<use> elements of the sheet
+static constexpr uint32_t SPRITES = 200;    //symbols, gradients and clip paths each
+static constexpr uint32_t PASSES = 5;       //the best one is taken
+
+
+//a sprite sheet, the uses refer to the symbols and the clip paths, the symbols refer to the gradients
+static string _generate()
+{
+    char buf[512];
+    string svg = "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\" width=\"1000\" height=\"1000\" viewBox=\"0 0 1000 1000\"><defs>";
+
+    for (uint32_t i = 0; i < SPRITES; ++i) {
+        snprintf(buf, sizeof(buf), "<linearGradient id=\"g%u\"><stop offset=\"0\" stop-color=\"#%02x0000\"/><stop offset=\"1\" stop-color=\"#00%02xff\"/></linearGradient>", i, i % 256, i % 256);
+        svg += buf;
+        snprintf(buf, sizeof(buf), "<clipPath id=\"c%u\"><rect x=\"0\" y=\"0\" width=\"8\" height=\"8\"/></clipPath>", i);
+        svg += buf;
+        snprintf(buf, sizeof(buf), "<symbol id=\"s%u\" viewBox=\"0 0 10 10\"><path d=\"M0 0L10 0L10 10Z\" fill=\"url(#g%u)\"/><circle cx=\"5\" cy=\"5\" r=\"%u\"/></symbol>", i, i, 1 + i % 4);
+        svg += buf;
+    }
+    svg += "</defs>";
+
+    for (uint32_t i = 0; i < USES; ++i) {
+        snprintf(buf, sizeof(buf), "<use xlink:href=\"#s%u\" x=\"%u\" y=\"%u\" width=\"10\" height=\"10\" clip-path=\"url(#c%u)\"/>", i % SPRITES, (i % 100) * 10, (i / 100) * 10, (i * 7) % SPRITES);
+        svg += buf;
+    }
+    svg += "</svg>";
+    return svg;
+}
+
+
+int main()
+{
+    if (Initializer::init(0) != Result::Success) return 1;
+
+    auto svg = _generate();
+    auto best = 0.0;
+
+    for (uint32_t p = 0; p < PASSES; ++p) {
+        auto begin = chrono::steady_clock::now();
+
+        auto picture = Picture::gen();
+        if (picture->load(svg.c_str(), svg.size(), "svg") != Result::Success) {
+            printf("failed to load the generated sprite sheet\n");
+            delete(picture);
+            return 1;
+        }
+        float w, h;
+        picture->size(&w, &h);   //waits for the loading done
+
+        auto elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+        if (p == 0 || elapsed < best) best = elapsed;
+        delete(picture);
+    }
+
+    printf("SVG sprite sheet, %u uses of %u symbols (%u bytes), best of %u passes\n", USES, SPRITES, uint32_t(svg.size()), PASSES);
+    printf("load: %.2f ms\n", best);
+
+    Initializer::term();
+
+    return 0;
+}
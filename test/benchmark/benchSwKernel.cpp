@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "tvgSwCommon.h"
+
+using namespace std;
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    void kernelSse41(SwKernels& kernels);
+#endif
+
+static constexpr uint32_t SPAN = 1024;      //pixels per span
+static constexpr uint32_t SPANS = 20000;    //spans per pass
+static constexpr uint32_t PASSES = 5;       //the best one is taken
+
+static uint32_t ctable[GRADIENT_STOP_SIZE];
+static uint32_t dst[SPAN];
+
+
+//milliseconds per pass
+template<typename Func>
+static double _measure(Func func)
+{
+    auto best = 0.0;
+    for (uint32_t p = 0; p < PASSES; ++p) {
+        auto begin = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < SPANS; ++i) func(i);
+        auto elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+        if (p == 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+
+static void _run(const SwKernels& kernels)
+{
+    static const char* spreads[] = {"pad", "reflect", "repeat"};
+
+    for (int s = 0; s < 3; ++s) {
+        auto linear = kernels.linear[s];
+        auto l = _measure([&](uint32_t i) {
+            linear(ctable, dst, int32_t(i % 64) * FIXPT_SIZE, 3 * FIXPT_SIZE / 2, SPAN);
+        });
+
+        auto radial = kernels.radial[s];
+        auto r = _measure([&](uint32_t i) {
+            auto b = 0.0f, det = 0.04f + float(i % 64) * 0.001f, deltaDet = 0.0004f;
+            radial(ctable, dst, b, -0.0002f, det, deltaDet, 0.000002f, SPAN);
+        });
+
+        printf("%8s %8s %12.2f %12.2f\n", kernels.name, spreads[s], l, r);
+    }
+}
+
+
+int main()
+{
+    for (uint32_t i = 0; i < GRADIENT_STOP_SIZE; ++i) ctable[i] = 0xff000000 | (i * 0x010203);
+
+    //the default table is the C one, the engine overrides it by the cpu features
+    auto c = swKernels;
+    kernelInit();
+
+    printf("Gradient spans, %u x %u pixels per pass, best of %u passes\n", SPANS, SPAN, PASSES);
+    printf("%8s %8s %12s %12s\n", "kernels", "spread", "linear(ms)", "radial(ms)");
+
+    _run(c);
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    //avx2 implies sse4.1
+    if (!strcmp(swKernels.name, "AVX2")) {
+        auto sse = c;
+        kernelSse41(sse);
+        _run(sse);
+    }
+#endif
+    if (strcmp(swKernels.name, c.name)) _run(swKernels);
+
+    return 0;
+}
@@ -325,4 +325,177 @@ TEST_CASE("Animation Segment", "[tvgAnimation]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Animation Cache", "[tvgAnimation]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        auto animation = unique_ptr<Animation>(Animation::gen());
+        REQUIRE(animation);
+
+        auto picture = animation->picture();
+
+        //Cache before loaded
+        REQUIRE(animation->cache(1024 * 1024) == Result::InsufficientCondition);
+
+        REQUIRE(picture->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(picture->size(100, 100) == Result::Success);
+
+        REQUIRE(animation->cache(1024 * 1024) == Result::Success);
+        REQUIRE(animation->cache(64 * 1024) == Result::Success);
+
+#ifdef THORVG_SW_RASTER_SUPPORT
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100 * 100];
+        uint32_t live[3][100 * 100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        //Replay the frames drawn previously
+        for (int loop = 0; loop < 2; ++loop) {
+            for (int i = 0; i < 3; ++i) {
+                REQUIRE(animation->frame(10.0f + i * 30.0f) == Result::Success);
+                REQUIRE(animation->curFrame() == Approx(10.0f + i * 30.0f));
+                REQUIRE(canvas->update() == Result::Success);
+                REQUIRE(canvas->draw(true) == Result::Success);
+                REQUIRE(canvas->sync() == Result::Success);
+                if (loop == 0) memcpy(live[i], buffer, sizeof(buffer));
+                else REQUIRE(memcmp(live[i], buffer, sizeof(buffer)) == 0);
+            }
+        }
+
+        //Invalidated by the transformation
+        REQUIRE(picture->translate(1, 1) == Result::Success);
+        REQUIRE(animation->frame(40.0f) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(memcmp(live[1], buffer, sizeof(buffer)) != 0);
+#endif
+
+        //Disable
+        REQUIRE(animation->cache(0) == Result::Success);
+        REQUIRE(animation->frame(70.0f) == Result::Success);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#ifdef THORVG_SW_RASTER_SUPPORT
+
+TEST_CASE("Animation Cache Eviction", "[tvgAnimation]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        auto animation = unique_ptr<Animation>(Animation::gen());
+        REQUIRE(animation);
+
+        auto picture = animation->picture();
+        REQUIRE(picture->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(picture->size(100, 100) == Result::Success);
+
+        //Not enough for the three frames, the first one is evicted
+        REQUIRE(animation->cache(24 * 1024) == Result::Success);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100 * 100];
+        uint32_t live[3][100 * 100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        float frames[] = {10.0f, 40.0f, 70.0f};
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(animation->frame(frames[i]) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+            memcpy(live[i], buffer, sizeof(buffer));
+        }
+
+        //Touch the retained ones after the eviction, then the evicted one
+        int order[] = {1, 2, 0, 1};
+        for (auto i : order) {
+            REQUIRE(animation->frame(frames[i]) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+            REQUIRE(memcmp(live[i], buffer, sizeof(buffer)) == 0);
+        }
+
+        //Shrink the budget
+        REQUIRE(animation->cache(4 * 1024) == Result::Success);
+        REQUIRE(animation->frame(frames[0]) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(memcmp(live[0], buffer, sizeof(buffer)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Animation Batch Rendering", "[tvgAnimation]")
+{
+    static constexpr uint32_t SIZE = 100;
+    static constexpr uint32_t FRAMES = 5;
+    static uint32_t buffer[SIZE * SIZE];
+    static uint32_t live[FRAMES][SIZE * SIZE];
+    static uint32_t batch[FRAMES][SIZE * SIZE];
+    uint32_t* buffers[FRAMES];
+    for (uint32_t i = 0; i < FRAMES; ++i) buffers[i] = batch[i];
+    float frames[FRAMES] = {60.0f, 10.0f, 10.0f, 33.3f, 0.0f};
+
+    for (uint32_t threads = 0; threads < 3; threads += 2) {
+        REQUIRE(Initializer::init(threads) == Result::Success);
+        {
+            auto animation = unique_ptr<Animation>(Animation::gen());
+            REQUIRE(animation);
+
+            //Negative cases
+            REQUIRE(animation->render(frames, buffers, FRAMES, SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::InsufficientCondition);
+
+            auto picture = animation->picture();
+            REQUIRE(picture->load(TEST_DIR"/test.json") == Result::Success);
+            REQUIRE(picture->size(SIZE, SIZE) == Result::Success);
+
+            REQUIRE(animation->render(nullptr, buffers, FRAMES, SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::InvalidArguments);
+            REQUIRE(animation->render(frames, nullptr, FRAMES, SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::InvalidArguments);
+            REQUIRE(animation->render(frames, buffers, 0, SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::InvalidArguments);
+            REQUIRE(animation->render(frames, buffers, FRAMES, SIZE - 1, SIZE, SIZE, ColorSpace::ARGB8888) == Result::InvalidArguments);
+
+            //Same with the frames drawn one by one, in the given order
+            REQUIRE(animation->frame(20.0f) == Result::Success);
+            REQUIRE(animation->render(frames, buffers, FRAMES, SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(animation->curFrame() == 20.0f);
+
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer, SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas->push(picture) == Result::Success);
+
+            for (uint32_t i = 0; i < FRAMES; ++i) {
+                animation->frame(frames[i]);
+                REQUIRE(canvas->update() == Result::Success);
+                REQUIRE(canvas->draw(true) == Result::Success);
+                REQUIRE(canvas->sync() == Result::Success);
+                memcpy(live[i], buffer, sizeof(buffer));
+                REQUIRE(!memcmp(live[i], batch[i], sizeof(buffer)));
+            }
+            REQUIRE(memcmp(live[0], live[1], sizeof(buffer)));
+
+            REQUIRE(canvas->remove() == Result::Success);
+
+            //A failed frame is reported, the others are still rendered
+            memset(batch, 0, sizeof(batch));
+            buffers[2] = nullptr;
+            REQUIRE(animation->render(frames, buffers, FRAMES, SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::InvalidArguments);
+            buffers[2] = batch[2];
+            REQUIRE(!memcmp(live[0], batch[0], sizeof(buffer)));
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+}
+
+#endif
+
 #endif
\ No newline at end of file
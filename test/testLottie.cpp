@@ -129,4 +129,233 @@ TEST_CASE("Lottie Marker", "[tvgLottie]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
-#endif
\ No newline at end of file
+TEST_CASE("Lottie Statistics", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation);
+
+        uint32_t invariant = 0, animated = 0;
+
+        //Negative cases
+        REQUIRE(animation->stats(&invariant, &animated) == Result::InsufficientCondition);
+        REQUIRE(animation->picture()->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(animation->stats(nullptr, nullptr) == Result::InvalidArguments);
+
+        REQUIRE(animation->stats(&invariant, &animated) == Result::Success);
+        REQUIRE(invariant > 0);
+        REQUIRE(animated > 0);
+
+        uint32_t animated2 = 0;
+        REQUIRE(animation->stats(nullptr, &animated2) == Result::Success);
+        REQUIRE(animated2 == animated);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Sharing", "[tvgLottie]")
+{
+    for (uint32_t threads = 0; threads < 3; threads += 2) {
+        REQUIRE(Initializer::init(threads) == Result::Success);
+        {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas);
+
+            uint32_t buffer[100*100];
+            REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+            //The instances of the same source share the composition
+            auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            auto animation2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            auto animation3 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            REQUIRE(animation->picture()->load(TEST_DIR"/lottiemarker.json") == Result::Success);
+            REQUIRE(animation2->picture()->load(TEST_DIR"/lottiemarker.json") == Result::Success);
+            REQUIRE(animation3->picture()->load(TEST_DIR"/lottiemarker.json") == Result::Success);
+
+            REQUIRE(animation->totalFrame() == animation2->totalFrame());
+            REQUIRE(animation2->markersCnt() == 3);
+
+            REQUIRE(canvas->push(animation->picture()) == Result::Success);
+            REQUIRE(canvas->push(animation2->picture()) == Result::Success);
+            REQUIRE(canvas->push(animation3->picture()) == Result::Success);
+
+            //Each instance keeps its own frame
+            REQUIRE(animation->frame(10) == Result::Success);
+            REQUIRE(animation2->frame(20) == Result::Success);
+            REQUIRE(animation3->segment("sectionB") == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw() == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            //Release the first one while the others are alive
+            REQUIRE(canvas->remove(animation->picture()) == Result::Success);
+            animation.reset();
+
+            REQUIRE(animation2->frame(30) == Result::Success);
+            REQUIRE(animation3->frame(40) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw() == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            //The slots are overridden per instance
+            auto slot = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            auto slot2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            REQUIRE(slot->picture()->load(TEST_DIR"/lottieslot.json") == Result::Success);
+            REQUIRE(slot2->picture()->load(TEST_DIR"/lottieslot.json") == Result::Success);
+            REQUIRE(slot->override(R"({"gradient_fill":{"p":{"p":2,"k":{"a":0,"k":[0,0.1,0.1,0.2,1,1,0.1,0.2,0.1,1]}}}})") == Result::Success);
+            REQUIRE(slot2->override(nullptr) == Result::Success);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+}
+
+TEST_CASE("Lottie Binary", "[tvgLottie]")
+{
+    for (uint32_t threads = 0; threads < 3; threads += 2) {
+        REQUIRE(Initializer::init(threads) == Result::Success);
+        {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas);
+
+            uint32_t buffer[100*100];
+            REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+            //The precompiled one is equivalent to the json origin
+            auto json = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            auto binary = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            REQUIRE(json->picture()->load(TEST_DIR"/lottieslot.json") == Result::Success);
+            REQUIRE(binary->picture()->load(TEST_DIR"/lottieslot.lotb") == Result::Success);
+
+            float w, h, w2, h2;
+            REQUIRE(json->picture()->size(&w, &h) == Result::Success);
+            REQUIRE(binary->picture()->size(&w2, &h2) == Result::Success);
+            REQUIRE(w == w2);
+            REQUIRE(h == h2);
+            REQUIRE(json->totalFrame() == binary->totalFrame());
+            REQUIRE(json->duration() == binary->duration());
+
+            REQUIRE(json->markersCnt() == binary->markersCnt());
+            REQUIRE(binary->override(R"({"gradient_fill":{"p":{"p":2,"k":{"a":0,"k":[0,0.1,0.1,0.2,1,1,0.1,0.2,0.1,1]}}}})") == Result::Success);
+
+            REQUIRE(canvas->push(binary->picture()) == Result::Success);
+            REQUIRE(binary->frame(binary->totalFrame() * 0.5f) == Result::Success);
+            REQUIRE(canvas->draw() == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            //Load from memory
+            ifstream file(TEST_DIR"/lottieslot.lotb", ios::in | ios::binary);
+            REQUIRE(file.is_open());
+            file.seekg(0, std::ios::end);
+            auto size = file.tellg();
+            file.seekg(0, std::ios::beg);
+            auto data = (char*)malloc(size);
+            REQUIRE(data);
+            file.read(data, size);
+            file.close();
+
+            auto memory = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            REQUIRE(memory->picture()->load(data, size, "lot", nullptr, true) == Result::Success);
+            REQUIRE(memory->totalFrame() == binary->totalFrame());
+
+            //Truncated binary
+            auto corrupted = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            REQUIRE(corrupted->picture()->load(data, uint32_t(size) - 1, "lot", nullptr, true) != Result::Success);
+
+            free(data);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+}
+
+TEST_CASE("Lottie Seeking", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        uint32_t buffer[100*100], buffer2[100*100];
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto animation = Animation::gen();
+        REQUIRE(animation->picture()->load(TEST_DIR"/lottiemarker.json") == Result::Success);
+        REQUIRE(animation->picture()->size(100, 100) == Result::Success);
+        REQUIRE(canvas->push(animation->picture()) == Result::Success);
+
+        //The reference is loaded from a copied data, so that it doesn't share the composition
+        ifstream file(TEST_DIR"/lottiemarker.json", ios::in | ios::binary);
+        REQUIRE(file.is_open());
+        file.seekg(0, std::ios::end);
+        auto size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        auto data = (char*)malloc(size);
+        REQUIRE(data);
+        file.read(data, size);
+        file.close();
+
+        //Play forward, then seek backward and forward. The same frame must be identical regardless of the history
+        auto total = animation->totalFrame();
+        float frames[] = {0.0f, 1.5f, 2.0f, 2.5f, total * 0.5f, total * 0.5f + 0.5f, total - 1.0f, 1.0f, total * 0.25f, total * 0.75f};
+
+        for (auto frameNo : frames) {
+            animation->frame(frameNo);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            auto fresh = Animation::gen();
+            REQUIRE(fresh->picture()->load(data, size, "lot", nullptr, true) == Result::Success);
+            REQUIRE(fresh->picture()->size(100, 100) == Result::Success);
+            fresh->frame(frameNo);
+            REQUIRE(canvas2->push(fresh->picture()) == Result::Success);
+            REQUIRE(canvas2->draw(true) == Result::Success);
+            REQUIRE(canvas2->sync() == Result::Success);
+            REQUIRE(canvas2->remove() == Result::Success);
+            delete(fresh);
+
+            REQUIRE(!memcmp(buffer, buffer2, sizeof(buffer)));
+        }
+        REQUIRE(canvas->remove() == Result::Success);
+        delete(animation);
+        free(data);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Parallel Building", "[tvgLottie]")
+{
+    static constexpr uint32_t SIZE = 200;
+    static constexpr uint32_t FRAMES = 4;
+    static uint32_t buffer[SIZE * SIZE];
+    static uint32_t refs[FRAMES][SIZE * SIZE];
+    float frames[FRAMES] = {10.0f, 25.5f, 60.0f, 5.0f};
+
+    //The layers built by the workers must be composed identically with the serial building
+    for (uint32_t threads = 0; threads < 4; threads += 3) {
+        REQUIRE(Initializer::init(threads) == Result::Success);
+        {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer, SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::Success);
+
+            auto animation = unique_ptr<Animation>(Animation::gen());
+            REQUIRE(animation->picture()->load(TEST_DIR"/test2.json") == Result::Success);
+            REQUIRE(animation->picture()->size(SIZE, SIZE) == Result::Success);
+            REQUIRE(canvas->push(animation->picture()) == Result::Success);
+
+            for (uint32_t i = 0; i < FRAMES; ++i) {
+                REQUIRE(animation->frame(frames[i]) == Result::Success);
+                REQUIRE(canvas->update() == Result::Success);
+                REQUIRE(canvas->draw(true) == Result::Success);
+                REQUIRE(canvas->sync() == Result::Success);
+                if (threads == 0) memcpy(refs[i], buffer, sizeof(buffer));
+                else REQUIRE(!memcmp(refs[i], buffer, sizeof(buffer)));
+            }
+            REQUIRE(canvas->remove() == Result::Success);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+}
+
+#endif
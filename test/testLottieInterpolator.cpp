@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgMath.h"
+#include "tvgLottieInterpolator.h"
+#include "catch.hpp"
+
+using namespace tvg;
+
+//the documented error of the easing table against the solver, see tvgLottieInterpolator.h
+static constexpr float EASING_TABLE_ERROR = 2.3e-4f;
+
+TEST_CASE("Lottie Easing Table", "[tvgLottieInterpolator]")
+{
+    uint32_t seed = 1;
+    auto random = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return float((seed >> 8) & 0xffff) / 65535.0f;
+    };
+
+    auto maxError = 0.0f;
+
+    for (int i = 0; i < 1000; ++i) {
+        Point in = {random(), random()};
+        Point out = {random(), random()};
+
+        LottieInterpolator table, solver;
+        table.set(nullptr, in, out, false);
+        table.tabulate();
+        solver.set(nullptr, in, out, false);
+        REQUIRE(!solver.table);
+
+        auto linear = (out.x == out.y && in.x == in.y);
+        REQUIRE((table.table != nullptr) == !linear);
+        //the table samples and the midpoints between them, the ends and some in between
+        for (int s = 0; s <= (EASING_TABLE_SIZE - 1) * 8; ++s) {
+            auto t = float(s) / float((EASING_TABLE_SIZE - 1) * 8);
+            auto error = fabsf(table.progress(t) - solver.progress(t));
+            if (error > maxError) maxError = error;
+        }
+
+        tvg::free(table.table);
+    }
+
+    //the table is in use
+    REQUIRE(maxError > 0.0f);
+    REQUIRE(maxError <= EASING_TABLE_ERROR);
+}
@@ -227,6 +227,108 @@ TEST_CASE("Load SVG file and render", "[tvgPicture]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Load SVG file with the id references", "[tvgPicture]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100] = {0};
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto picture = Picture::gen();
+        REQUIRE(picture);
+        REQUIRE(picture->load(TEST_DIR"/svgid.svg") == Result::Success);
+
+        REQUIRE(canvas->push(picture) == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //forward reference
+        REQUIRE(buffer[10 * 100 + 10] == 0xff0000ff);
+
+        //duplicated ids, the earliest one wins
+        REQUIRE(buffer[35 * 100 + 5] == 0xffff0000);
+        REQUIRE(buffer[50 * 100 + 5] == 0xff00ff00);
+        REQUIRE(buffer[35 * 100 + 55] == 0xffff0000);
+        REQUIRE(buffer[50 * 100 + 55] == 0);
+
+        //the defs scope precedes the document scope
+        REQUIRE(buffer[75 * 100 + 5] == 0xffff0000);
+        REQUIRE(buffer[75 * 100 + 55] == 0);
+        REQUIRE(buffer[90 * 100 + 55] == 0xff00ff00);
+
+        //duplicated gradient ids
+        REQUIRE(buffer[10 * 100 + 90] == 0xff0000ff);
+
+        //forward clip-path reference
+        REQUIRE(buffer[40 * 100 + 85] == 0xff000000);
+        REQUIRE(buffer[40 * 100 + 95] == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Load SVG file with the use references", "[tvgPicture]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        auto buffer = new uint32_t[200*200]();
+        REQUIRE(canvas->target(buffer, 200, 200, 200, ColorSpace::ARGB8888) == Result::Success);
+
+        auto picture = Picture::gen();
+        REQUIRE(picture);
+        REQUIRE(picture->load(TEST_DIR"/svguse.svg") == Result::Success);
+
+        REQUIRE(canvas->push(picture) == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //the instances sharing the path data draw the same
+        auto drawn = 0;
+        auto same = true;
+        auto nested = true;
+        for (int y = 0; y < 60; ++y) {
+            for (int x = 0; x < 70; ++x) {
+                if (buffer[y * 200 + x]) ++drawn;
+                if (buffer[y * 200 + x] != buffer[(y + 100) * 200 + x]) same = false;
+                if (x >= 5 && buffer[y * 200 + x] != buffer[y * 200 + x + 105]) nested = false;
+            }
+        }
+        REQUIRE(drawn > 0);
+        REQUIRE(same);
+        REQUIRE(nested);
+        REQUIRE(buffer[20 * 200 + 25] == 0xffff0000);
+        REQUIRE(buffer[5 * 200 + 105] == 0xff00ff00);
+
+        //symbol
+        REQUIRE(buffer[70 * 200 + 20] == 0xffffa500);
+
+        //use inside a clip path
+        REQUIRE(buffer[120 * 200 + 125] == 0xff800080);
+        REQUIRE(buffer[102 * 200 + 102] == 0);
+        REQUIRE(buffer[145 * 200 + 145] == 0);
+
+        //invalid path
+        auto invalid = 0;
+        for (int y = 160; y < 200; ++y) {
+            for (int x = 100; x < 160; ++x) {
+                if (buffer[y * 200 + x]) ++invalid;
+            }
+        }
+        REQUIRE(invalid == 0);
+
+        //forward reference with the inherited fill
+        REQUIRE(buffer[165 * 200 + 175] == 0xff008080);
+
+        delete[] buffer;
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 #endif
 
 #ifdef THORVG_PNG_LOADER_SUPPORT
@@ -294,6 +396,77 @@ TEST_CASE("Load PNG file and render", "[tvgPicture]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+//the straight pixels of alpha.png: every filter type and the alphas from 0 to 255
+static void _alphaPixel(uint32_t x, uint32_t y, uint8_t rgba[4])
+{
+    static const uint8_t alphas[] = {0, 32, 64, 128, 200, 255, 1, 254};
+    rgba[0] = (x * 37 + y * 11) % 256;
+    rgba[1] = (x * 91 + y * 53 + 7) % 256;
+    rgba[2] = (255 - x * 29 - y * 17) % 256;
+    rgba[3] = alphas[(x + y) % 8];
+}
+
+//the straight pixels of alphapalette.png: a palette with the partial transparencies
+static void _alphaPalettePixel(uint32_t x, uint32_t y, uint8_t rgba[4])
+{
+    static const uint8_t palette[][4] = {{255, 0, 0, 255}, {0, 255, 0, 128}, {0, 0, 255, 64}, {255, 255, 255, 0}, {90, 160, 220, 200}};
+    memcpy(rgba, palette[(x + y) % 5], 4);
+}
+
+TEST_CASE("Load PNG file with alpha and render", "[tvgPicture]")
+{
+    static constexpr uint32_t W = 8;
+    static constexpr uint32_t H = 5;
+
+    struct {
+        const char* path;
+        void (*pixel)(uint32_t, uint32_t, uint8_t*);
+    } images[] = {{TEST_DIR"/alpha.png", _alphaPixel}, {TEST_DIR"/alphapalette.png", _alphaPalettePixel}};
+
+    ColorSpace targets[] = {ColorSpace::ARGB8888, ColorSpace::ARGB8888S, ColorSpace::ABGR8888, ColorSpace::ABGR8888S};
+
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        for (auto& image : images) {
+            for (auto cs : targets) {
+                auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+                REQUIRE(canvas);
+
+                uint32_t buffer[W * H];
+                REQUIRE(canvas->target(buffer, W, W, H, cs) == Result::Success);
+
+                auto picture = Picture::gen();
+                REQUIRE(picture->load(image.path) == Result::Success);
+                REQUIRE(canvas->push(picture) == Result::Success);
+                REQUIRE(canvas->draw(true) == Result::Success);
+                REQUIRE(canvas->sync() == Result::Success);
+
+                auto argb = (cs == ColorSpace::ARGB8888 || cs == ColorSpace::ARGB8888S);
+                auto straight = (cs == ColorSpace::ARGB8888S || cs == ColorSpace::ABGR8888S);
+
+                for (uint32_t y = 0; y < H; ++y) {
+                    for (uint32_t x = 0; x < W; ++x) {
+                        uint8_t rgba[4];
+                        image.pixel(x, y, rgba);
+                        auto a = rgba[3];
+                        auto p = buffer[y * W + x];
+                        REQUIRE((p >> 24) == a);
+                        uint8_t c[3] = {uint8_t(p >> (argb ? 16 : 0)), uint8_t(p >> 8), uint8_t(p >> (argb ? 0 : 16))};
+                        for (int i = 0; i < 3; ++i) {
+                            //the premultiplied pixels are exact
+                            auto expected = (a == 255) ? rgba[i] : (rgba[i] * a) >> 8;
+                            if (!straight) REQUIRE(c[i] == expected);
+                            //the straight ones are restored up to the precision the alpha leaves
+                            else if (a > 0) REQUIRE(abs(int(c[i]) - int(rgba[i])) <= 255 / a + 1);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 #endif
 
 #ifdef THORVG_JPG_LOADER_SUPPORT
@@ -22,6 +22,8 @@
 
 #include <thorvg.h>
 #include <fstream>
+#include <cstring>
+#include <vector>
 #include "config.h"
 #include "catch.hpp"
 
@@ -73,4 +75,322 @@ TEST_CASE("Save a lottie into gif", "[tvgSavers]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 #endif
-#endif
\ No newline at end of file
+#endif
+#if defined(THORVG_GIF_SAVER_SUPPORT) && defined(THORVG_LOTTIE_LOADER_SUPPORT) && defined(THORVG_SW_RASTER_SUPPORT)
+
+static string _read(const char* path)
+{
+    ifstream file(path, ios::binary);
+    return string((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+}
+
+//the concatenated sub-blocks from the given position
+static string _subblocks(const string& data, size_t& i)
+{
+    string out;
+    while (i < data.size() && data[i]) {
+        auto size = uint8_t(data[i]);
+        out.append(data, i + 1, size);
+        i += size + 1;
+    }
+    ++i;
+    return out;
+}
+
+//decompresses the color indices of an image block
+static bool _lzw(const string& code, uint32_t minCodeSize, vector<uint8_t>& indices)
+{
+    vector<uint16_t> prefix(4096);
+    vector<uint8_t> suffix(4096), stack;
+    auto clear = 1u << minCodeSize;
+    auto codeSize = minCodeSize + 1;
+    auto next = clear + 2;
+    int32_t prev = -1;
+    uint8_t first = 0;
+    uint32_t bits = 0, bitCnt = 0;
+
+    for (uint32_t i = 0; i < clear; ++i) suffix[i] = i;
+
+    for (size_t pos = 0;;) {
+        while (bitCnt < codeSize) {
+            if (pos >= code.size()) return false;
+            bits |= uint32_t(uint8_t(code[pos++])) << bitCnt;
+            bitCnt += 8;
+        }
+        auto c = bits & ((1u << codeSize) - 1);
+        bits >>= codeSize;
+        bitCnt -= codeSize;
+
+        if (c == clear) {
+            codeSize = minCodeSize + 1;
+            next = clear + 2;
+            prev = -1;
+            continue;
+        }
+        if (c == clear + 1) return true;
+        if (prev < 0) {
+            indices.push_back(first = c);
+            prev = c;
+            continue;
+        }
+        auto cur = c;
+        if (c == next) {
+            stack.push_back(first);
+            cur = prev;
+        } else if (c > next) return false;
+        while (cur >= clear) {
+            stack.push_back(suffix[cur]);
+            cur = prefix[cur];
+        }
+        stack.push_back(first = cur);
+        while (!stack.empty()) {
+            indices.push_back(stack.back());
+            stack.pop_back();
+        }
+        if (next < 4096) {
+            prefix[next] = prev;
+            suffix[next] = first;
+            if (++next == (1u << codeSize) && codeSize < 12) ++codeSize;
+        }
+        prev = c;
+    }
+}
+
+//the composed RGB frames of a gif
+static bool _decode(const string& data, uint32_t& w, uint32_t& h, vector<vector<uint8_t>>& frames)
+{
+    if (data.size() < 13 || data.compare(0, 6, "GIF89a")) return false;
+    w = uint8_t(data[6]) | (uint8_t(data[7]) << 8);
+    h = uint8_t(data[8]) | (uint8_t(data[9]) << 8);
+    size_t i = 13;
+    if (data[10] & 0x80) i += 3 * (2 << (data[10] & 0x07));
+
+    vector<uint8_t> screen(w * h * 3, 0);
+    uint8_t flags = 0, transIdx = 0;
+
+    while (i < data.size()) {
+        auto block = uint8_t(data[i++]);
+        if (block == 0x3b) return true;
+        if (block == 0x21) {
+            auto label = uint8_t(data[i++]);
+            if (label == 0xf9) {
+                flags = data[i + 1];
+                transIdx = data[i + 4];
+            }
+            _subblocks(data, i);
+        } else if (block == 0x2c) {
+            auto x = uint8_t(data[i]) | (uint8_t(data[i + 1]) << 8);
+            auto y = uint8_t(data[i + 2]) | (uint8_t(data[i + 3]) << 8);
+            auto fw = uint8_t(data[i + 4]) | (uint8_t(data[i + 5]) << 8);
+            auto fh = uint8_t(data[i + 6]) | (uint8_t(data[i + 7]) << 8);
+            auto packed = uint8_t(data[i + 8]);
+            i += 9;
+            if (!(packed & 0x80)) return false;
+            auto palette = reinterpret_cast<const uint8_t*>(data.data() + i);
+            i += 3 * (2 << (packed & 0x07));
+            auto minCodeSize = uint8_t(data[i++]);
+            vector<uint8_t> indices;
+            if (!_lzw(_subblocks(data, i), minCodeSize, indices) || indices.size() < size_t(fw * fh)) return false;
+
+            for (uint32_t yy = 0; yy < fh; ++yy) {
+                for (uint32_t xx = 0; xx < fw; ++xx) {
+                    auto idx = indices[yy * fw + xx];
+                    if ((flags & 0x01) && idx == transIdx) continue;
+                    auto dst = &screen[((y + yy) * w + x + xx) * 3];
+                    memcpy(dst, palette + idx * 3, 3);
+                }
+            }
+            frames.push_back(screen);
+            //restore to the background
+            if (((flags >> 2) & 0x07) == 2) fill(screen.begin(), screen.end(), 0);
+        } else return false;
+    }
+    return false;
+}
+
+TEST_CASE("Save a lottie into gif with the pipelined encoding", "[tvgSavers]")
+{
+    static constexpr uint32_t SIZE = 100;
+    static constexpr uint32_t FPS = 10;
+    const char* paths[2] = {TEST_DIR"/test_serial.gif", TEST_DIR"/test_parallel.gif"};
+
+    //one strip with the synchronous compression, then the concurrent strips with the pipelined compression
+    uint32_t threads[2] = {0, 4};
+    for (int i = 0; i < 2; ++i) {
+        REQUIRE(Initializer::init(threads[i]) == Result::Success);
+        {
+            auto animation = Animation::gen();
+            REQUIRE(animation->picture()->load(TEST_DIR"/test.json") == Result::Success);
+            REQUIRE(animation->picture()->size(SIZE, SIZE) == Result::Success);
+
+            auto bg = Shape::gen();
+            REQUIRE(bg->fill(255, 255, 255) == Result::Success);
+            REQUIRE(bg->appendRect(0, 0, SIZE, SIZE) == Result::Success);
+
+            auto saver = unique_ptr<Saver>(Saver::gen());
+            REQUIRE(saver->background(bg) == Result::Success);
+            REQUIRE(saver->save(animation, paths[i], 100, FPS) == Result::Success);
+            REQUIRE(saver->sync() == Result::Success);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+
+    auto serial = _read(paths[0]);
+    auto parallel = _read(paths[1]);
+    REQUIRE(serial.size() > 0);
+    REQUIRE(serial == parallel);
+
+    //the decoded frames are the rendered ones, within the palette quantization
+    uint32_t w, h;
+    vector<vector<uint8_t>> frames;
+    REQUIRE(_decode(parallel, w, h, frames));
+    REQUIRE(w == SIZE);
+    REQUIRE(h == SIZE);
+
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        auto animation = unique_ptr<Animation>(Animation::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(picture->size(SIZE, SIZE) == Result::Success);
+
+        auto bg = Shape::gen();
+        bg->fill(255, 255, 255);
+        bg->appendRect(0, 0, SIZE, SIZE);
+
+        uint32_t buffer[SIZE * SIZE];
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, SIZE, SIZE, SIZE, ColorSpace::ABGR8888S) == Result::Success);
+        REQUIRE(canvas->push(bg) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        //the same frame numbers as the saver
+        auto delay = 1.0f / float(FPS);
+        auto duration = animation->duration();
+        uint32_t cnt = 0, maxDiff = 0;
+        for (auto p = 0.0f; p < duration; p += delay, ++cnt) {
+            REQUIRE(cnt < frames.size());
+            animation->frame(animation->totalFrame() * (p / duration));
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+            auto rendered = reinterpret_cast<const uint8_t*>(buffer);
+            for (uint32_t j = 0; j < SIZE * SIZE; ++j) {
+                for (int c = 0; c < 3; ++c) {
+                    auto d = abs(int(rendered[j * 4 + c]) - int(frames[cnt][j * 3 + c]));
+                    if (uint32_t(d) > maxDiff) maxDiff = d;
+                }
+            }
+        }
+        REQUIRE(cnt > 1);
+        REQUIRE(cnt == frames.size());
+        REQUIRE(maxDiff <= 2);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+
+    remove(paths[0]);
+    remove(paths[1]);
+}
+
+#endif
+
+#if defined(THORVG_PNG_SAVER_SUPPORT) && defined(THORVG_PNG_LOADER_SUPPORT) && defined(THORVG_LOTTIE_LOADER_SUPPORT) && defined(THORVG_SW_RASTER_SUPPORT)
+
+//an opaque background, so the straight alpha of png keeps the pixels exact
+static Shape* _background()
+{
+    auto bg = Shape::gen();
+    bg->fill(255, 255, 255);
+    bg->appendRect(0, 0, 100, 100);
+    return bg;
+}
+
+//the frame count of the acTL chunk and the number of the fcTL chunks
+static void _frames(const char* path, uint32_t& declared, uint32_t& written)
+{
+    ifstream file(path, ios::binary);
+    string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    declared = written = 0;
+    for (size_t i = 8; i + 12 <= data.size();) {
+        auto bytes = reinterpret_cast<const uint8_t*>(data.data() + i);
+        auto size = (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+        if (!memcmp(bytes + 4, "acTL", 4)) declared = (uint32_t(bytes[8]) << 24) | (uint32_t(bytes[9]) << 16) | (uint32_t(bytes[10]) << 8) | uint32_t(bytes[11]);
+        else if (!memcmp(bytes + 4, "fcTL", 4)) ++written;
+        i += size + 12;
+    }
+}
+
+static void _draw(Paint* paint, uint32_t* buffer)
+{
+    auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+    REQUIRE(canvas);
+    REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+    REQUIRE(canvas->push(_background()) == Result::Success);
+    REQUIRE(canvas->push(paint) == Result::Success);
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+}
+
+TEST_CASE("Save a lottie into png", "[tvgSavers]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        //a still image
+        auto saver = unique_ptr<Saver>(Saver::gen());
+        REQUIRE(saver);
+        REQUIRE(saver->background(_background()) == Result::Success);
+        auto picture = Picture::gen();
+        REQUIRE(picture);
+        REQUIRE(picture->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(picture->size(100, 100) == Result::Success);
+        REQUIRE(saver->save(picture->duplicate(), TEST_DIR"/test_still.png") == Result::Success);
+        REQUIRE(saver->sync() == Result::Success);
+
+        uint32_t expected[100*100];
+        _draw(picture, expected);
+
+        auto still = Picture::gen();
+        REQUIRE(still->load(TEST_DIR"/test_still.png") == Result::Success);
+        float w, h;
+        REQUIRE(still->size(&w, &h) == Result::Success);
+        REQUIRE(w == 100);
+        REQUIRE(h == 100);
+
+        uint32_t reloaded[100*100];
+        _draw(still, reloaded);
+        REQUIRE(memcmp(expected, reloaded, sizeof(expected)) == 0);
+
+        //an animated image, the default image is the first frame
+        auto animation = Animation::gen();
+        REQUIRE(animation);
+        REQUIRE(animation->picture()->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(animation->picture()->size(100, 100) == Result::Success);
+
+        auto saver2 = unique_ptr<Saver>(Saver::gen());
+        REQUIRE(saver2);
+        REQUIRE(saver2->background(_background()) == Result::Success);
+        REQUIRE(saver2->save(animation, TEST_DIR"/test_animated.png", 100, 30) == Result::Success);
+        REQUIRE(saver2->sync() == Result::Success);
+
+        auto animated = Picture::gen();
+        REQUIRE(animated->load(TEST_DIR"/test_animated.png") == Result::Success);
+        REQUIRE(animated->size(&w, &h) == Result::Success);
+        REQUIRE(w == 100);
+        REQUIRE(h == 100);
+
+        _draw(animated, reloaded);
+        REQUIRE(memcmp(expected, reloaded, sizeof(expected)) == 0);
+
+        uint32_t declared, written;
+        _frames(TEST_DIR"/test_animated.png", declared, written);
+        REQUIRE(declared > 1);
+        REQUIRE(declared == written);
+    }
+    remove(TEST_DIR"/test_still.png");
+    remove(TEST_DIR"/test_animated.png");
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#endif
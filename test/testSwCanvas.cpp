@@ -23,6 +23,7 @@
 #include <thorvg.h>
 #include "config.h"
 #include "catch.hpp"
+#include <cstring>
 
 using namespace tvg;
 using namespace std;
@@ -342,4 +343,198 @@ TEST_CASE("Viewport", "[tvgSwCanvas]")
 
     REQUIRE(Initializer::term() == Result::Success);
 }
-#endif
\ No newline at end of file
+#endif
+
+#ifdef THORVG_SW_RASTER_SUPPORT
+
+TEST_CASE("Asynchronous Updating without Sync", "[tvgSwCanvas]")
+{
+    REQUIRE(Initializer::init(4) == Result::Success);
+
+    uint32_t buffer[100*100];
+
+    //the canvas is released while its tasks are in flight
+    for (int n = 0; n < 50; ++n) {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        for (int i = 0; i < 8; ++i) {
+            auto shape = Shape::gen();
+            REQUIRE(shape->appendCircle(50, 50, 10 + i * 5, 10 + i * 5) == Result::Success);
+            REQUIRE(shape->fill(255, 255, 255, 255) == Result::Success);
+            REQUIRE(canvas->push(shape) == Result::Success);
+        }
+
+        REQUIRE(canvas->update() == Result::Success);
+    }
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#endif
+
+#if defined(THORVG_SW_RASTER_SUPPORT) && defined(THORVG_PNG_LOADER_SUPPORT)
+
+static void _drawScene(SwCanvas* canvas, uint32_t* buffer, uint32_t size)
+{
+    REQUIRE(canvas->target(buffer, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+
+    //solid + gradient shapes
+    auto bg = Shape::gen();
+    bg->appendRect(0, 0, size, size);
+    bg->fill(255, 255, 255);
+    REQUIRE(canvas->push(bg) == Result::Success);
+
+    auto linear = LinearGradient::gen();
+    linear->linear(0, 0, size, size);
+    Fill::ColorStop stops[3] = {{0.0f, 255, 0, 0, 255}, {0.5f, 0, 255, 0, 127}, {1.0f, 0, 0, 255, 255}};
+    linear->colorStops(stops, 3);
+
+    auto circle = Shape::gen();
+    circle->appendCircle(size * 0.5f, size * 0.5f, size * 0.4f, size * 0.3f);
+    circle->fill(linear);
+    circle->strokeWidth(12);
+    circle->strokeFill(0, 0, 0, 200);
+    REQUIRE(canvas->push(circle) == Result::Success);
+
+    auto radial = RadialGradient::gen();
+    radial->radial(size * 0.5f, size * 0.5f, size * 0.5f, size * 0.5f, size * 0.5f, 0.0f);
+    radial->colorStops(stops, 3);
+
+    auto stroke = Shape::gen();
+    stroke->moveTo(10, 10);
+    stroke->cubicTo(size, 0, 0, size, size - 10, size - 10);
+    stroke->strokeWidth(20);
+    stroke->strokeFill(radial);
+    stroke->opacity(200);
+    REQUIRE(canvas->push(stroke) == Result::Success);
+
+    //masking + image
+    auto picture = Picture::gen();
+    REQUIRE(picture->load(TEST_DIR"/test.png") == Result::Success);
+    picture->size(size, size);
+
+    auto mask = Shape::gen();
+    mask->appendCircle(size * 0.5f, size * 0.5f, size * 0.3f, size * 0.3f);
+    mask->fill(255, 255, 255, 180);
+    picture->mask(mask, MaskMethod::Alpha);
+    REQUIRE(canvas->push(picture) == Result::Success);
+
+    //post effects
+    auto scene = Scene::gen();
+    auto rect = Shape::gen();
+    rect->appendRect(size * 0.2f, size * 0.6f, size * 0.6f, size * 0.3f, 20, 20);
+    rect->fill(0, 128, 255, 255);
+    scene->push(rect);
+    scene->push(SceneEffect::DropShadow, 0, 0, 0, 128, 135.0, 10.0, 5.0, 100);
+    scene->push(SceneEffect::GaussianBlur, 3.0, 0, 0, 100);
+    REQUIRE(canvas->push(scene) == Result::Success);
+
+    REQUIRE(canvas->draw() == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+}
+
+
+TEST_CASE("Parallel Rasterization", "[tvgSwCanvas]")
+{
+    REQUIRE(Initializer::init(4) == Result::Success);
+    {
+        constexpr uint32_t SIZE = 512;
+        auto expected = new uint32_t[SIZE * SIZE];
+        auto result = new uint32_t[SIZE * SIZE];
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+        _drawScene(canvas.get(), expected, SIZE);
+
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen(EngineOption::ParallelRaster));
+        REQUIRE(canvas2);
+        _drawScene(canvas2.get(), result, SIZE);
+
+        //Identical to the serial rasterization
+        REQUIRE(memcmp(expected, result, SIZE * SIZE * sizeof(uint32_t)) == 0);
+
+        delete[] expected;
+        delete[] result;
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#endif
+
+#if defined(THORVG_SW_RASTER_SUPPORT) && defined(THORVG_TTF_LOADER_SUPPORT)
+
+static void _drawText(SwCanvas* canvas, uint32_t* buffer, uint32_t size, const char* style, float degree)
+{
+    REQUIRE(canvas->remove() == Result::Success);
+    REQUIRE(canvas->target(buffer, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+
+    for (int i = 0; i < 8; ++i) {
+        auto text = Text::gen();
+        REQUIRE(text->font("Arial", 6.0f + i * 2.0f, style) == Result::Success);
+        REQUIRE(text->text("ThorVG Text 0123456789") == Result::Success);
+        REQUIRE(text->fill(255, 255, 255) == Result::Success);
+        text->translate(5.3f, 5.7f + i * 28.1f);
+        text->rotate(degree);
+        REQUIRE(canvas->push(text) == Result::Success);
+    }
+
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+}
+
+
+TEST_CASE("Glyph Cache", "[tvgSwCanvas]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    REQUIRE(Text::load(TEST_DIR"/Arial.ttf") == Result::Success);
+    {
+        constexpr uint32_t SIZE = 256;
+        auto expected = new uint32_t[SIZE * SIZE];
+        auto result = new uint32_t[SIZE * SIZE];
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen(EngineOption::GlyphCache));
+        REQUIRE(canvas2);
+
+        //Close to the outline rendering, within the subpixel quantization
+        _drawText(canvas.get(), expected, SIZE, nullptr, 0.0f);
+        _drawText(canvas2.get(), result, SIZE, nullptr, 0.0f);
+
+        uint32_t diff = 0, maxDiff = 0;
+        for (uint32_t i = 0; i < SIZE * SIZE; ++i) {
+            auto a = expected[i] >> 24;
+            auto b = result[i] >> 24;
+            auto d = a > b ? a - b : b - a;
+            diff += d;
+            if (d > maxDiff) maxDiff = d;
+        }
+        //a glyph is off by 1/8px at most, which is 32 coverage per edge and two edges might share a pixel
+        REQUIRE(maxDiff <= 64);
+        REQUIRE(diff < SIZE * SIZE * 3 / 2);
+
+        //Combined with the parallel rasterization
+        auto canvas3 = unique_ptr<SwCanvas>(SwCanvas::gen(EngineOption::ParallelRaster | EngineOption::GlyphCache));
+        REQUIRE(canvas3);
+        _drawText(canvas3.get(), expected, SIZE, nullptr, 0.0f);
+        REQUIRE(memcmp(expected, result, SIZE * SIZE * sizeof(uint32_t)) == 0);
+
+        //Identical with the fallbacks
+        _drawText(canvas.get(), expected, SIZE, nullptr, 10.0f);
+        _drawText(canvas2.get(), result, SIZE, nullptr, 10.0f);
+        REQUIRE(memcmp(expected, result, SIZE * SIZE * sizeof(uint32_t)) == 0);
+
+        _drawText(canvas.get(), expected, SIZE, "italic", 0.0f);
+        _drawText(canvas2.get(), result, SIZE, "italic", 0.0f);
+        REQUIRE(memcmp(expected, result, SIZE * SIZE * sizeof(uint32_t)) == 0);
+
+        delete[] expected;
+        delete[] result;
+    }
+    REQUIRE(Text::unload(TEST_DIR"/Arial.ttf") == Result::Success);
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#endif
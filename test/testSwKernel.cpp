@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <memory>
+#include <cstring>
+#include "tvgSwCommon.h"
+#include "catch.hpp"
+
+using namespace tvg;
+using namespace std;
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    void kernelSse41(SwKernels& kernels);
+    void kernelAvx2(SwKernels& kernels);
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    void kernelNeon(SwKernels& kernels);
+#endif
+
+//the vectorized kernels that run on this cpu, each of them must be bit-exact with the C ones
+static Array<SwKernels> _variants()
+{
+    Array<SwKernels> variants;
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.1")) {
+        auto kernels = swScalarKernels;
+        kernelSse41(kernels);
+        variants.push(kernels);
+        if (__builtin_cpu_supports("avx2")) {
+            kernelAvx2(kernels);
+            variants.push(kernels);
+        }
+    }
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    auto kernels = swScalarKernels;
+    kernelNeon(kernels);
+    variants.push(kernels);
+#endif
+    return variants;
+}
+
+
+static uint32_t seed = 1;
+
+static uint32_t _random()
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) & 0xffffff;
+}
+
+
+static uint32_t _random(uint32_t max)
+{
+    return _random() % (max + 1);
+}
+
+
+static float _random(float min, float max)
+{
+    return min + (max - min) * float(_random(0xffff)) / 65535.0f;
+}
+
+
+static uint32_t _premultiplied()
+{
+    auto a = _random(255);
+    return JOIN(a, _random(a), _random(a), _random(a));
+}
+
+
+static void _pixels(uint32_t* buffer, uint32_t len, bool premultiplied = true)
+{
+    for (uint32_t i = 0; i < len; ++i) buffer[i] = premultiplied ? _premultiplied() : ((_random() << 8) | _random(255));
+}
+
+
+static void _bytes(uint8_t* buffer, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; ++i) buffer[i] = _random(255);
+}
+
+
+//the odd lengths with the tails, and a few long ones
+static uint32_t _length(int i)
+{
+    return (i % 8 == 7) ? 256 + _random(64) : _random(70);
+}
+
+
+//the spans start at the unaligned addresses, the guards around them must be left as they are
+static constexpr uint32_t GUARD = 16;
+static constexpr uint32_t MAX_LEN = 256 + 64 + 2 * GUARD;
+
+//the same input for the both kernels
+struct Buffers
+{
+    uint32_t expected[MAX_LEN];
+    uint32_t result[MAX_LEN];
+    uint8_t expected8[MAX_LEN];
+    uint8_t result8[MAX_LEN];
+
+    void reset(bool premultiplied = true)
+    {
+        _pixels(expected, MAX_LEN, premultiplied);
+        memcpy(result, expected, sizeof(expected));
+        _bytes(expected8, MAX_LEN);
+        memcpy(result8, expected8, sizeof(expected8));
+    }
+
+    bool same()
+    {
+        return !memcmp(expected, result, sizeof(expected)) && !memcmp(expected8, result8, sizeof(expected8));
+    }
+};
+
+
+TEST_CASE("Pixel Kernels", "[tvgSwKernel]")
+{
+    auto variants = _variants();
+    auto& c = swScalarKernels;
+    auto buffers = unique_ptr<Buffers>(new Buffers);
+    uint32_t src[MAX_LEN];
+
+    ARRAY_FOREACH(v, variants) {
+        INFO(v->name);
+        for (int i = 0; i < 400; ++i) {
+            auto len = _length(i);
+            auto offset = _random(GUARD - 1);
+            auto color = _premultiplied();
+            auto& b = *buffers;
+            _pixels(src, MAX_LEN);
+
+            b.reset();
+            c.fill32(b.expected + offset, color, len);
+            v->fill32(b.result + offset, color, len);
+            c.fill8(b.expected8 + offset, color & 0xff, len);
+            v->fill8(b.result8 + offset, color & 0xff, len);
+            REQUIRE(b.same());
+
+            b.reset();
+            c.luma(b.expected8 + offset, src + offset, len, i % 2, (i % 4) > 1);
+            v->luma(b.result8 + offset, src + offset, len, i % 2, (i % 4) > 1);
+            REQUIRE(b.same());
+
+            //straight colors
+            b.reset(false);
+            c.premultiply(b.expected + offset, len);
+            v->premultiply(b.result + offset, len);
+            REQUIRE(b.same());
+
+            b.reset();
+            c.unpremultiply(b.expected + offset, len);
+            v->unpremultiply(b.result + offset, len);
+            REQUIRE(b.same());
+
+            b.reset();
+            c.swapRB(b.expected + offset, len);
+            v->swapRB(b.result + offset, len);
+            REQUIRE(b.same());
+        }
+    }
+}
+
+
+TEST_CASE("Raster Kernels", "[tvgSwKernel]")
+{
+    auto variants = _variants();
+    auto& c = swScalarKernels;
+    auto buffers = unique_ptr<Buffers>(new Buffers);
+    uint32_t src[MAX_LEN];
+    uint8_t cmp[MAX_LEN * 4];
+
+    ARRAY_FOREACH(v, variants) {
+        INFO(v->name);
+        for (int i = 0; i < 400; ++i) {
+            auto len = _length(i);
+            auto offset = _random(GUARD - 1);
+            auto color = _premultiplied();
+            auto opacity = (i % 3 == 0) ? 255 : _random(255);
+            auto csize = (i % 2) ? sizeof(uint32_t) : sizeof(uint8_t);
+            auto inverse = (i % 4) > 1;
+            auto& b = *buffers;
+            _pixels(src, MAX_LEN);
+            _bytes(cmp, sizeof(cmp));
+
+            b.reset();
+            c.translucentColor(b.expected + offset, color, len);
+            v->translucentColor(b.result + offset, color, len);
+            REQUIRE(b.same());
+
+            b.reset();
+            c.translucentPixels(b.expected + offset, src + offset, len, opacity);
+            v->translucentPixels(b.result + offset, src + offset, len, opacity);
+            REQUIRE(b.same());
+
+            b.reset();
+            c.mattedColor(b.expected + offset, color, cmp + offset, len, csize, inverse);
+            v->mattedColor(b.result + offset, color, cmp + offset, len, csize, inverse);
+            REQUIRE(b.same());
+
+            b.reset();
+            c.mattedPixels(b.expected + offset, src + offset, cmp + offset, len, csize, opacity, inverse);
+            v->mattedPixels(b.result + offset, src + offset, cmp + offset, len, csize, opacity, inverse);
+            REQUIRE(b.same());
+        }
+    }
+}
+
+
+TEST_CASE("Gradient Kernels", "[tvgSwKernel]")
+{
+    auto variants = _variants();
+    auto& c = swScalarKernels;
+    auto buffers = unique_ptr<Buffers>(new Buffers);
+    auto ctable = unique_ptr<uint32_t[]>(new uint32_t[GRADIENT_STOP_SIZE]);
+    _pixels(ctable.get(), GRADIENT_STOP_SIZE);
+
+    ARRAY_FOREACH(v, variants) {
+        INFO(v->name);
+        for (int i = 0; i < 300; ++i) {
+            auto len = _length(i);
+            auto offset = _random(GUARD - 1);
+            auto& b = *buffers;
+
+            for (int spread = 0; spread < 3; ++spread) {
+                //the positions run over the table in the both directions, beyond the both ends
+                auto t = int32_t(_random(16 * GRADIENT_STOP_SIZE * FIXPT_SIZE)) - 8 * GRADIENT_STOP_SIZE * FIXPT_SIZE;
+                auto inc = int32_t(_random(8 * FIXPT_SIZE)) - 4 * FIXPT_SIZE;
+                b.reset();
+                c.linear[spread](ctable.get(), b.expected + offset, t, inc, len);
+                v->linear[spread](ctable.get(), b.result + offset, t, inc, len);
+                REQUIRE(b.same());
+
+                //the forward differences of the quadratic roots, the discriminant stays positive
+                auto bb = _random(-2.0f, 2.0f);
+                auto deltaB = _random(-0.01f, 0.01f);
+                auto det = _random(0.0f, 4.0f);
+                auto deltaDet = _random(0.0f, 0.05f);
+                auto deltaDeltaDet = _random(0.0f, 0.001f);
+                auto b1 = bb, det1 = det, deltaDet1 = deltaDet;
+                auto b2 = bb, det2 = det, deltaDet2 = deltaDet;
+                b.reset();
+                c.radial[spread](ctable.get(), b.expected + offset, b1, deltaB, det1, deltaDet1, deltaDeltaDet, len);
+                v->radial[spread](ctable.get(), b.result + offset, b2, deltaB, det2, deltaDet2, deltaDeltaDet, len);
+                REQUIRE(b.same());
+                REQUIRE(b1 == b2);
+                REQUIRE(det1 == det2);
+                REQUIRE(deltaDet1 == deltaDet2);
+            }
+        }
+    }
+}
+
+
+TEST_CASE("Blur Kernels", "[tvgSwKernel]")
+{
+    auto variants = _variants();
+    auto& c = swScalarKernels;
+    auto buffers = unique_ptr<Buffers>(new Buffers);
+    uint32_t row[MAX_LEN];
+
+    ARRAY_FOREACH(v, variants) {
+        INFO(v->name);
+        for (int i = 0; i < 300; ++i) {
+            auto& b = *buffers;
+            _pixels(row, MAX_LEN);
+
+            //slides the window inside of the row like the blur filters do
+            auto dimension = int32_t(_random(20));
+            auto w = int32_t(_length(i)) + 2 * dimension + 1;
+            if (w > int32_t(MAX_LEN)) w = MAX_LEN;
+            auto begin = dimension + 1;
+            auto len = w - 2 * dimension - 1;
+            auto iarr = 1.0f / float(2 * dimension + 1);
+
+            int32_t acc[4] = {0, 0, 0, 0};
+            int32_t alpha = 0;
+            for (auto x = 0; x < 2 * dimension + 1; ++x) {
+                auto p = reinterpret_cast<const uint8_t*>(row + x);
+                for (int ch = 0; ch < 4; ++ch) acc[ch] += p[ch];
+                alpha += A(row[x]);
+            }
+            int32_t acc1[4], acc2[4];
+            memcpy(acc1, acc, sizeof(acc));
+            memcpy(acc2, acc, sizeof(acc));
+
+            b.reset();
+            c.boxBlur(b.expected + begin, row + begin + dimension, row + begin - dimension - 1, len, acc1, iarr);
+            v->boxBlur(b.result + begin, row + begin + dimension, row + begin - dimension - 1, len, acc2, iarr);
+            REQUIRE(b.same());
+            REQUIRE(!memcmp(acc1, acc2, sizeof(acc)));
+
+            auto color = _premultiplied();
+            auto alpha1 = alpha, alpha2 = alpha;
+            b.reset();
+            c.shadowBlur(b.expected + begin, row + begin + dimension, row + begin - dimension - 1, len, alpha1, color, iarr);
+            v->shadowBlur(b.result + begin, row + begin + dimension, row + begin - dimension - 1, len, alpha2, color, iarr);
+            REQUIRE(b.same());
+            REQUIRE(alpha1 == alpha2);
+        }
+
+        //the partial tiles at the right and bottom ends
+        constexpr int32_t STRIDE = 45;
+        uint32_t src[STRIDE * STRIDE], expected[STRIDE * STRIDE], result[STRIDE * STRIDE];
+        for (int i = 0; i < 100; ++i) {
+            auto w = int32_t(_random(40));
+            auto h = int32_t(_random(40));
+            auto x = int32_t(_random(STRIDE - 41));
+            auto y = int32_t(_random(STRIDE - 41));
+            _pixels(src, STRIDE * STRIDE);
+            _pixels(expected, STRIDE * STRIDE);
+            memcpy(result, expected, sizeof(expected));
+            c.transpose(expected + y * STRIDE + x, STRIDE, src + x * STRIDE + y, STRIDE, w, h);
+            v->transpose(result + y * STRIDE + x, STRIDE, src + x * STRIDE + y, STRIDE, w, h);
+            REQUIRE(!memcmp(expected, result, sizeof(expected)));
+        }
+    }
+}
+
+
+static void _drawEffects(SwCanvas* canvas, uint32_t* buffer, uint32_t w, uint32_t h, int effect)
+{
+    REQUIRE(canvas->remove() == Result::Success);
+    REQUIRE(canvas->target(buffer, w, w, h, ColorSpace::ARGB8888) == Result::Success);
+
+    auto scene = Scene::gen();
+
+    auto shape = Shape::gen();
+    shape->appendCircle(w * 0.4f, h * 0.5f, w * 0.3f, h * 0.35f);
+    auto fill = RadialGradient::gen();
+    fill->radial(w * 0.4f, h * 0.5f, w * 0.3f, w * 0.3f, h * 0.4f, 0.0f);
+    Fill::ColorStop stops[3] = {{0.0f, 255, 0, 0, 255}, {0.5f, 0, 255, 0, 128}, {1.0f, 0, 0, 255, 255}};
+    fill->colorStops(stops, 3);
+    fill->spread(FillSpread::Reflect);
+    shape->fill(fill);
+    scene->push(shape);
+
+    auto shape2 = Shape::gen();
+    shape2->appendRect(w * 0.5f, 1.0f, w * 0.5f - 1.0f, h * 0.6f, 3.0f, 3.0f);
+    auto fill2 = LinearGradient::gen();
+    fill2->linear(w * 0.5f, 0.0f, w * 0.7f, h * 0.3f);
+    fill2->colorStops(stops, 3);
+    fill2->spread(FillSpread::Repeat);
+    shape2->fill(fill2);
+    shape2->opacity(200);
+    scene->push(shape2);
+
+    //the windows narrower, as wide as and wider than the canvas, with the both borders and directions
+    switch (effect) {
+        case 0: scene->push(SceneEffect::GaussianBlur, 0.7, 0, 0, 100); break;
+        case 1: scene->push(SceneEffect::GaussianBlur, 4.0, 1, 1, 50); break;
+        case 2: scene->push(SceneEffect::GaussianBlur, 12.0, 2, 0, 0); break;
+        case 3: scene->push(SceneEffect::GaussianBlur, 40.0, 0, 1, 100); break;
+        case 4: scene->push(SceneEffect::DropShadow, 10, 20, 30, 200, 45.0, 7.0, 3.0, 100); break;
+        case 5: scene->push(SceneEffect::DropShadow, 0, 0, 0, 128, 250.0, 15.0, 30.0, 50); break;
+    }
+
+    REQUIRE(canvas->push(scene) == Result::Success);
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+}
+
+
+TEST_CASE("Blur Effects with Kernels", "[tvgSwKernel]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        auto variants = _variants();
+        auto kernels = swKernels;
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        //the odd sizes, the rows are not multiples of the vector width
+        uint32_t sizes[3][2] = {{97, 61}, {13, 71}, {203, 9}};
+        for (auto& size : sizes) {
+            auto w = size[0];
+            auto h = size[1];
+            auto expected = unique_ptr<uint32_t[]>(new uint32_t[w * h]);
+            auto result = unique_ptr<uint32_t[]>(new uint32_t[w * h]);
+
+            for (int effect = 0; effect < 6; ++effect) {
+                swKernels = swScalarKernels;
+                _drawEffects(canvas.get(), expected.get(), w, h, effect);
+
+                ARRAY_FOREACH(v, variants) {
+                    INFO(v->name << " " << w << "x" << h << " effect " << effect);
+                    swKernels = *v;
+                    _drawEffects(canvas.get(), result.get(), w, h, effect);
+                    REQUIRE(!memcmp(expected.get(), result.get(), sizeof(uint32_t) * w * h));
+                }
+            }
+        }
+
+        swKernels = kernels;
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgSwCommon.h"
+#include "catch.hpp"
+
+using namespace tvg;
+
+TEST_CASE("Memory Pool Arena", "[tvgSwMemPool]")
+{
+    auto mpool = mpoolInit(0);
+    REQUIRE(mpool);
+
+    auto& arena = mpool->arena[0];
+
+    //the first frame spills to the heap
+    auto a = mpoolAlloc(mpool, 0, 1000);
+    auto b = mpoolAlloc(mpool, 0, 5000);
+    REQUIRE(a);
+    REQUIRE(b);
+    REQUIRE(arena.spilled >= 6000);
+    mpoolFree(mpool, 0, b, 5000);
+    mpoolFree(mpool, 0, a, 1000);
+    REQUIRE(arena.spilled == 0);
+
+    //then the main block grows up to its peak
+    mpoolReset(mpool);
+    REQUIRE(arena.data);
+    REQUIRE(arena.size >= 6000);
+
+    auto data = arena.data;
+    auto size = arena.size;
+
+    //the steady frames are served out of the main block
+    for (int i = 0; i < 3; ++i) {
+        a = mpoolAlloc(mpool, 0, 1000);
+        b = mpoolAlloc(mpool, 0, 5000);
+        REQUIRE(arena.spilled == 0);
+        REQUIRE(static_cast<uint8_t*>(a) >= arena.data);
+        REQUIRE(static_cast<uint8_t*>(b) + 5000 <= arena.data + arena.size);
+        REQUIRE(arena.live == 2);
+        mpoolFree(mpool, 0, b, 5000);
+        mpoolFree(mpool, 0, a, 1000);
+        REQUIRE(arena.live == 0);
+        REQUIRE(arena.used == 0);
+        mpoolReset(mpool);
+        REQUIRE(arena.data == data);
+        REQUIRE(arena.size == size);
+    }
+
+    REQUIRE(mpoolTerm(mpool));
+}
+
+
+TEST_CASE("Memory Pool Shared Reset", "[tvgSwMemPool]")
+{
+    auto mpool = mpoolInit(1);
+    REQUIRE(mpool);
+
+    auto& arena = mpool->arena[1];
+
+    auto a = mpoolAlloc(mpool, 1, 1000);
+    mpoolFree(mpool, 1, a, 1000);
+
+    //a task of another canvas is running on the pool, the arenas are left as they are
+    mpoolRetain(mpool);
+    mpoolReset(mpool);
+    REQUIRE(!arena.data);
+    REQUIRE(arena.peak >= 1000);
+    REQUIRE(mpool->users == 1);
+
+    //it's done, the reset is carried out
+    mpoolRelease(mpool);
+    mpoolReset(mpool);
+    REQUIRE(arena.data);
+    REQUIRE(arena.peak == 0);
+    REQUIRE(mpool->users == 0);
+
+    REQUIRE(mpoolTerm(mpool));
+}
+
+
+TEST_CASE("Memory Pool Transient Users", "[tvgSwMemPool]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    auto mpool = mpoolInit(0);
+    REQUIRE(mpool);
+
+    constexpr uint32_t SIZE = 128;
+    auto buffer = new uint32_t[SIZE * SIZE];
+    auto pixels = new uint32_t[32 * 32];
+    for (uint32_t i = 0; i < 32 * 32; ++i) pixels[i] = 0xff336699;
+
+    SwSurface surface;
+    surface.data = buffer;
+    surface.stride = surface.w = surface.h = SIZE;
+    surface.cs = ColorSpace::ARGB8888;
+    surface.channelSize = sizeof(uint32_t);
+    surface.premultiplied = true;
+    REQUIRE(rasterCompositor(&surface));
+
+    //the rotated image goes through the texture mapper with the anti-aliasing spans
+    SwImage image;
+    image.data = pixels;
+    image.w = image.h = image.stride = 32;
+    image.channelSize = sizeof(uint32_t);
+    image.scale = 1.0f;
+
+    Matrix rotated = {0.866f, -0.5f, 64.0f, 0.5f, 0.866f, 20.0f, 0.0f, 0.0f, 1.0f};
+    RenderRegion bbox = {{0, 0}, {int32_t(SIZE), int32_t(SIZE)}};
+
+    //the trimmed, dashed stroke takes the trimmed path and the dash outline
+    RenderShape rshape;
+    rshape.path.cmds.push(PathCommand::MoveTo);
+    rshape.path.pts.push({10.0f, 10.0f});
+    for (int i = 1; i < 16; ++i) {
+        rshape.path.cmds.push(PathCommand::LineTo);
+        rshape.path.pts.push({10.0f + i * 7.0f, (i % 2) ? 110.0f : 10.0f});
+    }
+    rshape.stroke = new RenderStroke;
+    rshape.stroke->width = 3.0f;
+    rshape.stroke->dash.pattern = tvg::malloc<float*>(sizeof(float) * 2);
+    rshape.stroke->dash.pattern[0] = 10.0f;
+    rshape.stroke->dash.pattern[1] = 5.0f;
+    rshape.stroke->dash.count = 2;
+    rshape.stroke->dash.length = 15.0f;
+    rshape.stroke->trim.begin = 0.1f;
+    rshape.stroke->trim.end = 0.9f;
+
+    SwShape shape;
+    auto identity = tvg::identity();
+
+    auto& arena = mpool->arena[0];
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    PathCommand* cmds = nullptr;
+    SwSpan* spans = nullptr;
+
+    for (int frame = 0; frame < 4; ++frame) {
+        REQUIRE(rasterTexmapPolygon(&surface, image, rotated, bbox, 255, mpool, 0));
+        REQUIRE(arena.live == 0);
+        REQUIRE(arena.spilled == 0);
+        REQUIRE(arena.peak > 0);
+
+        RenderRegion renderBox;
+        shapeReset(&shape);
+        shapeResetStroke(&shape, &rshape, identity);
+        REQUIRE(shapeGenStrokeRle(&shape, &rshape, identity, bbox, renderBox, mpool, 0));
+        REQUIRE(shape.strokeRle->spans.count > 0);
+        shapeDelOutline(&shape, mpool, 0);
+
+        //nothing served out of the main block, so nothing spilled to the heap in this frame
+        if (frame > 0) REQUIRE(arena.peak <= arena.size);
+
+        mpoolReset(mpool);
+
+        //the steady frames reuse the same memory
+        if (frame == 0) {
+            data = arena.data;
+            size = arena.size;
+            cmds = mpool->path[0].cmds.data;
+            spans = shape.strokeRle->spans.data;
+            REQUIRE(data);
+            REQUIRE(cmds);
+        } else {
+            REQUIRE(arena.data == data);
+            REQUIRE(arena.size == size);
+            REQUIRE(mpool->path[0].cmds.data == cmds);
+            REQUIRE(shape.strokeRle->spans.data == spans);
+        }
+    }
+
+    shapeFree(&shape);
+    REQUIRE(mpoolTerm(mpool));
+
+    delete[] pixels;
+    delete[] buffer;
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
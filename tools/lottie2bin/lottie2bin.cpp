@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <iostream>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "rapidjson/document.h"
+#include "rapidjson/writer.h"
+#include "rapidjson/stringbuffer.h"
+#include "tvgLottieBinary.h"
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #ifndef PATH_MAX
+        #define PATH_MAX MAX_PATH
+    #endif
+#else
+    #include <dirent.h>
+    #include <unistd.h>
+    #include <limits.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace std;
+using namespace rapidjson;
+
+
+//the token stream and the string pool of a precompiled lottie
+struct Encoder
+{
+   vector<uint8_t> tokens;
+   vector<char> pool;
+   unordered_map<string, uint32_t> offsets;   //deduplicated strings
+
+   void tag(LottieBinary::Token token)
+   {
+      tokens.push_back(token);
+   }
+
+   void varint(uint64_t value)
+   {
+      uint8_t buf[10];
+      auto cnt = LottieBinary::varint(buf, value);
+      tokens.insert(tokens.end(), buf, buf + cnt);
+   }
+
+   //little-endian, regardless of the host
+   template<typename T>
+   void raw(T value)
+   {
+      uint8_t buf[sizeof(T)];
+      LottieBinary::write(buf, value);
+      tokens.insert(tokens.end(), buf, buf + sizeof(T));
+   }
+
+   void text(LottieBinary::Token token, const char* str, uint32_t len)
+   {
+      auto key = std::string(str, len);
+      auto it = offsets.find(key);
+      uint32_t offset;
+      if (it == offsets.end()) {
+         offset = (uint32_t) pool.size();
+         pool.insert(pool.end(), str, str + len);
+         pool.push_back('\0');
+         offsets.emplace(key, offset);
+      } else offset = it->second;
+
+      tag(token);
+      varint(offset);
+      varint(len);
+   }
+
+   //same number types with the ones which the json reader reports
+   void number(const Value& value)
+   {
+      if (value.IsDouble()) {
+         auto d = value.GetDouble();
+         auto f = static_cast<float>(d);
+         if (static_cast<double>(f) == d) {
+            tag(LottieBinary::Float);
+            raw(f);
+         } else {
+            tag(LottieBinary::Double);
+            raw(d);
+         }
+      } else if (value.IsUint()) {
+         tag(LottieBinary::Uint);
+         varint(value.GetUint());
+      } else if (value.IsInt()) {
+         tag(LottieBinary::Int);
+         varint(LottieBinary::zigzag(value.GetInt()));
+      } else if (value.IsUint64()) {
+         tag(LottieBinary::Uint64);
+         varint(value.GetUint64());
+      } else {
+         tag(LottieBinary::Int64);
+         varint(LottieBinary::zigzag(value.GetInt64()));
+      }
+   }
+
+   void encode(const Value& value, uint32_t depth)
+   {
+      switch (value.GetType()) {
+         case kNullType: tag(LottieBinary::Null); break;
+         case kFalseType: tag(LottieBinary::False); break;
+         case kTrueType: tag(LottieBinary::True); break;
+         case kNumberType: number(value); break;
+         case kStringType: text(LottieBinary::String, value.GetString(), value.GetStringLength()); break;
+         case kArrayType: {
+            tag(LottieBinary::StartArray);
+            for (auto& v : value.GetArray()) encode(v, depth + 1);
+            tag(LottieBinary::EndArray);
+            break;
+         }
+         case kObjectType: {
+            tag(LottieBinary::StartObject);
+            for (auto& m : value.GetObject()) {
+               text(LottieBinary::Key, m.name.GetString(), m.name.GetStringLength());
+               //the loader overrides the slots with the json text
+               if (depth == 0 && !strcmp(m.name.GetString(), "slots") && m.value.IsObject()) {
+                  StringBuffer buf;
+                  Writer<StringBuffer> writer(buf);
+                  m.value.Accept(writer);
+                  text(LottieBinary::String, buf.GetString(), (uint32_t) buf.GetSize());
+               } else encode(m.value, depth + 1);
+            }
+            tag(LottieBinary::EndObject);
+            break;
+         }
+      }
+   }
+};
+
+
+struct App
+{
+private:
+   char full[PATH_MAX];    //full path
+
+   void helpMsg()
+   {
+      cout << "Usage: \n   tvg-lottie2bin [Lottie file] or [Lottie folder]\n\nExamples: \n    $ tvg-lottie2bin input.json\n    $ tvg-lottie2bin input1.json input2.json\n    $ tvg-lottie2bin lottiefolder\n\n";
+   }
+
+   bool validate(string& lottieName)
+   {
+      string extn = ".json";
+
+      if (lottieName.size() <= extn.size() || lottieName.substr(lottieName.size() - extn.size()) != extn) {
+         cout << "Error: \"" << lottieName << "\" is invalid." << endl;
+         return false;
+      }
+      return true;
+   }
+
+   float info(const Value& root, const char* name)
+   {
+      auto it = root.FindMember(name);
+      if (it == root.MemberEnd() || !it->value.IsNumber()) return 0.0f;
+      return it->value.GetFloat();
+   }
+
+   bool convert(string& in, string& out)
+   {
+      auto f = fopen(in.c_str(), "rb");
+      if (!f) return false;
+
+      fseek(f, 0, SEEK_END);
+      auto size = ftell(f);
+      if (size <= 0) {
+         fclose(f);
+         return false;
+      }
+      vector<char> json(size + 1);
+      fseek(f, 0, SEEK_SET);
+      auto ret = fread(json.data(), sizeof(char), size, f);
+      fclose(f);
+      if (ret != (size_t) size) return false;
+      json[size] = '\0';
+
+      Document doc;
+      if (doc.Parse(json.data()).HasParseError() || !doc.IsObject()) return false;
+
+      Encoder encoder;
+      encoder.encode(doc, 0);
+      if (encoder.pool.empty()) encoder.pool.push_back('\0');
+
+      LottieBinary::Header header;
+      header.version = LOTTIE_BINARY_VERSION;
+      header.w = info(doc, "w");
+      header.h = info(doc, "h");
+      header.frameRate = info(doc, "fr");
+      header.startFrame = info(doc, "ip");
+      header.endFrame = info(doc, "op");
+      header.tokens = (uint32_t) encoder.tokens.size();
+      header.pool = (uint32_t) encoder.pool.size();
+
+      f = fopen(out.c_str(), "wb");
+      if (!f) return false;
+
+      uint8_t buf[LottieBinary::HEADER_SIZE];
+      LottieBinary::write(buf, header);
+
+      auto success = fwrite(buf, sizeof(buf), 1, f) == 1;
+      success &= fwrite(encoder.tokens.data(), 1, encoder.tokens.size(), f) == encoder.tokens.size();
+      success &= fwrite(encoder.pool.data(), 1, encoder.pool.size(), f) == encoder.pool.size();
+      fclose(f);
+
+      return success;
+   }
+
+   void convert(string& lottieName)
+   {
+      //Get binary file
+      auto binName = lottieName;
+      binName.replace(binName.length() - 4, 4, "lotb");
+
+      if (convert(lottieName, binName)) {
+         cout << "Generated Binary file : " << binName << endl;
+      } else {
+         cout << "Failed Converting Binary file : " << lottieName << endl;
+      }
+   }
+
+   const char* realPath(const char* path)
+   {
+#ifdef _WIN32
+      return _fullpath(full, path, PATH_MAX);
+#else
+      return realpath(path, full);
+#endif
+   }
+
+   bool isDirectory(const char* path)
+   {
+#ifdef _WIN32
+      DWORD attr = GetFileAttributes(path);
+      if (attr == INVALID_FILE_ATTRIBUTES) return false;
+      return attr & FILE_ATTRIBUTE_DIRECTORY;
+#else
+      struct stat buf;
+      if (stat(path, &buf) != 0) return false;
+      return S_ISDIR(buf.st_mode);
+#endif
+   }
+
+   bool handleDirectory(const string& path)
+   {
+#ifdef _WIN32
+      //open directory
+      WIN32_FIND_DATA fd;
+      HANDLE h = FindFirstFileEx((path + "\\*").c_str(), FindExInfoBasic, &fd, FindExSearchNameMatch, NULL, 0);
+      if (h == INVALID_HANDLE_VALUE) {
+         cout << "Couldn't open directory \"" << path.c_str() << "\"." << endl;
+         return false;
+      }
+      //List directories
+      do {
+         if (*fd.cFileName == '.' || *fd.cFileName == '$') continue;
+         //sub directory
+         if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            string subpath = string(path);
+            subpath += '\\';
+            subpath += fd.cFileName;
+            if (!handleDirectory(subpath)) continue;
+         //file
+         } else {
+            string lottieName(fd.cFileName);
+            if (!validate(lottieName)) continue;
+            lottieName = string(path);
+            lottieName += '\\';
+            lottieName += fd.cFileName;
+            convert(lottieName);
+         }
+      } while (FindNextFile(h, &fd));
+
+      FindClose(h);
+#else
+      //open directory
+      auto dir = opendir(path.c_str());
+      if (!dir) {
+         cout << "Couldn't open directory \"" << path.c_str() << "\"." << endl;
+         return false;
+      }
+      //List directories
+      while (auto entry = readdir(dir)) {
+         if (*entry->d_name == '.' || *entry->d_name == '$') continue;
+         //sub directory
+         if (entry->d_type == DT_DIR) {
+            string subpath = string(path);
+            subpath += '/';
+            subpath += entry->d_name;
+            if (!handleDirectory(subpath)) continue;
+         //file
+         } else {
+            string lottieName(entry->d_name);
+            if (!validate(lottieName)) continue;
+            lottieName = string(path);
+            lottieName += '/';
+            lottieName += entry->d_name;
+            convert(lottieName);
+         }
+      }
+      closedir(dir);
+#endif
+      return true;
+   }
+
+public:
+   int setup(int argc, char** argv)
+   {
+      //Collect input files
+      vector<const char*> inputs;
+
+      for (int i = 1; i < argc; ++i) {
+         const char* p = argv[i];
+         if (*p == '-') cout << "Warning: Unknown flag (" << p << ")." << endl;
+         else inputs.push_back(argv[i]);
+      }
+
+      //No Input Lottie
+      if (inputs.empty()) {
+         helpMsg();
+         return 0;
+      }
+
+      for (auto input : inputs) {
+
+         auto path = realPath(input);
+         if (!path) {
+            cout << "Invalid file or path name: \"" << input << "\"" << endl;
+            continue;
+         }
+
+         if (isDirectory(path)) {
+            //load from directory
+            cout << "Directory: \"" << path << "\"" << endl;
+            if (!handleDirectory(path)) break;
+         }
+         else {
+            string lottieName(input);
+            if (!validate(lottieName)) continue;
+            convert(lottieName);
+         }
+      }
+      return 0;
+   }
+};
+
+
+int main(int argc, char **argv)
+{
+   App app;
+   return app.setup(argc, argv);
+}